@@ -10,6 +10,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "exprtk.hpp"
 
@@ -28,16 +29,34 @@ namespace ENigMA
 
             std::string m_expressionString;
             exprtk::symbol_table<Real> m_symbolTable;
+            exprtk::expression<Real> m_expression;
+            bool m_compiled;
             Real m_value;
             bool m_constant;
 
+            // Private symbol table used by the single and two variable evaluate overloads
+            exprtk::symbol_table<Real> m_localSymbolTable;
+            exprtk::expression<Real> m_localExpression;
+            std::string m_localVariable1;
+            std::string m_localVariable2;
+            Real m_localValue1;
+            Real m_localValue2;
+            Integer m_localNbVariables;
+
+            void compile();
+            void compileLocal(const std::string aVariable1);
+            void compileLocal(const std::string aVariable1, const std::string aVariable2);
+
         public:
 
             CAnaFunction();
             CAnaFunction(Real aConstant);
             CAnaFunction(std::string anExpression);
+            CAnaFunction(const CAnaFunction<Real>& aFunction);
             ~CAnaFunction();
 
+            CAnaFunction<Real>& operator=(const CAnaFunction<Real>& aFunction);
+
             void set(Real aConstant);
             void set(std::string anExpression);
 
@@ -49,6 +68,8 @@ namespace ENigMA
             Real evaluate(const std::string aVariable, Real& aValue);
             Real evaluate(const std::string aVariable1, Real& aValue1, const std::string aVariable2, Real& aValue2);
 
+            void evaluate(const std::vector<std::string>& sVariables, const std::vector<std::vector<Real> >& sColumns, std::vector<Real>& sValues, const Integer nbThreads = 0);
+
             Real bisection(const std::string strVar, Real lowerBnd, Real upperBnd, Integer& nIterations, const Integer nMaxIterations, const Real aTolerance);
             Real brent(const std::string strVar, Real lowerBnd, Real upperBnd, Integer& nIterations, const Integer nMaxIterations, const Real aTolerance);
             Real root(const std::string strVar, Real lowerBnd, Real upperBnd, Integer& nIterations, const Integer nMaxIterations, const Real aTolerance);
@@ -9,6 +9,10 @@
 
 #pragma once
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace ENigMA
 {
 
@@ -16,13 +20,13 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CAnaFunction<Real>::CAnaFunction() : m_constant(false)
+        CAnaFunction<Real>::CAnaFunction() : m_compiled(false), m_constant(false), m_localNbVariables(0)
         {
 
         }
 
         template <typename Real>
-        CAnaFunction<Real>::CAnaFunction(Real aConstant)
+        CAnaFunction<Real>::CAnaFunction(Real aConstant) : m_compiled(false), m_localNbVariables(0)
         {
 
             this->set(aConstant);
@@ -30,19 +34,52 @@ namespace ENigMA
         }
 
         template <typename Real>
-        CAnaFunction<Real>::CAnaFunction(std::string anExpression)
+        CAnaFunction<Real>::CAnaFunction(std::string anExpression) : m_compiled(false), m_localNbVariables(0)
         {
 
             this->set(anExpression);
 
         }
 
+        template <typename Real>
+        CAnaFunction<Real>::CAnaFunction(const CAnaFunction<Real>& aFunction) : m_compiled(false), m_localNbVariables(0)
+        {
+
+            // Compiled expressions hold pointers into the source object so they are never shared
+            m_expressionString = aFunction.m_expressionString;
+            m_symbolTable = aFunction.m_symbolTable;
+            m_value = aFunction.m_value;
+            m_constant = aFunction.m_constant;
+
+        }
+
         template <typename Real>
         CAnaFunction<Real>::~CAnaFunction()
         {
 
         }
 
+        template <typename Real>
+        CAnaFunction<Real>& CAnaFunction<Real>::operator=(const CAnaFunction<Real>& aFunction)
+        {
+
+            if (this != &aFunction)
+            {
+
+                m_expressionString = aFunction.m_expressionString;
+                m_symbolTable = aFunction.m_symbolTable;
+                m_value = aFunction.m_value;
+                m_constant = aFunction.m_constant;
+
+                m_compiled = false;
+                m_localNbVariables = 0;
+
+            }
+
+            return *this;
+
+        }
+
         template <typename Real>
         void CAnaFunction<Real>::set(Real aConstant)
         {
@@ -59,6 +96,9 @@ namespace ENigMA
             m_expressionString = anExpression;
             m_constant = false;
 
+            m_compiled = false;
+            m_localNbVariables = 0;
+
         }
 
         template <typename Real>
@@ -67,6 +107,8 @@ namespace ENigMA
 
             m_symbolTable.add_variable(aVariable, aValue);
 
+            m_compiled = false;
+
         }
 
         template <typename Real>
@@ -75,6 +117,8 @@ namespace ENigMA
 
             m_symbolTable.remove_variable(aVariable);
 
+            m_compiled = false;
+
         }
 
         template <typename Real>
@@ -83,63 +127,179 @@ namespace ENigMA
 
             m_symbolTable.clear();
 
+            m_compiled = false;
+
         }
 
         template <typename Real>
-        Real CAnaFunction<Real>::evaluate()
+        void CAnaFunction<Real>::compile()
         {
 
-            if (m_constant)
-                return m_value;
-
-            exprtk::expression<Real> expression;
             exprtk::parser<Real> parser;
 
             m_symbolTable.add_constants();
 
-            expression.register_symbol_table(m_symbolTable);
-            parser.compile(m_expressionString, expression);
+            m_expression = exprtk::expression<Real>();
+            m_expression.register_symbol_table(m_symbolTable);
+            parser.compile(m_expressionString, m_expression);
 
-            return expression.value();
+            m_compiled = true;
 
         }
 
         template <typename Real>
-        Real CAnaFunction<Real>::evaluate(const std::string aVariable, Real& aValue)
+        void CAnaFunction<Real>::compileLocal(const std::string aVariable1)
         {
 
-            exprtk::expression<Real> expression;
             exprtk::parser<Real> parser;
 
-            m_symbolTable.clear();
+            m_localSymbolTable = exprtk::symbol_table<Real>();
 
-            m_symbolTable.add_variable(aVariable, aValue);
-            m_symbolTable.add_constants();
+            m_localSymbolTable.add_variable(aVariable1, m_localValue1);
+            m_localSymbolTable.add_constants();
 
-            expression.register_symbol_table(m_symbolTable);
-            parser.compile(m_expressionString, expression);
+            m_localExpression = exprtk::expression<Real>();
+            m_localExpression.register_symbol_table(m_localSymbolTable);
+            parser.compile(m_expressionString, m_localExpression);
 
-            return expression.value();
+            m_localVariable1 = aVariable1;
+            m_localNbVariables = 1;
 
         }
 
         template <typename Real>
-        Real CAnaFunction<Real>::evaluate(const std::string aVariable1, Real& aValue1, const std::string aVariable2, Real& aValue2)
+        void CAnaFunction<Real>::compileLocal(const std::string aVariable1, const std::string aVariable2)
         {
 
-            exprtk::expression<Real> expression;
             exprtk::parser<Real> parser;
 
-            m_symbolTable.clear();
+            m_localSymbolTable = exprtk::symbol_table<Real>();
 
-            m_symbolTable.add_variable(aVariable1, aValue1);
-            m_symbolTable.add_variable(aVariable2, aValue2);
-            m_symbolTable.add_constants();
+            m_localSymbolTable.add_variable(aVariable1, m_localValue1);
+            m_localSymbolTable.add_variable(aVariable2, m_localValue2);
+            m_localSymbolTable.add_constants();
+
+            m_localExpression = exprtk::expression<Real>();
+            m_localExpression.register_symbol_table(m_localSymbolTable);
+            parser.compile(m_expressionString, m_localExpression);
+
+            m_localVariable1 = aVariable1;
+            m_localVariable2 = aVariable2;
+            m_localNbVariables = 2;
+
+        }
+
+        template <typename Real>
+        Real CAnaFunction<Real>::evaluate()
+        {
+
+            if (m_constant)
+                return m_value;
+
+            if (!m_compiled)
+                this->compile();
+
+            return m_expression.value();
+
+        }
+
+        template <typename Real>
+        Real CAnaFunction<Real>::evaluate(const std::string aVariable, Real& aValue)
+        {
+
+            if (m_constant)
+                return m_value;
+
+            if (m_localNbVariables != 1 || m_localVariable1 != aVariable)
+                this->compileLocal(aVariable);
+
+            m_localValue1 = aValue;
+
+            return m_localExpression.value();
+
+        }
+
+        template <typename Real>
+        Real CAnaFunction<Real>::evaluate(const std::string aVariable1, Real& aValue1, const std::string aVariable2, Real& aValue2)
+        {
+
+            if (m_constant)
+                return m_value;
+
+            if (m_localNbVariables != 2 || m_localVariable1 != aVariable1 || m_localVariable2 != aVariable2)
+                this->compileLocal(aVariable1, aVariable2);
+
+            m_localValue1 = aValue1;
+            m_localValue2 = aValue2;
+
+            return m_localExpression.value();
+
+        }
+
+        template <typename Real>
+        void CAnaFunction<Real>::evaluate(const std::vector<std::string>& sVariables, const std::vector<std::vector<Real> >& sColumns, std::vector<Real>& sValues, const Integer nbThreads)
+        {
+
+            const Integer nbVariables = static_cast<Integer>(sVariables.size());
+            const Integer nbPoints = sColumns.empty() ? 0 : static_cast<Integer>(sColumns[0].size());
 
-            expression.register_symbol_table(m_symbolTable);
-            parser.compile(m_expressionString, expression);
+            sValues.resize(nbPoints);
 
-            return expression.value();
+            if (m_constant)
+            {
+                std::fill(sValues.begin(), sValues.end(), m_value);
+                return;
+            }
+
+            // Snapshot user defined variables so that every thread reads its own copy
+            std::vector<std::pair<std::string, Real> > sDefinedVariables;
+            m_symbolTable.get_variable_list(sDefinedVariables);
+
+#ifdef _OPENMP
+            const Integer nbUsedThreads = (nbThreads > 0) ? nbThreads : omp_get_max_threads();
+#else
+            const Integer nbUsedThreads = 1;
+#endif
+
+            // Each thread compiles a private expression bound to its own row of values
+            #pragma omp parallel num_threads(nbUsedThreads) if(nbPoints > 16384)
+            {
+
+                std::vector<Real> sRow(nbVariables + sDefinedVariables.size(), 0.0);
+
+                exprtk::symbol_table<Real> aSymbolTable;
+                exprtk::expression<Real> anExpression;
+                exprtk::parser<Real> parser;
+
+                for (Integer j = 0; j < nbVariables; ++j)
+                    aSymbolTable.add_variable(sVariables[j], sRow[j]);
+
+                for (Integer j = 0; j < static_cast<Integer>(sDefinedVariables.size()); ++j)
+                {
+                    if (!aSymbolTable.symbol_exists(sDefinedVariables[j].first))
+                    {
+                        sRow[nbVariables + j] = sDefinedVariables[j].second;
+                        aSymbolTable.add_variable(sDefinedVariables[j].first, sRow[nbVariables + j]);
+                    }
+                }
+
+                aSymbolTable.add_constants();
+
+                anExpression.register_symbol_table(aSymbolTable);
+                parser.compile(m_expressionString, anExpression);
+
+                #pragma omp for schedule(static)
+                for (Integer i = 0; i < nbPoints; ++i)
+                {
+
+                    for (Integer j = 0; j < nbVariables; ++j)
+                        sRow[j] = sColumns[j][i];
+
+                    sValues[i] = anExpression.value();
+
+                }
+
+            }
 
         }
 
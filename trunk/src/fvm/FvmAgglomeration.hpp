@@ -0,0 +1,69 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include "FvmMesh.hpp"
+
+namespace ENigMA
+{
+
+    namespace fvm
+    {
+
+        // Coarse levels of a finite volume mesh made by merging face neighbours. Cells are paired with the
+        // neighbour they share the largest area / distance with, twice per level. The aggregates are meant
+        // for CSleSolver::setAggregates so the multigrid follows the mesh instead of the matrix.
+        template <typename Real>
+        class CFvmAgglomeration
+        {
+        private:
+
+            // Cell graph of a level (CSR), weights are the summed face area / distance
+            struct CFvmGraph
+            {
+                std::vector<Integer> offsets;
+                std::vector<Integer> neighbors;
+                std::vector<Real> weights;
+            };
+
+            std::vector<std::vector<Integer> > m_aggregates;    // Fine to coarse map of every level
+            std::vector<Integer> m_levelSizes;
+
+            Integer m_coarseSize;
+            Integer m_maxLevels;
+
+            void pair(const CFvmGraph& aGraph, std::vector<Integer>& sPairs, Integer& nbPairs);
+            void coarsen(const CFvmGraph& aGraph, const std::vector<Integer>& sAggregates, const Integer nbAggregates, CFvmGraph& aCoarseGraph);
+
+        public:
+
+            CFvmAgglomeration();
+            CFvmAgglomeration(CFvmMesh<Real>& aFvmMesh);
+            ~CFvmAgglomeration();
+
+            void setCoarseSize(const Integer aCoarseSize);
+            void setMaxLevels(const Integer aMaxLevels);
+
+            void build(CFvmMesh<Real>& aFvmMesh);
+
+            Integer nbLevels();
+            Integer levelSize(const Integer aLevel);
+
+            std::vector<std::vector<Integer> >& aggregates();
+
+        };
+
+    }
+
+}
+
+#include "FvmAgglomeration_Imp.hpp"
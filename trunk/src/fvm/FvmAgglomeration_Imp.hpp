@@ -0,0 +1,314 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+
+namespace ENigMA
+{
+
+    namespace fvm
+    {
+
+        template <typename Real>
+        CFvmAgglomeration<Real>::CFvmAgglomeration() :
+            m_coarseSize(200),
+            m_maxLevels(20)
+        {
+
+        }
+
+        template <typename Real>
+        CFvmAgglomeration<Real>::CFvmAgglomeration(CFvmMesh<Real>& aFvmMesh) :
+            m_coarseSize(200),
+            m_maxLevels(20)
+        {
+
+            this->build(aFvmMesh);
+
+        }
+
+        template <typename Real>
+        CFvmAgglomeration<Real>::~CFvmAgglomeration()
+        {
+
+        }
+
+        template <typename Real>
+        void CFvmAgglomeration<Real>::setCoarseSize(const Integer aCoarseSize)
+        {
+
+            m_coarseSize = aCoarseSize;
+
+        }
+
+        template <typename Real>
+        void CFvmAgglomeration<Real>::setMaxLevels(const Integer aMaxLevels)
+        {
+
+            m_maxLevels = aMaxLevels;
+
+        }
+
+        template <typename Real>
+        void CFvmAgglomeration<Real>::pair(const CFvmGraph& aGraph, std::vector<Integer>& sPairs, Integer& nbPairs)
+        {
+
+            const Integer n = static_cast<Integer>(aGraph.offsets.size()) - 1;
+
+            sPairs.assign(n, -1);
+            nbPairs = 0;
+
+            std::vector<Integer> sLeft;
+
+            for (Integer i = 0; i < n; ++i)
+            {
+
+                if (sPairs[i] >= 0)
+                    continue;
+
+                // Strongest free neighbour
+                Integer aBest = -1;
+                Real aBestWeight = 0.0;
+
+                for (Integer k = aGraph.offsets[i]; k < aGraph.offsets[i + 1]; ++k)
+                {
+
+                    Integer j = aGraph.neighbors[k];
+
+                    if (sPairs[j] < 0 && aGraph.weights[k] > aBestWeight)
+                    {
+                        aBest = j;
+                        aBestWeight = aGraph.weights[k];
+                    }
+
+                }
+
+                if (aBest < 0)
+                {
+                    sLeft.push_back(i);
+                    sPairs[i] = -2;
+                    continue;
+                }
+
+                sPairs[i] = nbPairs;
+                sPairs[aBest] = nbPairs;
+
+                nbPairs++;
+
+            }
+
+            // Cells left without a free neighbour join their strongest neighbour, isolated ones stay alone
+            for (Integer l = 0; l < static_cast<Integer>(sLeft.size()); ++l)
+            {
+
+                Integer i = sLeft[l];
+
+                Integer aBest = -1;
+                Real aBestWeight = 0.0;
+
+                for (Integer k = aGraph.offsets[i]; k < aGraph.offsets[i + 1]; ++k)
+                {
+
+                    Integer j = aGraph.neighbors[k];
+
+                    if (sPairs[j] >= 0 && aGraph.weights[k] > aBestWeight)
+                    {
+                        aBest = j;
+                        aBestWeight = aGraph.weights[k];
+                    }
+
+                }
+
+                if (aBest >= 0)
+                    sPairs[i] = sPairs[aBest];
+                else
+                    sPairs[i] = nbPairs++;
+
+            }
+
+        }
+
+        template <typename Real>
+        void CFvmAgglomeration<Real>::coarsen(const CFvmGraph& aGraph, const std::vector<Integer>& sAggregates, const Integer nbAggregates, CFvmGraph& aCoarseGraph)
+        {
+
+            const Integer n = static_cast<Integer>(aGraph.offsets.size()) - 1;
+
+            // Faces between two aggregates are summed, faces inside one disappear
+            std::vector<std::pair<std::pair<Integer, Integer>, Real> > sEdges;
+
+            sEdges.reserve(aGraph.neighbors.size());
+
+            for (Integer i = 0; i < n; ++i)
+            {
+
+                for (Integer k = aGraph.offsets[i]; k < aGraph.offsets[i + 1]; ++k)
+                {
+
+                    Integer a = sAggregates[i];
+                    Integer b = sAggregates[aGraph.neighbors[k]];
+
+                    if (a != b)
+                        sEdges.push_back(std::make_pair(std::make_pair(a, b), aGraph.weights[k]));
+
+                }
+
+            }
+
+            std::sort(sEdges.begin(), sEdges.end());
+
+            aCoarseGraph.offsets.assign(nbAggregates + 1, 0);
+            aCoarseGraph.neighbors.clear();
+            aCoarseGraph.weights.clear();
+
+            for (Integer e = 0; e < static_cast<Integer>(sEdges.size()); ++e)
+            {
+
+                if (e > 0 && sEdges[e].first == sEdges[e - 1].first)
+                {
+                    aCoarseGraph.weights.back() += sEdges[e].second;
+                    continue;
+                }
+
+                aCoarseGraph.neighbors.push_back(sEdges[e].first.second);
+                aCoarseGraph.weights.push_back(sEdges[e].second);
+
+                aCoarseGraph.offsets[sEdges[e].first.first + 1]++;
+
+            }
+
+            for (Integer a = 0; a < nbAggregates; ++a)
+                aCoarseGraph.offsets[a + 1] += aCoarseGraph.offsets[a];
+
+        }
+
+        template <typename Real>
+        void CFvmAgglomeration<Real>::build(CFvmMesh<Real>& aFvmMesh)
+        {
+
+            m_aggregates.clear();
+            m_levelSizes.clear();
+
+            aFvmMesh.calculateFaceGeometry();
+
+            const Integer nbControlVolumes = aFvmMesh.nbControlVolumes();
+            const Integer nbFaces = aFvmMesh.nbFaces();
+
+            // Cell graph of the mesh, weighted by the geometric part of the face diffusion coefficient
+            CFvmGraph aGraph;
+
+            aGraph.offsets.assign(nbControlVolumes + 1, 0);
+
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+
+                if (aFvmMesh.faceNeighbor(i) < 0)
+                    continue;
+
+                aGraph.offsets[aFvmMesh.faceOwner(i) + 1]++;
+                aGraph.offsets[aFvmMesh.faceNeighbor(i) + 1]++;
+
+            }
+
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+                aGraph.offsets[i + 1] += aGraph.offsets[i];
+
+            aGraph.neighbors.resize(aGraph.offsets[nbControlVolumes]);
+            aGraph.weights.resize(aGraph.offsets[nbControlVolumes]);
+
+            std::vector<Integer> sPositions(aGraph.offsets.begin(), aGraph.offsets.end() - 1);
+
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+
+                Integer anIndexO = aFvmMesh.faceOwner(i);
+                Integer anIndexN = aFvmMesh.faceNeighbor(i);
+
+                if (anIndexN < 0)
+                    continue;
+
+                Real dist = aFvmMesh.faceOwnerDist(i) + aFvmMesh.faceNeighborDist(i);
+                Real aWeight = (dist > 0.0) ? aFvmMesh.faceArea(i) / dist : 0.0;
+
+                aGraph.neighbors[sPositions[anIndexO]] = anIndexN;
+                aGraph.weights[sPositions[anIndexO]++] = aWeight;
+
+                aGraph.neighbors[sPositions[anIndexN]] = anIndexO;
+                aGraph.weights[sPositions[anIndexN]++] = aWeight;
+
+            }
+
+            m_levelSizes.push_back(nbControlVolumes);
+
+            Integer n = nbControlVolumes;
+
+            while (n > m_coarseSize && static_cast<Integer>(m_levelSizes.size()) < m_maxLevels)
+            {
+
+                // Two pairing passes give aggregates of about four cells
+                std::vector<Integer> sPairs1, sPairs2;
+                Integer nbPairs1, nbPairs2;
+
+                CFvmGraph aPairGraph, aCoarseGraph;
+
+                this->pair(aGraph, sPairs1, nbPairs1);
+                this->coarsen(aGraph, sPairs1, nbPairs1, aPairGraph);
+
+                this->pair(aPairGraph, sPairs2, nbPairs2);
+                this->coarsen(aPairGraph, sPairs2, nbPairs2, aCoarseGraph);
+
+                // Stop when the graph no longer shrinks (e.g. disconnected cells)
+                if (nbPairs2 * 10 > n * 9)
+                    break;
+
+                std::vector<Integer> sAggregates(n);
+
+                for (Integer i = 0; i < n; ++i)
+                    sAggregates[i] = sPairs2[sPairs1[i]];
+
+                m_aggregates.push_back(sAggregates);
+                m_levelSizes.push_back(nbPairs2);
+
+                aGraph = aCoarseGraph;
+
+                n = nbPairs2;
+
+            }
+
+        }
+
+        template <typename Real>
+        Integer CFvmAgglomeration<Real>::nbLevels()
+        {
+
+            return static_cast<Integer>(m_levelSizes.size());
+
+        }
+
+        template <typename Real>
+        Integer CFvmAgglomeration<Real>::levelSize(const Integer aLevel)
+        {
+
+            return m_levelSizes[aLevel];
+
+        }
+
+        template <typename Real>
+        std::vector<std::vector<Integer> >& CFvmAgglomeration<Real>::aggregates()
+        {
+
+            return m_aggregates;
+
+        }
+
+    }
+
+}
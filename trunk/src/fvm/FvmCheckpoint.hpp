@@ -0,0 +1,82 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CmnTypes.hpp"
+
+namespace ENigMA
+{
+
+    namespace fvm
+    {
+
+        // Binary checkpoint made of tagged blocks, values are stored in native byte order
+        template <typename Real>
+        class CFvmCheckpoint
+        {
+        private:
+
+            typedef std::map<std::string, std::pair<std::size_t, std::size_t> > mapBlock;
+
+            std::vector<char> m_buffer;
+
+            mapBlock m_blocks;              // Block tag to (data offset, data size)
+
+            std::string m_blockTag;         // Tag of the block being written
+            std::size_t m_blockStart;       // Offset of the size field of the block being written
+            std::size_t m_position;         // Read position
+            std::size_t m_blockEnd;         // End of the block being read
+
+            void writeBytes(const void* aData, const std::size_t aSize);
+            bool readBytes(void* aData, const std::size_t aSize);
+
+        public:
+
+            CFvmCheckpoint();
+            ~CFvmCheckpoint();
+
+            void clear();
+
+            void beginBlock(const std::string& strTag);
+            void endBlock();
+
+            bool hasBlock(const std::string& strTag);
+            bool openBlock(const std::string& strTag);
+
+            template <typename T>
+            void write(const T& aValue);
+
+            template <typename T>
+            void write(const std::vector<T>& sValues);
+
+            template <typename T>
+            bool read(T& aValue);
+
+            template <typename T>
+            bool read(std::vector<T>& sValues);
+
+            std::size_t size();
+
+            bool save(const std::string strFileName);
+            bool load(const std::string strFileName);
+
+        };
+
+    }
+
+}
+
+#include "FvmCheckpoint_Imp.hpp"
@@ -0,0 +1,319 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+namespace ENigMA
+{
+
+    namespace fvm
+    {
+
+        static const char FVM_CHECKPOINT_MAGIC[8] = { 'E', 'N', 'I', 'G', 'M', 'A', 'F', 'V' };
+        static const Integer FVM_CHECKPOINT_VERSION = 1;
+
+        template <typename Real>
+        CFvmCheckpoint<Real>::CFvmCheckpoint() : m_blockStart(0), m_position(0), m_blockEnd(0)
+        {
+
+        }
+
+        template <typename Real>
+        CFvmCheckpoint<Real>::~CFvmCheckpoint()
+        {
+
+        }
+
+        template <typename Real>
+        void CFvmCheckpoint<Real>::clear()
+        {
+
+            m_buffer.clear();
+            m_blocks.clear();
+
+            m_blockTag.clear();
+            m_blockStart = 0;
+            m_position = 0;
+            m_blockEnd = 0;
+
+        }
+
+        template <typename Real>
+        void CFvmCheckpoint<Real>::writeBytes(const void* aData, const std::size_t aSize)
+        {
+
+            if (aSize == 0)
+                return;
+
+            const std::size_t anOffset = m_buffer.size();
+
+            m_buffer.resize(anOffset + aSize);
+
+            std::memcpy(&m_buffer[anOffset], aData, aSize);
+
+        }
+
+        template <typename Real>
+        bool CFvmCheckpoint<Real>::readBytes(void* aData, const std::size_t aSize)
+        {
+
+            if (m_position + aSize > m_blockEnd)
+                return false;
+
+            if (aSize > 0)
+                std::memcpy(aData, &m_buffer[m_position], aSize);
+
+            m_position += aSize;
+
+            return true;
+
+        }
+
+        template <typename Real>
+        void CFvmCheckpoint<Real>::beginBlock(const std::string& strTag)
+        {
+
+            Integer aLength = static_cast<Integer>(strTag.size());
+
+            this->writeBytes(&aLength, sizeof(Integer));
+            this->writeBytes(strTag.data(), strTag.size());
+
+            // The size is patched by endBlock
+            unsigned long long aSize = 0;
+
+            m_blockStart = m_buffer.size();
+
+            this->writeBytes(&aSize, sizeof(aSize));
+
+            m_blockTag = strTag;
+
+        }
+
+        template <typename Real>
+        void CFvmCheckpoint<Real>::endBlock()
+        {
+
+            const std::size_t aDataStart = m_blockStart + sizeof(unsigned long long);
+
+            unsigned long long aSize = m_buffer.size() - aDataStart;
+
+            std::memcpy(&m_buffer[m_blockStart], &aSize, sizeof(aSize));
+
+            m_blocks[m_blockTag] = std::make_pair(aDataStart, static_cast<std::size_t>(aSize));
+
+        }
+
+        template <typename Real>
+        bool CFvmCheckpoint<Real>::hasBlock(const std::string& strTag)
+        {
+
+            return m_blocks.find(strTag) != m_blocks.end();
+
+        }
+
+        template <typename Real>
+        bool CFvmCheckpoint<Real>::openBlock(const std::string& strTag)
+        {
+
+            typename mapBlock::iterator it = m_blocks.find(strTag);
+
+            if (it == m_blocks.end())
+                return false;
+
+            m_position = it->second.first;
+            m_blockEnd = it->second.first + it->second.second;
+
+            return true;
+
+        }
+
+        template <typename Real>
+        template <typename T>
+        void CFvmCheckpoint<Real>::write(const T& aValue)
+        {
+
+            this->writeBytes(&aValue, sizeof(T));
+
+        }
+
+        template <typename Real>
+        template <typename T>
+        void CFvmCheckpoint<Real>::write(const std::vector<T>& sValues)
+        {
+
+            Integer aSize = static_cast<Integer>(sValues.size());
+
+            this->writeBytes(&aSize, sizeof(Integer));
+
+            if (aSize > 0)
+                this->writeBytes(&sValues[0], sValues.size() * sizeof(T));
+
+        }
+
+        template <typename Real>
+        template <typename T>
+        bool CFvmCheckpoint<Real>::read(T& aValue)
+        {
+
+            return this->readBytes(&aValue, sizeof(T));
+
+        }
+
+        template <typename Real>
+        template <typename T>
+        bool CFvmCheckpoint<Real>::read(std::vector<T>& sValues)
+        {
+
+            Integer aSize;
+
+            if (!this->readBytes(&aSize, sizeof(Integer)) || aSize < 0)
+                return false;
+
+            if (m_position + static_cast<std::size_t>(aSize) * sizeof(T) > m_blockEnd)
+                return false;
+
+            sValues.resize(aSize);
+
+            if (aSize > 0)
+                return this->readBytes(&sValues[0], aSize * sizeof(T));
+
+            return true;
+
+        }
+
+        template <typename Real>
+        std::size_t CFvmCheckpoint<Real>::size()
+        {
+
+            return m_buffer.size();
+
+        }
+
+        template <typename Real>
+        bool CFvmCheckpoint<Real>::save(const std::string strFileName)
+        {
+
+            std::ofstream fileCheckpoint;
+
+            fileCheckpoint.open(strFileName.c_str(), std::ios_base::out | std::ios::binary);
+
+            if (!fileCheckpoint.is_open())
+                return false;
+
+            Integer aVersion = FVM_CHECKPOINT_VERSION;
+            Integer aRealSize = sizeof(Real);
+            Integer anIntegerSize = sizeof(Integer);
+
+            fileCheckpoint.write(FVM_CHECKPOINT_MAGIC, sizeof(FVM_CHECKPOINT_MAGIC));
+            fileCheckpoint.write(reinterpret_cast<const char*>(&aVersion), sizeof(Integer));
+            fileCheckpoint.write(reinterpret_cast<const char*>(&aRealSize), sizeof(Integer));
+            fileCheckpoint.write(reinterpret_cast<const char*>(&anIntegerSize), sizeof(Integer));
+
+            if (!m_buffer.empty())
+                fileCheckpoint.write(&m_buffer[0], m_buffer.size());
+
+            fileCheckpoint.close();
+
+            return !fileCheckpoint.fail();
+
+        }
+
+        template <typename Real>
+        bool CFvmCheckpoint<Real>::load(const std::string strFileName)
+        {
+
+            this->clear();
+
+            std::ifstream fileCheckpoint;
+
+            fileCheckpoint.open(strFileName.c_str(), std::ios_base::in | std::ios::binary);
+
+            if (!fileCheckpoint.is_open())
+                return false;
+
+            char aMagic[sizeof(FVM_CHECKPOINT_MAGIC)];
+
+            Integer aVersion = 0;
+            Integer aRealSize = 0;
+            Integer anIntegerSize = 0;
+
+            fileCheckpoint.read(aMagic, sizeof(aMagic));
+            fileCheckpoint.read(reinterpret_cast<char*>(&aVersion), sizeof(Integer));
+            fileCheckpoint.read(reinterpret_cast<char*>(&aRealSize), sizeof(Integer));
+            fileCheckpoint.read(reinterpret_cast<char*>(&anIntegerSize), sizeof(Integer));
+
+            if (fileCheckpoint.fail() ||
+                std::memcmp(aMagic, FVM_CHECKPOINT_MAGIC, sizeof(aMagic)) != 0 ||
+                aVersion != FVM_CHECKPOINT_VERSION ||
+                aRealSize != static_cast<Integer>(sizeof(Real)) ||
+                anIntegerSize != static_cast<Integer>(sizeof(Integer)))
+                return false;
+
+            // Rest of the file is the block buffer
+            const std::streampos aStart = fileCheckpoint.tellg();
+
+            fileCheckpoint.seekg(0, std::ios::end);
+
+            const std::size_t aSize = static_cast<std::size_t>(fileCheckpoint.tellg() - aStart);
+
+            fileCheckpoint.seekg(aStart);
+
+            m_buffer.resize(aSize);
+
+            if (aSize > 0)
+                fileCheckpoint.read(&m_buffer[0], aSize);
+
+            if (fileCheckpoint.fail())
+            {
+                this->clear();
+                return false;
+            }
+
+            // Index the blocks
+            m_position = 0;
+            m_blockEnd = m_buffer.size();
+
+            while (m_position < m_buffer.size())
+            {
+
+                Integer aLength;
+                unsigned long long aBlockSize;
+
+                if (!this->readBytes(&aLength, sizeof(Integer)) || aLength < 0 || m_position + static_cast<std::size_t>(aLength) > m_blockEnd)
+                {
+                    this->clear();
+                    return false;
+                }
+
+                std::string strTag(&m_buffer[m_position], aLength);
+
+                m_position += aLength;
+
+                if (!this->readBytes(&aBlockSize, sizeof(aBlockSize)) || m_position + aBlockSize > m_blockEnd)
+                {
+                    this->clear();
+                    return false;
+                }
+
+                m_blocks[strTag] = std::make_pair(m_position, static_cast<std::size_t>(aBlockSize));
+
+                m_position += static_cast<std::size_t>(aBlockSize);
+
+            }
+
+            m_position = 0;
+            m_blockEnd = 0;
+
+            return true;
+
+        }
+
+    }
+
+}
@@ -45,7 +45,7 @@ namespace ENigMA
             Integer controlVolumeId();
 
             Integer nbFaces();
-            void addFace(const Integer aFaceId, CFvmFace<Real>& aFace);
+            void addFace(const Integer aFaceId, CFvmFace<Real>& aFace, const bool bInvert = false);
             Integer faceId(const Integer aFaceIndex);
 
             bool containsFace(const Integer aFaceId);
@@ -66,13 +66,16 @@ namespace ENigMA
         }
 
         template <typename Real>
-        void CFvmControlVolume<Real>::addFace(const Integer aFaceId, CFvmFace<Real>& aFace)
+        void CFvmControlVolume<Real>::addFace(const Integer aFaceId, CFvmFace<Real>& aFace, const bool bInvert)
         {
 
             CGeoPolygon<Real> aPolygon;
 
             aPolygon.setPolyline(aFace.polyline());
 
+            if (bInvert)
+                aPolygon.polyline().invert();
+
             m_polyhedron.addPolygon(aFaceId, aPolygon);
 
         }
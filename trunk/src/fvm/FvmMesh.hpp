@@ -17,6 +17,7 @@
 #include "FvmNode.hpp"
 #include "FvmFace.hpp"
 #include "FvmControlVolume.hpp"
+#include "FvmCheckpoint.hpp"
 
 using namespace ENigMA::mesh;
 
@@ -51,6 +52,23 @@ namespace ENigMA
 
             CMshMesh<Real> m_mesh;
 
+            bool m_bFaceGeometry;
+
+            // Face connectivity and geometry by face index, filled by calculateFaceGeometry
+            std::vector<Integer> m_faceOwners;
+            std::vector<Integer> m_faceNeighbors;
+            std::vector<Real> m_faceAreas;
+            std::vector<ENigMA::geometry::CGeoNormal<Real> > m_faceNormals;
+            std::vector<Real> m_faceOwnerDists;
+            std::vector<Real> m_faceNeighborDists;
+            std::vector<Real> m_faceWeights;
+
+            std::vector<Real> m_originalVolumes;
+
+            // Faces of each control volume by face index in ascending order (CSR), filled by calculateFaceGeometry
+            std::vector<Integer> m_controlVolumeFaceOffsets;
+            std::vector<Integer> m_controlVolumeFaces;
+
         public:
             CFvmMesh();
             CFvmMesh(CMshMesh<Real>& aMesh);
@@ -80,6 +98,25 @@ namespace ENigMA
 
             Real volume();
 
+            void calculateFaceGeometry(bool bReCalculate = false);
+            bool hasFaceGeometry();
+
+            void writeFaceGeometry(CFvmCheckpoint<Real>& aCheckpoint);
+            bool readFaceGeometry(CFvmCheckpoint<Real>& aCheckpoint);
+
+            Integer faceOwner(const Integer aFaceIndex);
+            Integer faceNeighbor(const Integer aFaceIndex);
+            Real faceArea(const Integer aFaceIndex);
+            ENigMA::geometry::CGeoNormal<Real>& faceNormal(const Integer aFaceIndex);
+            Real faceOwnerDist(const Integer aFaceIndex);
+            Real faceNeighborDist(const Integer aFaceIndex);
+            Real faceWeight(const Integer aFaceIndex);
+
+            Real originalVolume(const Integer aControlVolumeIndex);
+
+            Integer nbControlVolumeFaces(const Integer aControlVolumeIndex);
+            Integer controlVolumeFace(const Integer aControlVolumeIndex, const Integer i);
+
         };
 
     }
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <vector>
 
@@ -30,6 +32,9 @@ namespace ENigMA
             CFvmMesh<Real>* m_mesh;
 
             CGeoHashGrid<Real> m_boundaryFaceHashGrid;
+            CGeoHashGrid<Real> m_controlVolumeHashGrid;
+
+            Real m_controlVolumeRadius;     // Largest centroid to vertex distance of the mesh
 
         public:
 
@@ -43,6 +48,9 @@ namespace ENigMA
 
             void findClosestBoundaryFace(CGeoCoordinate<Real>& aCoordinate, Integer& aFaceId, const Real aTolerance);
 
+            bool isInsideControlVolume(CGeoCoordinate<Real>& aCoordinate, const Integer aControlVolumeId, const Real aTolerance);
+            bool findControlVolume(CGeoCoordinate<Real>& aCoordinate, Integer& aControlVolumeId, const Real aTolerance);
+
         };
 
     }
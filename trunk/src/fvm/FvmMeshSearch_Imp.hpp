@@ -16,13 +16,16 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CFvmMeshSearch<Real>::CFvmMeshSearch()
+        CFvmMeshSearch<Real>::CFvmMeshSearch() :
+            m_mesh(nullptr),
+            m_controlVolumeRadius(0.0)
         {
 
         }
 
         template <typename Real>
-        CFvmMeshSearch<Real>::CFvmMeshSearch(CFvmMesh<Real>& aMesh)
+        CFvmMeshSearch<Real>::CFvmMeshSearch(CFvmMesh<Real>& aMesh) :
+            m_controlVolumeRadius(0.0)
         {
 
             this->set(aMesh);
@@ -41,6 +44,9 @@ namespace ENigMA
 
             m_mesh = &aMesh;
             m_boundaryFaceHashGrid.reset();
+            m_controlVolumeHashGrid.reset();
+
+            m_controlVolumeRadius = 0.0;
 
         }
 
@@ -60,6 +66,30 @@ namespace ENigMA
 
             m_boundaryFaceHashGrid.build();
 
+            m_mesh->calculateFaceGeometry();
+
+            // Control volume centroids, a point can only be inside a control volume whose centroid lies within the largest vertex distance
+            for (Integer i = 0; i < m_mesh->nbControlVolumes(); ++i)
+            {
+
+                CFvmControlVolume<Real>& aControlVolume = m_mesh->controlVolume(m_mesh->controlVolumeId(i));
+
+                m_controlVolumeHashGrid.addGeometricObject(m_mesh->controlVolumeId(i), aControlVolume.centroid());
+
+                for (Integer j = 0; j < m_mesh->nbControlVolumeFaces(i); ++j)
+                {
+
+                    CFvmFace<Real>& aFace = m_mesh->face(m_mesh->faceId(m_mesh->controlVolumeFace(i, j)));
+
+                    for (Integer k = 0; k < aFace.polyline().nbVertices(); ++k)
+                        m_controlVolumeRadius = std::max(m_controlVolumeRadius, (aFace.polyline().vertex(k) - aControlVolume.centroid()).norm());
+
+                }
+
+            }
+
+            m_controlVolumeHashGrid.build();
+
         }
 
         template <typename Real>
@@ -101,8 +131,64 @@ namespace ENigMA
 
         }
 
-    }
+            template <typename Real>
+        bool CFvmMeshSearch<Real>::isInsideControlVolume(CGeoCoordinate<Real>& aCoordinate, const Integer aControlVolumeId, const Real aTolerance)
+        {
 
-}
+            const Integer anIndex = m_mesh->controlVolumeIndex(aControlVolumeId);
+
+            // Convex control volume: the point lies behind every face plane
+            for (Integer j = 0; j < m_mesh->nbControlVolumeFaces(anIndex); ++j)
+            {
+
+                Integer aFaceIndex = m_mesh->controlVolumeFace(anIndex, j);
+
+                Real sign = (m_mesh->faceOwner(aFaceIndex) == anIndex) ? 1.0 : -1.0;
+
+                CGeoVector<Real> d = aCoordinate - m_mesh->face(m_mesh->faceId(aFaceIndex)).centroid();
+
+                if (sign * d.dot(m_mesh->faceNormal(aFaceIndex)) > aTolerance)
+                    return false;
+
+            }
+
+            return true;
+
+        }
+
+        template <typename Real>
+        bool CFvmMeshSearch<Real>::findControlVolume(CGeoCoordinate<Real>& aCoordinate, Integer& aControlVolumeId, const Real aTolerance)
+        {
+
+            std::vector<Integer> sControlVolumeIds;
+
+            m_controlVolumeHashGrid.find(sControlVolumeIds, aCoordinate, m_controlVolumeRadius + aTolerance);
+
+            Real minDist = std::numeric_limits<Real>::max();
+
+            aControlVolumeId = -1;
+
+            for (Integer i = 0; i < static_cast<Integer> (sControlVolumeIds.size()); ++i)
+            {
 
+                if (!this->isInsideControlVolume(aCoordinate, sControlVolumeIds[i], aTolerance))
+                    continue;
 
+                // On a shared face the closest centroid wins
+                Real thisDist = (m_mesh->controlVolume(sControlVolumeIds[i]).centroid() - aCoordinate).norm();
+
+                if (thisDist < minDist)
+                {
+                    aControlVolumeId = sControlVolumeIds[i];
+                    minDist = thisDist;
+                }
+
+            }
+
+            return aControlVolumeId >= 0;
+
+        }
+
+    }
+
+}
@@ -16,13 +16,13 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CFvmMesh<Real>::CFvmMesh() : m_faceIndex(0), m_controlVolumeIndex(0)
+        CFvmMesh<Real>::CFvmMesh() : m_faceIndex(0), m_controlVolumeIndex(0), m_bFaceGeometry(false)
         {
 
         }
 
         template <typename Real>
-        CFvmMesh<Real>::CFvmMesh(CMshMesh<Real>& aMesh) : m_faceIndex(0), m_controlVolumeIndex(0)
+        CFvmMesh<Real>::CFvmMesh(CMshMesh<Real>& aMesh) : m_faceIndex(0), m_controlVolumeIndex(0), m_bFaceGeometry(false)
         {
 
             this->set(aMesh);
@@ -43,92 +43,133 @@ namespace ENigMA
 
             m_mesh = aMesh;
 
-            std::map<Integer, Integer> newFaceIds;
+            const Integer nbNodes = aMesh.nbNodes();
+            const Integer nbMshFaces = aMesh.nbFaces();
+            const Integer nbElements = aMesh.nbElements();
 
-            std::map<Integer, bool> faceAdded;
+            // Node coordinates by node id
+            Integer aMaxNodeId = -1;
 
-            for (Integer i = 0; i < aMesh.nbFaces(); ++i)
-                faceAdded[aMesh.faceId(i)] = false;
+            for (Integer i = 0; i < nbNodes; ++i)
+                aMaxNodeId = std::max(aMaxNodeId, aMesh.nodeId(i));
+
+            std::vector<CFvmNode<Real> > sNodes(aMaxNodeId + 1);
+
+            for (Integer i = 0; i < nbNodes; ++i)
+            {
+
+                Integer aNodeId = aMesh.nodeId(i);
+
+                sNodes[aNodeId] = CFvmNode<Real>(aMesh.node(aNodeId));
+
+            }
+
+            // Mesh faces by face id, a face and its pair map to the same fvm face
+            Integer aMaxFaceId = -1;
+
+            for (Integer i = 0; i < nbMshFaces; ++i)
+                aMaxFaceId = std::max(aMaxFaceId, aMesh.faceId(i));
+
+            std::vector<CMshFace<Real>*> sMshFaces(aMaxFaceId + 1, nullptr);
+
+            for (Integer i = 0; i < nbMshFaces; ++i)
+                sMshFaces[aMesh.faceId(i)] = &aMesh.face(aMesh.faceId(i));
+
+            std::vector<Integer> sNewFaceIds(aMaxFaceId + 1, -1);
+
+            std::vector<CFvmFace<Real>*> sFaces;
+
+            sFaces.reserve(nbMshFaces);
 
             Integer aNewFaceId = 0;
 
             // MshFaces->FvmFaces
-            for (Integer i = 0; i < aMesh.nbFaces(); ++i)
+            for (Integer i = 0; i < nbMshFaces; ++i)
             {
 
-                if (faceAdded[aMesh.faceId(i)])
+                Integer aMshFaceId = aMesh.faceId(i);
+
+                if (sNewFaceIds[aMshFaceId] >= 0)
                     continue;
 
-                CMshFace<Real> aMshFace = aMesh.face(aMesh.faceId(i));
+                CMshFace<Real>& aMshFace = *sMshFaces[aMshFaceId];
 
                 CFvmFace<Real> aFvmFace;
 
                 for (Integer j = 0; j < aMshFace.nbNodeIds(); ++j)
-                {
-
-                    Integer aNodeId = aMshFace.nodeId(j);
-
-                    aFvmFace.addNode(CFvmNode<Real>(aMesh.node(aNodeId)));
-
-                }
+                    aFvmFace.addNode(sNodes[aMshFace.nodeId(j)]);
 
                 aFvmFace.setHasPair(aMshFace.hasPair());
 
                 aFvmFace.setControlVolumeId(aMshFace.elementId());
 
                 if (aMshFace.hasPair())
-                    aFvmFace.setNeighborId(aMesh.face(aMshFace.pairFaceId()).elementId());
+                    aFvmFace.setNeighborId(sMshFaces[aMshFace.pairFaceId()]->elementId());
 
                 aFvmFace.close();
 
-                this->addFace(aNewFaceId, aFvmFace);
+                // Ids increase so every insertion goes at the end of the maps
+                typename mapFace::iterator it = m_faces.insert(m_faces.end(), std::make_pair(aNewFaceId, aFvmFace));
+
+                m_faceIds.push_back(aNewFaceId);
+                m_faceIndices.insert(m_faceIndices.end(), std::make_pair(aNewFaceId, m_faceIndex++));
 
-                faceAdded[aMesh.faceId(i)] = true;
-                newFaceIds[aMesh.faceId(i)] = aNewFaceId;
+                sFaces.push_back(&it->second);
+
+                sNewFaceIds[aMshFaceId] = aNewFaceId;
 
                 if (aMshFace.hasPair())
-                {
-                    faceAdded[aMshFace.pairFaceId()] = true;
-                    newFaceIds[aMshFace.pairFaceId()] = aNewFaceId;
-                }
+                    sNewFaceIds[aMshFace.pairFaceId()] = aNewFaceId;
 
                 aNewFaceId++;
 
             }
 
-            // MshElements->FvmControlVolumes
-            for (Integer i = 0; i < aMesh.nbElements(); ++i)
+            // MshElements->FvmControlVolumes, the maps are filled first and the geometry built in parallel
+            std::vector<CMshElement<Real>*> sElements(nbElements);
+            std::vector<CFvmControlVolume<Real>*> sControlVolumes(nbElements);
+
+            m_controlVolumeIds.reserve(nbElements);
+
+            for (Integer i = 0; i < nbElements; ++i)
             {
 
                 Integer anElementId = aMesh.elementId(i);
 
-                CMshElement<Real> aMshElement = aMesh.element(anElementId);
+                typename mapControlVolume::iterator it = m_controlVolumes.insert(m_controlVolumes.end(), std::make_pair(anElementId, CFvmControlVolume<Real>()));
 
-                Integer aControlVolumeId = anElementId;
+                m_controlVolumeIds.push_back(anElementId);
+                m_controlVolumeIndices.insert(m_controlVolumeIndices.end(), std::make_pair(anElementId, m_controlVolumeIndex++));
 
-                CFvmControlVolume<Real> aControlVolume;
+                sElements[i] = &aMesh.element(anElementId);
+                sControlVolumes[i] = &it->second;
 
-                aControlVolume.setControlVolumeId(aMesh.elementId(i));
+            }
+
+            #pragma omp parallel for if (nbElements > 1000)
+            for (Integer i = 0; i < nbElements; ++i)
+            {
+
+                CMshElement<Real>& aMshElement = *sElements[i];
+
+                CFvmControlVolume<Real>& aControlVolume = *sControlVolumes[i];
+
+                Integer aControlVolumeId = m_controlVolumeIds[i];
+
+                aControlVolume.setControlVolumeId(aControlVolumeId);
 
                 for (Integer j = 0; j < aMshElement.nbFaceIds(); ++j)
                 {
 
-                    Integer aFaceId = newFaceIds[aMshElement.faceId(j)];
+                    Integer aFaceId = sNewFaceIds[aMshElement.faceId(j)];
 
-                    CFvmFace<Real> aFace = m_faces[aFaceId];
+                    CFvmFace<Real>& aFace = *sFaces[aFaceId];
 
-                    if (aFace.controlVolumeId() != aControlVolumeId)
-                    {
-                        // Invert
-                        aFace.polyline().invert();
-                    }
-
-                    aControlVolume.addFace(aFaceId, aFace);
+                    // The neighbor sees the face inverted
+                    aControlVolume.addFace(aFaceId, aFace, aFace.controlVolumeId() != aControlVolumeId);
 
                 }
 
-                this->addControlVolume(aControlVolumeId, aControlVolume);
-
             }
 
         }
@@ -147,9 +188,15 @@ namespace ENigMA
 
             m_faceIds.clear();
             m_faces.clear();
+            m_faceIndices.clear();
+            m_faceIndex = 0;
 
             m_controlVolumeIds.clear();
             m_controlVolumes.clear();
+            m_controlVolumeIndices.clear();
+            m_controlVolumeIndex = 0;
+
+            m_bFaceGeometry = false;
 
         }
 
@@ -205,6 +252,8 @@ namespace ENigMA
         void CFvmMesh<Real>::addFace(const Integer aFaceId, const CFvmFace<Real>& aFace)
         {
 
+            m_bFaceGeometry = false;
+
             m_faces[aFaceId] = aFace;
             m_faceIds.push_back(aFaceId);
 
@@ -225,6 +274,8 @@ namespace ENigMA
         void CFvmMesh<Real>::removeFace(const Integer aFaceId)
         {
 
+            m_bFaceGeometry = false;
+
             m_faces.erase(aFaceId);
 
             std::vector<Integer>::iterator it = std::find(m_faceIds.begin(), m_faceIds.end(), aFaceId);
@@ -238,6 +289,8 @@ namespace ENigMA
         void CFvmMesh<Real>::addControlVolume(const Integer aControlVolumeId, const CFvmControlVolume<Real>& aControlVolume)
         {
 
+            m_bFaceGeometry = false;
+
             m_controlVolumes[aControlVolumeId] = aControlVolume;
             m_controlVolumeIds.push_back(aControlVolumeId);
 
@@ -305,6 +358,317 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        void CFvmMesh<Real>::calculateFaceGeometry(bool bReCalculate)
+        {
+
+            if (m_bFaceGeometry && !bReCalculate)
+                return;
+
+            const Integer nbControlVolumes = this->nbControlVolumes();
+            const Integer nbFaces = this->nbFaces();
+
+            m_originalVolumes.resize(nbControlVolumes);
+
+            std::vector<CFvmControlVolume<Real>*> sControlVolumes(nbControlVolumes);
+
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+                sControlVolumes[i] = &m_controlVolumes[m_controlVolumeIds[i]];
+
+            // Each control volume only touches its own polygons
+            #pragma omp parallel for if (nbControlVolumes > 1000)
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+            {
+
+                CFvmControlVolume<Real>& aControlVolume = *sControlVolumes[i];
+
+                aControlVolume.calculateOriginalVolume();
+                aControlVolume.calculateCentroid();
+
+                for (Integer j = 0; j < aControlVolume.nbFaces(); ++j)
+                {
+
+                    Integer aFaceId = aControlVolume.faceId(j);
+
+                    aControlVolume.calculateFaceArea(aFaceId);
+                    aControlVolume.calculateFaceCentroid(aFaceId);
+
+                }
+
+                m_originalVolumes[i] = aControlVolume.originalVolume();
+
+            }
+
+            m_faceOwners.resize(nbFaces);
+            m_faceNeighbors.resize(nbFaces);
+            m_faceAreas.resize(nbFaces);
+            m_faceNormals.resize(nbFaces);
+            m_faceOwnerDists.resize(nbFaces);
+            m_faceNeighborDists.resize(nbFaces);
+            m_faceWeights.resize(nbFaces);
+
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+
+                Integer aFaceId = m_faceIds[i];
+
+                CFvmFace<Real>& aFace = m_faces[aFaceId];
+
+                Integer anOwnerId = aFace.controlVolumeId();
+
+                CFvmControlVolume<Real>& anOwner = m_controlVolumes[anOwnerId];
+
+                // Normals point out of the owner, the neighbor sees the same face inverted
+                m_faceOwners[i] = m_controlVolumeIndices[anOwnerId];
+                m_faceAreas[i] = anOwner.faceArea(aFaceId);
+                m_faceNormals[i] = anOwner.faceNormal(aFaceId);
+                m_faceOwnerDists[i] = anOwner.faceDist(aFaceId);
+
+                m_faceNeighbors[i] = -1;
+                m_faceNeighborDists[i] = 0.0;
+                m_faceWeights[i] = 1.0;
+
+                if (aFace.hasPair())
+                {
+
+                    Integer aNeighborId = aFace.neighborId(anOwnerId);
+
+                    typename mapControlVolume::iterator it = m_controlVolumes.find(aNeighborId);
+
+                    if (it != m_controlVolumes.end() && it->second.containsFace(aFaceId))
+                    {
+
+                        CFvmControlVolume<Real>& aNeighbor = it->second;
+
+                        m_faceNeighbors[i] = m_controlVolumeIndices[aNeighborId];
+
+                        m_faceAreas[i] += aNeighbor.faceArea(aFaceId); m_faceAreas[i] *= 0.5;
+                        m_faceNeighborDists[i] = aNeighbor.faceDist(aFaceId);
+
+                        Real dist = m_faceOwnerDists[i] + m_faceNeighborDists[i];
+
+                        if (dist > 0.0)
+                            m_faceWeights[i] = m_faceNeighborDists[i] / dist;
+                        else
+                            m_faceWeights[i] = 0.5;
+
+                    }
+
+                }
+
+            }
+
+            // Cell to face lists, faces are appended in index order so each list is sorted
+            m_controlVolumeFaceOffsets.assign(nbControlVolumes + 1, 0);
+
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+
+                m_controlVolumeFaceOffsets[m_faceOwners[i] + 1]++;
+
+                if (m_faceNeighbors[i] >= 0)
+                    m_controlVolumeFaceOffsets[m_faceNeighbors[i] + 1]++;
+
+            }
+
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+                m_controlVolumeFaceOffsets[i + 1] += m_controlVolumeFaceOffsets[i];
+
+            m_controlVolumeFaces.resize(m_controlVolumeFaceOffsets[nbControlVolumes]);
+
+            std::vector<Integer> sPositions(m_controlVolumeFaceOffsets.begin(), m_controlVolumeFaceOffsets.end() - 1);
+
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+
+                m_controlVolumeFaces[sPositions[m_faceOwners[i]]++] = i;
+
+                if (m_faceNeighbors[i] >= 0)
+                    m_controlVolumeFaces[sPositions[m_faceNeighbors[i]]++] = i;
+
+            }
+
+            m_bFaceGeometry = true;
+
+        }
+
+        template <typename Real>
+        bool CFvmMesh<Real>::hasFaceGeometry()
+        {
+
+            return m_bFaceGeometry;
+
+        }
+
+        template <typename Real>
+        void CFvmMesh<Real>::writeFaceGeometry(CFvmCheckpoint<Real>& aCheckpoint)
+        {
+
+            this->calculateFaceGeometry();
+
+            const Integer nbFaces = this->nbFaces();
+
+            std::vector<Real> sNormals(3 * nbFaces);
+
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+                sNormals[3 * i + 0] = m_faceNormals[i].x();
+                sNormals[3 * i + 1] = m_faceNormals[i].y();
+                sNormals[3 * i + 2] = m_faceNormals[i].z();
+            }
+
+            aCheckpoint.beginBlock("GEOMETRY");
+
+            aCheckpoint.write(this->nbControlVolumes());
+            aCheckpoint.write(nbFaces);
+
+            aCheckpoint.write(m_faceOwners);
+            aCheckpoint.write(m_faceNeighbors);
+            aCheckpoint.write(m_faceAreas);
+            aCheckpoint.write(sNormals);
+            aCheckpoint.write(m_faceOwnerDists);
+            aCheckpoint.write(m_faceNeighborDists);
+            aCheckpoint.write(m_faceWeights);
+
+            aCheckpoint.write(m_originalVolumes);
+
+            aCheckpoint.write(m_controlVolumeFaceOffsets);
+            aCheckpoint.write(m_controlVolumeFaces);
+
+            aCheckpoint.endBlock();
+
+        }
+
+        template <typename Real>
+        bool CFvmMesh<Real>::readFaceGeometry(CFvmCheckpoint<Real>& aCheckpoint)
+        {
+
+            if (!aCheckpoint.openBlock("GEOMETRY"))
+                return false;
+
+            Integer nbControlVolumes, nbFaces;
+
+            if (!aCheckpoint.read(nbControlVolumes) || !aCheckpoint.read(nbFaces))
+                return false;
+
+            // The block only applies to the mesh it was written from
+            if (nbControlVolumes != this->nbControlVolumes() || nbFaces != this->nbFaces())
+                return false;
+
+            std::vector<Real> sNormals;
+
+            bool bRead = aCheckpoint.read(m_faceOwners) &&
+                aCheckpoint.read(m_faceNeighbors) &&
+                aCheckpoint.read(m_faceAreas) &&
+                aCheckpoint.read(sNormals) &&
+                aCheckpoint.read(m_faceOwnerDists) &&
+                aCheckpoint.read(m_faceNeighborDists) &&
+                aCheckpoint.read(m_faceWeights) &&
+                aCheckpoint.read(m_originalVolumes) &&
+                aCheckpoint.read(m_controlVolumeFaceOffsets) &&
+                aCheckpoint.read(m_controlVolumeFaces);
+
+            if (!bRead || static_cast<Integer>(sNormals.size()) != 3 * nbFaces)
+            {
+                m_bFaceGeometry = false;
+                return false;
+            }
+
+            m_faceNormals.resize(nbFaces);
+
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+                m_faceNormals[i].x() = sNormals[3 * i + 0];
+                m_faceNormals[i].y() = sNormals[3 * i + 1];
+                m_faceNormals[i].z() = sNormals[3 * i + 2];
+            }
+
+            m_bFaceGeometry = true;
+
+            return true;
+
+        }
+
+        template <typename Real>
+        Integer CFvmMesh<Real>::faceOwner(const Integer aFaceIndex)
+        {
+
+            return m_faceOwners[aFaceIndex];
+
+        }
+
+        template <typename Real>
+        Integer CFvmMesh<Real>::faceNeighbor(const Integer aFaceIndex)
+        {
+
+            return m_faceNeighbors[aFaceIndex];
+
+        }
+
+        template <typename Real>
+        Real CFvmMesh<Real>::faceArea(const Integer aFaceIndex)
+        {
+
+            return m_faceAreas[aFaceIndex];
+
+        }
+
+        template <typename Real>
+        CGeoNormal<Real>& CFvmMesh<Real>::faceNormal(const Integer aFaceIndex)
+        {
+
+            return m_faceNormals[aFaceIndex];
+
+        }
+
+        template <typename Real>
+        Real CFvmMesh<Real>::faceOwnerDist(const Integer aFaceIndex)
+        {
+
+            return m_faceOwnerDists[aFaceIndex];
+
+        }
+
+        template <typename Real>
+        Real CFvmMesh<Real>::faceNeighborDist(const Integer aFaceIndex)
+        {
+
+            return m_faceNeighborDists[aFaceIndex];
+
+        }
+
+        template <typename Real>
+        Real CFvmMesh<Real>::faceWeight(const Integer aFaceIndex)
+        {
+
+            return m_faceWeights[aFaceIndex];
+
+        }
+
+        template <typename Real>
+        Real CFvmMesh<Real>::originalVolume(const Integer aControlVolumeIndex)
+        {
+
+            return m_originalVolumes[aControlVolumeIndex];
+
+        }
+
+        template <typename Real>
+        Integer CFvmMesh<Real>::nbControlVolumeFaces(const Integer aControlVolumeIndex)
+        {
+
+            return m_controlVolumeFaceOffsets[aControlVolumeIndex + 1] - m_controlVolumeFaceOffsets[aControlVolumeIndex];
+
+        }
+
+        template <typename Real>
+        Integer CFvmMesh<Real>::controlVolumeFace(const Integer aControlVolumeIndex, const Integer i)
+        {
+
+            return m_controlVolumeFaces[m_controlVolumeFaceOffsets[aControlVolumeIndex] + i];
+
+        }
+
     }
 
 }
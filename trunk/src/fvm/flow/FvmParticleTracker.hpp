@@ -0,0 +1,96 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include "FvmMesh.hpp"
+#include "FvmMeshSearch.hpp"
+#include "FvmPisoSolver.hpp"
+
+namespace ENigMA
+{
+
+    namespace fvm
+    {
+
+        // Lagrangian particles moved through the cell velocity of a flow solver. Each particle remembers its
+        // control volume and walks from face to face into the neighbours, the mesh search is only used to
+        // place new particles. Tracers follow the flow, inertial particles relax to it with Stokes drag.
+        template <typename Real>
+        class CFvmParticleTracker
+        {
+        private:
+
+            typedef std::vector<Real> varField;
+
+            CFvmMesh<Real>* m_fvmMesh;
+
+            CFvmMeshSearch<Real> m_meshSearch;
+
+            // Face tables by face index
+            varField m_faceX, m_faceY, m_faceZ;         // Face centroid
+            varField m_faceNx, m_faceNy, m_faceNz;      // Face normal pointing out of the owner
+            std::vector<Integer> m_faceOwners;
+            std::vector<Integer> m_faceNeighbors;
+            std::vector<bool> m_faceOpen;               // Boundary faces where particles leave the domain
+
+            varField m_u, m_v, m_w;                     // Cell velocity
+
+            Real m_gx, m_gy, m_gz;                      // Gravity, only felt by inertial particles
+
+            Real m_tolerance;
+            Integer m_maxCrossings;                     // Face crossings allowed per particle and step
+
+            // Particle state
+            varField m_x, m_y, m_z;
+            varField m_vx, m_vy, m_vz;
+            varField m_relaxationTime;                  // Stokes relaxation time (0 = tracer)
+            varField m_residenceTime;
+            std::vector<Integer> m_controlVolumes;      // Control volume index (-1 once the particle left)
+
+            void move(const Integer i, const Real dt);
+
+        public:
+
+            CFvmParticleTracker();
+            CFvmParticleTracker(CFvmMesh<Real>& aFvmMesh);
+            ~CFvmParticleTracker();
+
+            void set(CFvmMesh<Real>& aFvmMesh);
+
+            void setBoundaryType(const std::vector<Integer>& sFaceIds, EBoundaryType sFaceType);
+            void setGravity(const Real gx, const Real gy, const Real gz);
+            void setTolerance(const Real aTolerance);
+
+            void setVelocity(const Integer aControlVolumeId, const Real u, const Real v, const Real w);
+            void setVelocityField(CFvmPisoSolver<Real>& aPisoSolver);
+
+            Integer addParticle(CGeoCoordinate<Real>& aPosition, const Real aRelaxationTime = 0.0);
+            void clearParticles();
+
+            void advance(const Real dt);
+
+            Integer nbParticles();
+            Integer nbActiveParticles();
+
+            bool isActive(const Integer aParticleIndex);
+            CGeoCoordinate<Real> position(const Integer aParticleIndex);
+            CGeoVector<Real> velocity(const Integer aParticleIndex);
+            Integer controlVolumeId(const Integer aParticleIndex);
+            Real residenceTime(const Integer aParticleIndex);
+
+        };
+
+    }
+
+}
+
+#include "FvmParticleTracker_Imp.hpp"
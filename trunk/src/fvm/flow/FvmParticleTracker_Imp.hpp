@@ -0,0 +1,419 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <cmath>
+
+namespace ENigMA
+{
+
+    namespace fvm
+    {
+
+        template <typename Real>
+        CFvmParticleTracker<Real>::CFvmParticleTracker() :
+            m_fvmMesh(nullptr),
+            m_gx(0.0), m_gy(0.0), m_gz(0.0),
+            m_tolerance(1E-9),
+            m_maxCrossings(1000)
+        {
+
+        }
+
+        template <typename Real>
+        CFvmParticleTracker<Real>::CFvmParticleTracker(CFvmMesh<Real>& aFvmMesh) :
+            m_gx(0.0), m_gy(0.0), m_gz(0.0),
+            m_tolerance(1E-9),
+            m_maxCrossings(1000)
+        {
+
+            this->set(aFvmMesh);
+
+        }
+
+        template <typename Real>
+        CFvmParticleTracker<Real>::~CFvmParticleTracker()
+        {
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::set(CFvmMesh<Real>& aFvmMesh)
+        {
+
+            m_fvmMesh = &aFvmMesh;
+
+            m_meshSearch.set(aFvmMesh);
+            m_meshSearch.build();
+
+            const Integer nbControlVolumes = m_fvmMesh->nbControlVolumes();
+            const Integer nbFaces = m_fvmMesh->nbFaces();
+
+            m_faceX.resize(nbFaces);
+            m_faceY.resize(nbFaces);
+            m_faceZ.resize(nbFaces);
+
+            m_faceNx.resize(nbFaces);
+            m_faceNy.resize(nbFaces);
+            m_faceNz.resize(nbFaces);
+
+            m_faceOwners.resize(nbFaces);
+            m_faceNeighbors.resize(nbFaces);
+
+            m_faceOpen.assign(nbFaces, false);
+
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+
+                CFvmFace<Real>& aFace = m_fvmMesh->face(m_fvmMesh->faceId(i));
+
+                m_faceX[i] = aFace.centroid().x();
+                m_faceY[i] = aFace.centroid().y();
+                m_faceZ[i] = aFace.centroid().z();
+
+                m_faceNx[i] = m_fvmMesh->faceNormal(i).x();
+                m_faceNy[i] = m_fvmMesh->faceNormal(i).y();
+                m_faceNz[i] = m_fvmMesh->faceNormal(i).z();
+
+                m_faceOwners[i] = m_fvmMesh->faceOwner(i);
+                m_faceNeighbors[i] = m_fvmMesh->faceNeighbor(i);
+
+            }
+
+            m_u.assign(nbControlVolumes, 0.0);
+            m_v.assign(nbControlVolumes, 0.0);
+            m_w.assign(nbControlVolumes, 0.0);
+
+            this->clearParticles();
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::setBoundaryType(const std::vector<Integer>& sFaceIds, EBoundaryType sFaceType)
+        {
+
+            // Particles leave through inlets and outlets, every other boundary reflects them
+            for (Integer i = 0; i < static_cast<Integer>(sFaceIds.size()); ++i)
+                m_faceOpen[m_fvmMesh->faceIndex(sFaceIds[i])] = (sFaceType == BT_OUTLET || sFaceType == BT_INLET_FLOW || sFaceType == BT_INLET_PRESSURE);
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::setGravity(const Real gx, const Real gy, const Real gz)
+        {
+
+            m_gx = gx;
+            m_gy = gy;
+            m_gz = gz;
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::setTolerance(const Real aTolerance)
+        {
+
+            m_tolerance = aTolerance;
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::setVelocity(const Integer aControlVolumeId, const Real u, const Real v, const Real w)
+        {
+
+            const Integer anIndex = m_fvmMesh->controlVolumeIndex(aControlVolumeId);
+
+            m_u[anIndex] = u;
+            m_v[anIndex] = v;
+            m_w[anIndex] = w;
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::setVelocityField(CFvmPisoSolver<Real>& aPisoSolver)
+        {
+
+            for (Integer i = 0; i < m_fvmMesh->nbControlVolumes(); ++i)
+            {
+
+                Integer aControlVolumeId = m_fvmMesh->controlVolumeId(i);
+
+                m_u[i] = aPisoSolver.u(aControlVolumeId);
+                m_v[i] = aPisoSolver.v(aControlVolumeId);
+                m_w[i] = aPisoSolver.w(aControlVolumeId);
+
+            }
+
+        }
+
+        template <typename Real>
+        Integer CFvmParticleTracker<Real>::addParticle(CGeoCoordinate<Real>& aPosition, const Real aRelaxationTime)
+        {
+
+            Integer aControlVolumeId;
+
+            if (!m_meshSearch.findControlVolume(aPosition, aControlVolumeId, m_tolerance))
+                return -1;
+
+            const Integer anIndex = m_fvmMesh->controlVolumeIndex(aControlVolumeId);
+
+            m_x.push_back(aPosition.x());
+            m_y.push_back(aPosition.y());
+            m_z.push_back(aPosition.z());
+
+            m_vx.push_back(m_u[anIndex]);
+            m_vy.push_back(m_v[anIndex]);
+            m_vz.push_back(m_w[anIndex]);
+
+            m_relaxationTime.push_back(aRelaxationTime);
+            m_residenceTime.push_back(0.0);
+
+            m_controlVolumes.push_back(anIndex);
+
+            return static_cast<Integer>(m_controlVolumes.size()) - 1;
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::clearParticles()
+        {
+
+            m_x.clear();
+            m_y.clear();
+            m_z.clear();
+
+            m_vx.clear();
+            m_vy.clear();
+            m_vz.clear();
+
+            m_relaxationTime.clear();
+            m_residenceTime.clear();
+
+            m_controlVolumes.clear();
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::move(const Integer i, const Real dt)
+        {
+
+            Integer c = m_controlVolumes[i];
+
+            if (c < 0)
+                return;
+
+            Real x = m_x[i];
+            Real y = m_y[i];
+            Real z = m_z[i];
+
+            Real vx, vy, vz;
+
+            const Real tau = m_relaxationTime[i];
+
+            if (tau > 0.0)
+            {
+
+                // Exact Stokes drag relaxation over the step towards the flow in the starting cell
+                Real f = std::exp(-dt / tau);
+
+                vx = m_u[c] + (m_vx[i] - m_u[c]) * f + m_gx * tau * (1.0 - f);
+                vy = m_v[c] + (m_vy[i] - m_v[c]) * f + m_gy * tau * (1.0 - f);
+                vz = m_w[c] + (m_vz[i] - m_w[c]) * f + m_gz * tau * (1.0 - f);
+
+            }
+            else
+            {
+
+                vx = m_u[c];
+                vy = m_v[c];
+                vz = m_w[c];
+
+            }
+
+            Real t = dt;
+
+            for (Integer n = 0; n < m_maxCrossings && t > 0.0; ++n)
+            {
+
+                Real dx = vx * t;
+                Real dy = vy * t;
+                Real dz = vz * t;
+
+                // Earliest face the displacement crosses, as a fraction of the remaining step
+                Real lambda = 1.0;
+                Integer aFaceIndex = -1;
+
+                for (Integer j = 0; j < m_fvmMesh->nbControlVolumeFaces(c); ++j)
+                {
+
+                    Integer f = m_fvmMesh->controlVolumeFace(c, j);
+
+                    Real sign = (m_faceOwners[f] == c) ? 1.0 : -1.0;
+
+                    Real nx = sign * m_faceNx[f];
+                    Real ny = sign * m_faceNy[f];
+                    Real nz = sign * m_faceNz[f];
+
+                    Real denom = nx * dx + ny * dy + nz * dz;
+
+                    if (denom <= 0.0)
+                        continue;
+
+                    Real l = (nx * (m_faceX[f] - x) + ny * (m_faceY[f] - y) + nz * (m_faceZ[f] - z)) / denom;
+
+                    if (l < 0.0)
+                        l = 0.0;
+
+                    if (l < lambda)
+                    {
+                        lambda = l;
+                        aFaceIndex = f;
+                    }
+
+                }
+
+                x += lambda * dx;
+                y += lambda * dy;
+                z += lambda * dz;
+
+                t *= (1.0 - lambda);
+
+                if (aFaceIndex < 0)
+                    break;
+
+                Integer aNeighbor = (m_faceOwners[aFaceIndex] == c) ? m_faceNeighbors[aFaceIndex] : m_faceOwners[aFaceIndex];
+
+                if (aNeighbor >= 0)
+                {
+
+                    c = aNeighbor;
+
+                    if (tau <= 0.0)
+                    {
+                        vx = m_u[c];
+                        vy = m_v[c];
+                        vz = m_w[c];
+                    }
+
+                    continue;
+
+                }
+
+                if (m_faceOpen[aFaceIndex])
+                {
+                    c = -1;
+                    break;
+                }
+
+                // Wall: inertial particles bounce, tracers slide along it for the rest of the step
+                Real vn = (tau > 0.0 ? 2.0 : 1.0) * (vx * m_faceNx[aFaceIndex] + vy * m_faceNy[aFaceIndex] + vz * m_faceNz[aFaceIndex]);
+
+                vx -= vn * m_faceNx[aFaceIndex];
+                vy -= vn * m_faceNy[aFaceIndex];
+                vz -= vn * m_faceNz[aFaceIndex];
+
+            }
+
+            m_x[i] = x;
+            m_y[i] = y;
+            m_z[i] = z;
+
+            m_vx[i] = vx;
+            m_vy[i] = vy;
+            m_vz[i] = vz;
+
+            m_residenceTime[i] += (c >= 0) ? dt : dt - t;
+
+            m_controlVolumes[i] = c;
+
+        }
+
+        template <typename Real>
+        void CFvmParticleTracker<Real>::advance(const Real dt)
+        {
+
+            const Integer nbParticles = static_cast<Integer>(m_controlVolumes.size());
+
+            // Particles only touch their own state
+            #pragma omp parallel for schedule(dynamic, 1024) if (nbParticles > 1000)
+            for (Integer i = 0; i < nbParticles; ++i)
+                this->move(i, dt);
+
+        }
+
+        template <typename Real>
+        Integer CFvmParticleTracker<Real>::nbParticles()
+        {
+
+            return static_cast<Integer>(m_controlVolumes.size());
+
+        }
+
+        template <typename Real>
+        Integer CFvmParticleTracker<Real>::nbActiveParticles()
+        {
+
+            Integer nbActive = 0;
+
+            for (Integer i = 0; i < static_cast<Integer>(m_controlVolumes.size()); ++i)
+            {
+                if (m_controlVolumes[i] >= 0)
+                    nbActive++;
+            }
+
+            return nbActive;
+
+        }
+
+        template <typename Real>
+        bool CFvmParticleTracker<Real>::isActive(const Integer aParticleIndex)
+        {
+
+            return m_controlVolumes[aParticleIndex] >= 0;
+
+        }
+
+        template <typename Real>
+        CGeoCoordinate<Real> CFvmParticleTracker<Real>::position(const Integer aParticleIndex)
+        {
+
+            return CGeoCoordinate<Real>(m_x[aParticleIndex], m_y[aParticleIndex], m_z[aParticleIndex]);
+
+        }
+
+        template <typename Real>
+        CGeoVector<Real> CFvmParticleTracker<Real>::velocity(const Integer aParticleIndex)
+        {
+
+            return CGeoVector<Real>(m_vx[aParticleIndex], m_vy[aParticleIndex], m_vz[aParticleIndex]);
+
+        }
+
+        template <typename Real>
+        Integer CFvmParticleTracker<Real>::controlVolumeId(const Integer aParticleIndex)
+        {
+
+            if (m_controlVolumes[aParticleIndex] < 0)
+                return -1;
+
+            return m_fvmMesh->controlVolumeId(m_controlVolumes[aParticleIndex]);
+
+        }
+
+        template <typename Real>
+        Real CFvmParticleTracker<Real>::residenceTime(const Integer aParticleIndex)
+        {
+
+            return m_residenceTime[aParticleIndex];
+
+        }
+
+    }
+
+}
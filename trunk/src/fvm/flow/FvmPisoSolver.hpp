@@ -9,12 +9,15 @@
 
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <future>
+#include <string>
 #include <vector>
 
 #include "GeoHashGrid.hpp"
 
 #include "FvmMesh.hpp"
+#include "SleSolver.hpp"
 
 namespace ENigMA
 {
@@ -27,46 +30,71 @@ namespace ENigMA
         {
         protected:
 
-            typedef std::map<Integer, Real> varMap;
-            typedef std::map<Integer, CGeoVector<Real> > vecMap;
+            typedef std::vector<Real> varField;
+            typedef std::vector<CGeoVector<Real> > vecField;
 
-            std::map<Integer, Integer> m_mapIdToIndex;
-            std::map<Integer, Integer> m_mapIndexToId;
+            std::vector<Integer> m_controlVolumeIndices;    // Control volume id to dense index (-1 if unused)
+            std::vector<Integer> m_faceIndices;             // Face id to dense index (-1 if unused)
+
+            std::vector<CFvmBoundaryType> m_faceBoundaryTypes;  // Boundary type by face index, read by the threaded face loops
 
             bool m_calcu, m_calcv, m_calcw;
             bool m_calcp;
 
             Real m_dt;
 
+            Real m_time;                // Time reached by the adaptive steps
+            Real m_dtInit, m_dtMin, m_dtMax;
+            Real m_maxCourant;          // Target Courant number of the adaptive steps
+            Real m_maxDiffusion;        // Target viscous diffusion number of the adaptive steps (0 = no limit)
+            Real m_maxGrowth;           // Largest ratio between consecutive adaptive steps
+
+            std::vector<Real> m_timeIntervals;  // Adaptive step history
+
             Real m_gx, m_gy, m_gz;      // Gravity
 
-            varMap m_dens;              // Cell density
-            varMap m_visc;              // Cell viscosity
+            varField m_dens;            // Cell density
+            varField m_visc;            // Cell viscosity
 
-            varMap m_flux;              // Face flux
+            varField m_flux;            // Face flux
 
-            varMap m_u0, m_v0, m_w0;    // Cell center velocity - previous time step
-            varMap m_u, m_v, m_w;       // Cell center velocity
-            varMap m_uf, m_vf, m_wf;    // Face center velocity
+            varField m_u0, m_v0, m_w0;  // Cell center velocity - previous time step
+            varField m_u, m_v, m_w;     // Cell center velocity
+            varField m_uf, m_vf, m_wf;  // Face center velocity
 
-            varMap m_p0;                // Cell center pressure - previous time step
-            varMap m_p;                 // Cell center pressure
-            varMap m_pf;                // Face center pressure
+            varField m_p0;              // Cell center pressure - previous time step
+            varField m_p;               // Cell center pressure
+            varField m_pf;              // Face center pressure
 
-            varMap m_ap;
-            varMap m_bu, m_bv, m_bw;
-            varMap m_Hu, m_Hv, m_Hw;
+            varField m_ap;
+            varField m_bu, m_bv, m_bw;
+            varField m_Hu, m_Hv, m_Hw;
 
-            varMap m_massError;         // Mas error
+            varField m_massError;       // Mas error
 
             CFvmMesh<Real> m_fvmMesh;
 
-            CGeoVector<Real> gradient(varMap& var, varMap& varf, const Integer aControlVolumeId);
+            ENigMA::sle::CSleSolver<Real> m_momentumSolver;
+            ENigMA::sle::CSleSolver<Real> m_pressureSolver;
+
+            CFvmCheckpoint<Real> m_checkpoint;          // Snapshot being written, untouched until the write ends
+            std::future<bool> m_checkpointWriter;       // Pending asynchronous write
+
+            CGeoVector<Real> gradient(const varField& var, const varField& varf, const Integer anIndexP);
+            void gradient(const varField& var, const varField& varf, vecField& grad);
+
+            void setFaceBoundaryType(const Integer aFaceId, const EBoundaryType aFaceType);
 
             virtual void setTimeInterval(const Real dt);
+
+            Real adjustTimeInterval(const Real dt, const Real aCourant, const Real aMaxCourant);
+            virtual Real calculateTimeInterval();
             
             virtual void storePreviousQuantities();
 
+            void assembleVelocityField(Eigen::SparseMatrix<Real>& A, Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& b, const vecField& gradp);
+            void calculateVelocityCoefficients(Eigen::SparseMatrix<Real>& A, Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& b, Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& x, const vecField& gradp);
+
             virtual void calculateVelocityField();
             virtual void calculatePressureField();
 
@@ -74,7 +102,8 @@ namespace ENigMA
             virtual void correctVelocityField();
             virtual void correctPressureField();
 
-            Real checkMassConservationCell(const Integer aControlVolumeId);
+            virtual void writeState(CFvmCheckpoint<Real>& aCheckpoint);
+            virtual bool readState(CFvmCheckpoint<Real>& aCheckpoint);
 
         public:
 
@@ -88,7 +117,23 @@ namespace ENigMA
             void setBoundaryVelocity(const std::vector<Integer>& sFaceIds, EBoundaryType sFaceType, const Real u, const Real v, const Real w);
             void setBoundaryPressure(const std::vector<Integer>& sFaceIds, EBoundaryType sFaceType, const Real p);
 
+            ENigMA::sle::CSleSolver<Real>& momentumSolver();
+            ENigMA::sle::CSleSolver<Real>& pressureSolver();
+
             virtual void iterate(const Real dt, const bool bInit = false);
+
+            void setTimeControl(const Real dtInit, const Real aMaxCourant, const Real aMaxDiffusion, const Real dtMin, const Real dtMax, const Real aMaxGrowth = 1.2);
+            Real iterateAdaptive(const bool bInit = false);
+            Real courant(const Real dt);
+            Real diffusion(const Real dt);
+            Real time();
+            std::vector<Real>& timeIntervals();
+
+            bool saveCheckpoint(const std::string strFileName, const bool bAsync = false);
+            bool waitCheckpoint();
+            bool loadCheckpoint(const std::string strFileName);
+            bool loadCheckpoint(CFvmCheckpoint<Real>& aCheckpoint);
+
             virtual void checkMassConservation(Real& aMassError);
             virtual void residual(Real& ru, Real& rv, Real& rw, Real& rp);
 
@@ -25,109 +25,191 @@ namespace ENigMA
 
             m_dt = 1.0;
 
+            m_time = 0.0;
+
+            m_dtInit = 1E-3;
+            m_dtMin = 0.0;
+            m_dtMax = std::numeric_limits<Real>::max();
+
+            m_maxCourant = 0.5;
+            m_maxDiffusion = 1.0;
+            m_maxGrowth = 1.2;
+
             m_gx = 0.0;
             m_gy = 0.0;
             m_gz = 0.0;
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            const Integer nbControlVolumes = m_fvmMesh.nbControlVolumes();
+            const Integer nbFaces = m_fvmMesh.nbFaces();
+
+            Integer aMaxControlVolumeId = -1;
+
+            // A mesh with cached face geometry (e.g. read from a checkpoint) is not measured again
+            const bool bFaceGeometry = m_fvmMesh.hasFaceGeometry();
+
+            for (Integer i = 0; i < nbControlVolumes; ++i)
             {
 
                 Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
 
-                m_fvmMesh.controlVolume(aControlVolumeId).calculateVolume();
-                m_fvmMesh.controlVolume(aControlVolumeId).calculateOriginalVolume();
-                m_fvmMesh.controlVolume(aControlVolumeId).calculateCentroid();
+                if (!bFaceGeometry)
+                    m_fvmMesh.controlVolume(aControlVolumeId).calculateVolume();
 
-                for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
-                {
+                aMaxControlVolumeId = std::max(aMaxControlVolumeId, aControlVolumeId);
 
-                    Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+            }
 
-                    m_fvmMesh.controlVolume(aControlVolumeId).calculateFaceArea(aFaceId);
-                    m_fvmMesh.controlVolume(aControlVolumeId).calculateFaceCentroid(aFaceId);
+            Integer aMaxFaceId = -1;
 
-                }
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
 
-                m_u0[aControlVolumeId] = m_u[aControlVolumeId] = 0.0;
-                m_v0[aControlVolumeId] = m_v[aControlVolumeId] = 0.0;
-                m_w0[aControlVolumeId] = m_w[aControlVolumeId] = 0.0;
+                Integer aFaceId = m_fvmMesh.faceId(i);
 
-                m_p0[aControlVolumeId] = m_p[aControlVolumeId] = 0.0;
+                if (!bFaceGeometry)
+                {
+                    m_fvmMesh.face(aFaceId).calculateArea();
+                    m_fvmMesh.face(aFaceId).calculateNormal();
+                }
 
-                m_mapIdToIndex[aControlVolumeId] = i;
-                m_mapIndexToId[i] = aControlVolumeId;
+                aMaxFaceId = std::max(aMaxFaceId, aFaceId);
 
             }
 
-            for (Integer i = 0; i < m_fvmMesh.nbFaces(); ++i)
-            {
+            // Owner/neighbor face list with areas, normals and distances, the solver loops run over it
+            m_fvmMesh.calculateFaceGeometry();
 
-                Integer aFaceId = m_fvmMesh.faceId(i);
+            // Ids are translated to dense indices here once, all fields below are indexed by control volume or face index
+            m_controlVolumeIndices.assign(aMaxControlVolumeId + 1, -1);
 
-                m_fvmMesh.face(aFaceId).calculateArea();
-                m_fvmMesh.face(aFaceId).calculateNormal();
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+                m_controlVolumeIndices[m_fvmMesh.controlVolumeId(i)] = i;
 
-                m_flux[aFaceId] = 0.0;
+            m_faceIndices.assign(aMaxFaceId + 1, -1);
 
-                m_uf[aFaceId] = 0.0;
-                m_vf[aFaceId] = 0.0;
-                m_wf[aFaceId] = 0.0;
+            for (Integer i = 0; i < nbFaces; ++i)
+                m_faceIndices[m_fvmMesh.faceId(i)] = i;
 
-                m_pf[aFaceId] = 0.0;
+            m_faceBoundaryTypes.resize(nbFaces);
 
-            }
+            for (Integer i = 0; i < nbFaces; ++i)
+                m_faceBoundaryTypes[i] = m_fvmMesh.face(m_fvmMesh.faceId(i)).boundaryType();
+
+            m_dens.assign(nbControlVolumes, 0.0);
+            m_visc.assign(nbControlVolumes, 0.0);
+
+            m_u0.assign(nbControlVolumes, 0.0);
+            m_v0.assign(nbControlVolumes, 0.0);
+            m_w0.assign(nbControlVolumes, 0.0);
+
+            m_u.assign(nbControlVolumes, 0.0);
+            m_v.assign(nbControlVolumes, 0.0);
+            m_w.assign(nbControlVolumes, 0.0);
+
+            m_p0.assign(nbControlVolumes, 0.0);
+            m_p.assign(nbControlVolumes, 0.0);
+
+            m_ap.assign(nbControlVolumes, 0.0);
+
+            m_bu.assign(nbControlVolumes, 0.0);
+            m_bv.assign(nbControlVolumes, 0.0);
+            m_bw.assign(nbControlVolumes, 0.0);
+
+            m_Hu.assign(nbControlVolumes, 0.0);
+            m_Hv.assign(nbControlVolumes, 0.0);
+            m_Hw.assign(nbControlVolumes, 0.0);
+
+            m_massError.assign(nbControlVolumes, 0.0);
+
+            m_flux.assign(nbFaces, 0.0);
+
+            m_uf.assign(nbFaces, 0.0);
+            m_vf.assign(nbFaces, 0.0);
+            m_wf.assign(nbFaces, 0.0);
+
+            m_pf.assign(nbFaces, 0.0);
 
             m_calcu = m_calcv = m_calcw = false;
             m_calcp = false;
 
+            // The pressure matrix pattern never changes so the multigrid hierarchy is kept between iterations
+            m_pressureSolver.setPreconditioner(ENigMA::sle::PT_ALGEBRAIC_MULTIGRID);
+            m_pressureSolver.setTolerance(1E-12);
+
         }
 
         template <typename Real>
         CFvmPisoSolver<Real>::~CFvmPisoSolver()
         {
 
+            this->waitCheckpoint();
+
         }
 
         template <typename Real>
-        CGeoVector<Real> CFvmPisoSolver<Real>::gradient(varMap& var, varMap& varf, const Integer aControlVolumeId)
+        CGeoVector<Real> CFvmPisoSolver<Real>::gradient(const varField& var, const varField& varf, const Integer anIndexP)
         {
 
-            CGeoVector<Real> aVector(0.0, 0.0, 0.0);
+            CGeoVector<Real> aGradient(0.0, 0.0, 0.0);
 
-            for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
+            // The faces are gathered in face order, so the sums match a serial face loop bit for bit
+            for (Integer j = 0; j < m_fvmMesh.nbControlVolumeFaces(anIndexP); ++j)
             {
 
-                Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+                Integer i = m_fvmMesh.controlVolumeFace(anIndexP, j);
+
+                Integer anIndexO = m_fvmMesh.faceOwner(i);
+                Integer anIndexN = m_fvmMesh.faceNeighbor(i);
 
-                Real v = 0;
-                CGeoNormal<Real>& aNormal = m_fvmMesh.controlVolume(aControlVolumeId).faceNormal(aFaceId);
-                Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
+                CGeoVector<Real> aVector = m_fvmMesh.faceNormal(i) * m_fvmMesh.faceArea(i);
 
-                if (m_fvmMesh.face(aFaceId).hasPair())
+                if (anIndexN >= 0)
                 {
 
-                    Integer aNeighborId = m_fvmMesh.face(aFaceId).neighborId(aControlVolumeId);
+                    Real v = var[anIndexO] + var[anIndexN]; v *= 0.5;
 
-                    v = var[aControlVolumeId] + var[aNeighborId]; v *= 0.5;
-                    aVector += v * aNormal * area;
+                    if (anIndexO == anIndexP)
+                        aGradient += v * aVector;
+                    else
+                        aGradient -= v * aVector;
 
                 }
                 else
-                {
-
-                    v = varf[aFaceId];
-                    aVector += v * aNormal * area;
-
-                }
+                    aGradient += varf[i] * aVector;
 
             }
 
-            Real aVolume = m_fvmMesh.controlVolume(aControlVolumeId).originalVolume();
+            Real aVolume = m_fvmMesh.originalVolume(anIndexP);
 
             if (aVolume > 0.0)
-                aVector /= aVolume;
+                aGradient /= aVolume;
+
+            return aGradient;
+
+        }
+
+        template <typename Real>
+        void CFvmPisoSolver<Real>::gradient(const varField& var, const varField& varf, vecField& grad)
+        {
+
+            const Integer nbControlVolumes = m_fvmMesh.nbControlVolumes();
+
+            grad.resize(nbControlVolumes);
 
-            return aVector;
+            // Each control volume gathers its own faces
+            #pragma omp parallel for if (nbControlVolumes > 1000)
+            for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
+                grad[anIndexP] = this->gradient(var, varf, anIndexP);
+
+        }
+
+        template <typename Real>
+        void CFvmPisoSolver<Real>::setFaceBoundaryType(const Integer aFaceId, const EBoundaryType aFaceType)
+        {
+
+            m_fvmMesh.face(aFaceId).setBoundaryType(aFaceType);
+
+            m_faceBoundaryTypes[m_faceIndices[aFaceId]] = aFaceType;
 
         }
 
@@ -139,6 +221,34 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        Real CFvmPisoSolver<Real>::adjustTimeInterval(const Real dt, const Real aCourant, const Real aMaxCourant)
+        {
+
+            // Shrink at once when the target is exceeded, grow smoothly otherwise
+            if (aCourant <= 0.0)
+                return dt * m_maxGrowth;
+
+            Real aFactor = aMaxCourant / aCourant;
+
+            return dt * std::min(std::min(aFactor, 1.0 + 0.1 * aFactor), m_maxGrowth);
+
+        }
+
+        template <typename Real>
+        Real CFvmPisoSolver<Real>::calculateTimeInterval()
+        {
+
+            Real dt = this->adjustTimeInterval(m_dt, this->courant(m_dt), m_maxCourant);
+
+            // The segregated step becomes unstable for large viscous diffusion numbers
+            if (m_maxDiffusion > 0.0)
+                dt = std::min(dt, this->adjustTimeInterval(m_dt, this->diffusion(m_dt), m_maxDiffusion));
+
+            return dt;
+
+        }
+
         template <typename Real>
         void CFvmPisoSolver<Real>::storePreviousQuantities()
         {
@@ -165,15 +275,8 @@ namespace ENigMA
         void CFvmPisoSolver<Real>::setMaterialProperties(const Real aDensity, const Real aViscosity)
         {
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
-            {
-
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
-
-                m_dens[aControlVolumeId] = aDensity;
-                m_visc[aControlVolumeId] = aViscosity;
-
-            }
+            std::fill(m_dens.begin(), m_dens.end(), aDensity);
+            std::fill(m_visc.begin(), m_visc.end(), aViscosity);
 
         }
 
@@ -185,12 +288,13 @@ namespace ENigMA
             {
 
                 Integer aFaceId = sFaceIds[i];
+                Integer aFaceIndex = m_faceIndices[aFaceId];
 
-                m_uf[aFaceId] = u;
-                m_vf[aFaceId] = v;
-                m_wf[aFaceId] = w;
+                m_uf[aFaceIndex] = u;
+                m_vf[aFaceIndex] = v;
+                m_wf[aFaceIndex] = w;
 
-                m_fvmMesh.face(aFaceId).setBoundaryType(sFaceType);
+                this->setFaceBoundaryType(aFaceId, sFaceType);
 
             }
 
@@ -205,176 +309,183 @@ namespace ENigMA
 
                 Integer aFaceId = sFaceIds[i];
 
-                m_pf[aFaceId] = p;
+                m_pf[m_faceIndices[aFaceId]] = p;
 
-                m_fvmMesh.face(aFaceId).setBoundaryType(sFaceType);
+                this->setFaceBoundaryType(aFaceId, sFaceType);
 
             }
 
         }
 
         template <typename Real>
-        void CFvmPisoSolver<Real>::calculateVelocityField()
+        ENigMA::sle::CSleSolver<Real>& CFvmPisoSolver<Real>::momentumSolver()
         {
 
-            Eigen::SparseMatrix<Real> A;
-            Eigen::Matrix<Real, Eigen::Dynamic, 1> bu, bv, bw;
+            return m_momentumSolver;
 
-            A.resize(m_fvmMesh.nbControlVolumes(), m_fvmMesh.nbControlVolumes());
-            A.reserve(m_fvmMesh.nbControlVolumes());
+        }
 
-            bu.resize(m_fvmMesh.nbControlVolumes());
-            bu.setZero();
+        template <typename Real>
+        ENigMA::sle::CSleSolver<Real>& CFvmPisoSolver<Real>::pressureSolver()
+        {
 
-            bv.resize(m_fvmMesh.nbControlVolumes());
-            bv.setZero();
+            return m_pressureSolver;
 
-            bw.resize(m_fvmMesh.nbControlVolumes());
-            bw.setZero();
+        }
 
-            // Assemble momentum matrix
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
-            {
+        template <typename Real>
+        void CFvmPisoSolver<Real>::assembleVelocityField(Eigen::SparseMatrix<Real>& A, Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& b, const vecField& gradp)
+        {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+            const Integer nbControlVolumes = m_fvmMesh.nbControlVolumes();
 
-                Integer anIndexP = m_mapIdToIndex[aControlVolumeId];
+            std::vector<Eigen::Triplet<Real> > sCoefficients;
+            sCoefficients.reserve(nbControlVolumes + 4 * m_fvmMesh.nbFaces());
 
-                Real volume = m_fvmMesh.controlVolume(aControlVolumeId).originalVolume();
+            A.resize(nbControlVolumes, nbControlVolumes);
 
-                if (volume <= 0.0)
-                {
-                    std::cout << "Warning: element " << aControlVolumeId << " has volume = 0!" << std::endl;
-                    continue;
-                }
+            // The u, v and w components share the matrix and are solved as one block
+            b.resize(nbControlVolumes, 3);
+            b.setZero();
 
-                for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
-                {
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+            {
 
-                    Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+                if (m_fvmMesh.originalVolume(i) <= 0.0)
+                    std::cout << "Warning: element " << m_fvmMesh.controlVolumeId(i) << " has volume = 0!" << std::endl;
 
-                    Real dens = m_dens[aControlVolumeId];
-                    Real visc = m_visc[aControlVolumeId];
+            }
 
-                    CGeoNormal<Real>& aNormal = m_fvmMesh.controlVolume(aControlVolumeId).faceNormal(aFaceId);
+            // Assemble momentum matrix - face contributions
+            for (Integer i = 0; i < m_fvmMesh.nbFaces(); ++i)
+            {
 
-                    Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
-                    Real dist = m_fvmMesh.controlVolume(aControlVolumeId).faceDist(aFaceId);
+                Integer anIndexO = m_fvmMesh.faceOwner(i);
+                Integer anIndexN = m_fvmMesh.faceNeighbor(i);
 
-                    Real flux;
+                Real volumeO = m_fvmMesh.originalVolume(anIndexO);
 
-                    if (m_fvmMesh.face(aFaceId).controlVolumeId() == aControlVolumeId)
-                        flux = +m_flux[aFaceId];
-                    else
-                        flux = -m_flux[aFaceId];
+                CGeoNormal<Real>& aNormal = m_fvmMesh.faceNormal(i);
 
-                    if (m_fvmMesh.face(aFaceId).hasPair())
-                    {
+                Real area = m_fvmMesh.faceArea(i);
+                Real dist = m_fvmMesh.faceOwnerDist(i);
 
-                        Integer aNeighborId = m_fvmMesh.face(aFaceId).neighborId(aControlVolumeId);
+                Real flux = m_flux[i];
 
-                        Integer anIndexN = m_mapIdToIndex[aNeighborId];
+                if (anIndexN >= 0)
+                {
 
-                        if (m_fvmMesh.controlVolume(aNeighborId).containsFace(aFaceId))
-                        {
+                    Real volumeN = m_fvmMesh.originalVolume(anIndexN);
 
-                            area += m_fvmMesh.controlVolume(aNeighborId).faceArea(aFaceId); area *= 0.5;
-                            dist += m_fvmMesh.controlVolume(aNeighborId).faceDist(aFaceId);
+                    dist += m_fvmMesh.faceNeighborDist(i);
 
-                            dens += m_dens[aNeighborId]; dens *= 0.5;
-                            visc += m_visc[aNeighborId]; visc *= 0.5;
+                    Real dens = m_dens[anIndexO]; dens += m_dens[anIndexN]; dens *= 0.5;
+                    Real visc = m_visc[anIndexO]; visc += m_visc[anIndexN]; visc *= 0.5;
 
-                            Real xsi = 0.5; // CDS
+                    Real xsi = 0.5; // CDS
 
-                            // Convection
-                            A.coeffRef(anIndexP, anIndexP) += (1.0 - xsi) * dens * flux / volume;
+                    if (volumeO > 0.0)
+                    {
 
-                            // Diffusion
-                            A.coeffRef(anIndexP, anIndexP) += +visc * area / dist / volume;
+                        // Convection and diffusion
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, (1.0 - xsi) * dens * flux / volumeO + visc * area / dist / volumeO));
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexN, xsi * dens * flux / volumeO - visc * area / dist / volumeO));
 
-                            // Convection
-                            A.coeffRef(anIndexP, anIndexN) += xsi * dens * flux / volume;
+                    }
 
-                            // Diffusion
-                            A.coeffRef(anIndexP, anIndexN) += -visc * area / dist / volume;
+                    if (volumeN > 0.0)
+                    {
 
-                        }
+                        // Convection and diffusion - the flux leaving the owner enters the neighbor
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexN, anIndexN, (1.0 - xsi) * dens * (-flux) / volumeN + visc * area / dist / volumeN));
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexN, anIndexO, xsi * dens * (-flux) / volumeN - visc * area / dist / volumeN));
 
                     }
-                    else
-                    {
 
-                        // Diffusion
-                        A.coeffRef(anIndexP, anIndexP) += visc * area / dist / volume;
+                }
+                else if (volumeO > 0.0)
+                {
+
+                    Real dens = m_dens[anIndexO];
+                    Real visc = m_visc[anIndexO];
 
-                        bu[anIndexP] += visc * m_uf[aFaceId] * area / dist / volume;
-                        bv[anIndexP] += visc * m_vf[aFaceId] * area / dist / volume;
-                        bw[anIndexP] += visc * m_wf[aFaceId] * area / dist / volume;
+                    // Diffusion
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, visc * area / dist / volumeO));
 
-                        // Convection
-                        bu[anIndexP] += -dens * m_uf[aFaceId] * area * flux * aNormal.x() / volume;
-                        bv[anIndexP] += -dens * m_vf[aFaceId] * area * flux * aNormal.y() / volume;
-                        bw[anIndexP] += -dens * m_wf[aFaceId] * area * flux * aNormal.z() / volume;
+                    b(anIndexO, 0) += visc * m_uf[i] * area / dist / volumeO;
+                    b(anIndexO, 1) += visc * m_vf[i] * area / dist / volumeO;
+                    b(anIndexO, 2) += visc * m_wf[i] * area / dist / volumeO;
 
-                    }
+                    // Convection
+                    b(anIndexO, 0) += -dens * m_uf[i] * area * flux * aNormal.x() / volumeO;
+                    b(anIndexO, 1) += -dens * m_vf[i] * area * flux * aNormal.y() / volumeO;
+                    b(anIndexO, 2) += -dens * m_wf[i] * area * flux * aNormal.z() / volumeO;
 
                 }
 
+            }
+
+            // Assemble momentum matrix - cell contributions
+            for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
+            {
+
+                if (m_fvmMesh.originalVolume(anIndexP) <= 0.0)
+                    continue;
+
                 // Source - gravity
-                bu[anIndexP] += m_dens[aControlVolumeId] * m_gx;
-                bv[anIndexP] += m_dens[aControlVolumeId] * m_gy;
-                bw[anIndexP] += m_dens[aControlVolumeId] * m_gz;
+                b(anIndexP, 0) += m_dens[anIndexP] * m_gx;
+                b(anIndexP, 1) += m_dens[anIndexP] * m_gy;
+                b(anIndexP, 2) += m_dens[anIndexP] * m_gz;
 
                 // Source - pressure
-                CGeoVector<Real> gradp = this->gradient(m_p, m_pf, aControlVolumeId);
-
-                bu[anIndexP] += gradp.x();
-                bv[anIndexP] += gradp.y();
-                bw[anIndexP] += gradp.z();
+                b(anIndexP, 0) -= gradp[anIndexP].x();
+                b(anIndexP, 1) -= gradp[anIndexP].y();
+                b(anIndexP, 2) -= gradp[anIndexP].z();
 
                 if (m_dt > 0.0)
                 {
 
-                    A.coeffRef(anIndexP, anIndexP) += m_dens[aControlVolumeId] / m_dt;
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexP, anIndexP, m_dens[anIndexP] / m_dt));
 
-                    bu[anIndexP] += m_dens[aControlVolumeId] / m_dt * m_u0[aControlVolumeId];
-                    bv[anIndexP] += m_dens[aControlVolumeId] / m_dt * m_v0[aControlVolumeId];
-                    bw[anIndexP] += m_dens[aControlVolumeId] / m_dt * m_w0[aControlVolumeId];
+                    b(anIndexP, 0) += m_dens[anIndexP] / m_dt * m_u0[anIndexP];
+                    b(anIndexP, 1) += m_dens[anIndexP] / m_dt * m_v0[anIndexP];
+                    b(anIndexP, 2) += m_dens[anIndexP] / m_dt * m_w0[anIndexP];
 
                 }
 
             }
 
-            A.finalize();
+            A.setFromTriplets(sCoefficients.begin(), sCoefficients.end());
 
-            Eigen::BiCGSTAB<Eigen::SparseMatrix<Real> > solver;
-            solver.compute(A);
+        }
 
-            Eigen::Matrix<Real, Eigen::Dynamic, 1> u = solver.solve(bu);
-            Eigen::Matrix<Real, Eigen::Dynamic, 1> v = solver.solve(bv);
-            Eigen::Matrix<Real, Eigen::Dynamic, 1> w = solver.solve(bw);
+        template <typename Real>
+        void CFvmPisoSolver<Real>::calculateVelocityCoefficients(Eigen::SparseMatrix<Real>& A, Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& b, Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& x, const vecField& gradp)
+        {
 
-            for (int k = 0; k < A.outerSize(); ++k)
+            for (Integer i = 0; i < static_cast<Integer> (A.rows()); ++i)
             {
 
-                Integer aControlVolumeId = m_mapIndexToId[k];
+                m_Hu[i] = b(i, 0) + gradp[i].x();
+                m_Hv[i] = b(i, 1) + gradp[i].y();
+                m_Hw[i] = b(i, 2) + gradp[i].z();
 
-                CGeoVector<Real> gradp = this->gradient(m_p, m_pf, aControlVolumeId);
+            }
 
-                m_Hu[aControlVolumeId] = bu[k] - gradp.x();
-                m_Hv[aControlVolumeId] = bv[k] - gradp.y();
-                m_Hw[aControlVolumeId] = bw[k] - gradp.z();
+            // H = b - sum(anb * unb), the matrix is stored by columns
+            for (int k = 0; k < A.outerSize(); ++k)
+            {
 
                 for (typename Eigen::SparseMatrix<Real>::InnerIterator it(A, k); it; ++it)
                 {
 
                     if (it.row() == it.col())
-                        m_ap[aControlVolumeId] = it.value();
+                        m_ap[it.row()] = it.value();
                     else
                     {
-                        m_Hu[aControlVolumeId] += -it.value() * u[k];
-                        m_Hv[aControlVolumeId] += -it.value() * v[k];
-                        m_Hw[aControlVolumeId] += -it.value() * w[k];
+                        m_Hu[it.row()] += -it.value() * x(it.col(), 0);
+                        m_Hv[it.row()] += -it.value() * x(it.col(), 1);
+                        m_Hw[it.row()] += -it.value() * x(it.col(), 2);
                     }
 
                 }
@@ -383,326 +494,581 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        void CFvmPisoSolver<Real>::calculateVelocityField()
+        {
+
+            Eigen::SparseMatrix<Real> A;
+            Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> b;
+
+            vecField gradp;
+
+            this->gradient(m_p, m_pf, gradp);
+
+            this->assembleVelocityField(A, b, gradp);
+
+            Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> x = m_momentumSolver.solve(ENigMA::sle::MT_SPARSE, A, b);
+
+            this->calculateVelocityCoefficients(A, b, x, gradp);
+
+        }
+
         template <typename Real>
         void CFvmPisoSolver<Real>::calculatePressureField()
         {
 
+            const Integer nbControlVolumes = m_fvmMesh.nbControlVolumes();
+
             Eigen::SparseMatrix<Real> A;
             Eigen::Matrix<Real, Eigen::Dynamic, 1> b;
 
-            A.resize(m_fvmMesh.nbControlVolumes(), m_fvmMesh.nbControlVolumes());
-            A.reserve(m_fvmMesh.nbControlVolumes());
+            std::vector<Eigen::Triplet<Real> > sCoefficients;
+            sCoefficients.reserve(4 * m_fvmMesh.nbFaces());
 
-            b.resize(m_fvmMesh.nbControlVolumes());
+            A.resize(nbControlVolumes, nbControlVolumes);
+
+            b.resize(nbControlVolumes);
             b.setZero();
 
             // Assemble pressure matrix
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            for (Integer i = 0; i < m_fvmMesh.nbFaces(); ++i)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+                Integer anIndexO = m_fvmMesh.faceOwner(i);
+                Integer anIndexN = m_fvmMesh.faceNeighbor(i);
+
+                CGeoNormal<Real>& aNormal = m_fvmMesh.faceNormal(i);
+
+                Real area = m_fvmMesh.faceArea(i);
+                Real dist = m_fvmMesh.faceOwnerDist(i);
+
+                Real apj = m_ap[anIndexO];
 
-                Integer anIndexP = m_mapIdToIndex[aControlVolumeId];
+                Real Huj = m_Hu[anIndexO];
+                Real Hvj = m_Hv[anIndexO];
+                Real Hwj = m_Hw[anIndexO];
 
-                for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
+                if (anIndexN >= 0)
                 {
 
-                    Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+                    dist += m_fvmMesh.faceNeighborDist(i);
 
-                    CGeoNormal<Real>& aNormal = m_fvmMesh.controlVolume(aControlVolumeId).faceNormal(aFaceId);
+                    apj += m_ap[anIndexN]; apj *= 0.5;
 
-                    Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
-                    Real dist = m_fvmMesh.controlVolume(aControlVolumeId).faceDist(aFaceId);
+                    Huj += m_Hu[anIndexN]; Huj *= 0.5;
+                    Hvj += m_Hv[anIndexN]; Hvj *= 0.5;
+                    Hwj += m_Hw[anIndexN]; Hwj *= 0.5;
 
-                    Real apj = m_ap[aControlVolumeId];
+                    Real Hf = Huj * aNormal.x() + Hvj * aNormal.y() + Hwj * aNormal.z();
 
-                    Real Huj = m_Hu[aControlVolumeId];
-                    Real Hvj = m_Hv[aControlVolumeId];
-                    Real Hwj = m_Hw[aControlVolumeId];
+                    Real coeff = 1.0 / (apj * dist) * area;
 
-                    if (m_fvmMesh.face(aFaceId).hasPair())
-                    {
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, -coeff));
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexN, +coeff));
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexN, anIndexN, -coeff));
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexN, anIndexO, +coeff));
+
+                    m_flux[i] = Hf / apj * area;
+
+                    b[anIndexO] += m_flux[i];
+                    b[anIndexN] -= m_flux[i];
+
+                }
+                else
+                {
 
-                        Integer aNeighborId = m_fvmMesh.face(aFaceId).neighborId(aControlVolumeId);
+                    Real Hf = Huj * aNormal.x() + Hvj * aNormal.y() + Hwj * aNormal.z();
 
-                        Integer anIndexN = m_mapIdToIndex[aNeighborId];
+                    CFvmBoundaryType& aBoundaryType = m_faceBoundaryTypes[i];
 
-                        if (m_fvmMesh.controlVolume(aNeighborId).containsFace(aFaceId))
-                        {
+                    if (aBoundaryType == BT_WALL_NO_SLIP)
+                    {
 
-                            area += m_fvmMesh.controlVolume(aNeighborId).faceArea(aFaceId); area *= 0.5;
-                            dist += m_fvmMesh.controlVolume(aNeighborId).faceDist(aFaceId);
+                        // specified flux = 0
+                        // pressure gradient = 0
 
-                            apj += m_ap[aNeighborId]; apj *= 0.5;
+                    }
+                    else if (aBoundaryType == BT_INLET_FLOW)
+                    {
 
-                            Huj += m_Hu[aNeighborId]; Huj *= 0.5;
-                            Hvj += m_Hv[aNeighborId]; Hvj *= 0.5;
-                            Hwj += m_Hw[aNeighborId]; Hwj *= 0.5;
+                        // specified flux
+                        // pressure gradient = 0
+                        b[anIndexO] -= m_flux[i];
 
-                            Real Hf = Huj * aNormal.x() + Hvj * aNormal.y() + Hwj * aNormal.z();
+                        m_flux[i] = -(m_uf[i] * aNormal.x() + m_vf[i] * aNormal.y() + m_wf[i] * aNormal.z()) * area;
 
-                            A.coeffRef(anIndexP, anIndexP) += -1.0 / (apj * dist) * area;
-                            A.coeffRef(anIndexP, anIndexN) += +1.0 / (apj * dist) * area;
+                    }
+                    else if (aBoundaryType == BT_INLET_PRESSURE)
+                    {
+
+                        // specified pressure 
+                        // velocity gradient = 0
+
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, -1.0 / (apj * dist) * area));
+                        b[anIndexO] += -1.0 / (apj * dist) * area * m_pf[i];
 
-                            m_flux[aFaceId] = -Hf / apj * area;
+                        m_flux[i] = -Hf / apj * area;
 
-                            b[anIndexP] -= m_flux[aFaceId];
+                        b[anIndexO] -= m_flux[i];
 
-                        }
+                        m_uf[i] = -m_flux[i] / area * aNormal.x();
+                        m_vf[i] = -m_flux[i] / area * aNormal.y();
+                        m_wf[i] = -m_flux[i] / area * aNormal.z();
 
                     }
-                    else
+                    else if (aBoundaryType == BT_OUTLET)
                     {
 
-                        Real Hf = Huj * aNormal.x() + Hvj * aNormal.y() + Hwj * aNormal.z();
+                        // specified pressure = 0
+                        // velocity gradient = 0
 
-                        if (m_fvmMesh.face(aFaceId).boundaryType() == BT_WALL_NO_SLIP)
-                        {
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, -1.0 / (apj * dist) * area));
 
-                            // specified flux = 0
-                            // pressure gradient = 0
+                        m_flux[i] = -Hf / apj * area;
 
-                        }
-                        else if (m_fvmMesh.face(aFaceId).boundaryType() == BT_INLET_FLOW)
-                        {
+                        b[anIndexO] -= m_flux[i];
 
-                            // specified flux
-                            // pressure gradient = 0
-                            b[anIndexP] -= m_flux[aFaceId];
+                        m_uf[i] = -m_flux[i] / area * aNormal.x();
+                        m_vf[i] = -m_flux[i] / area * aNormal.y();
+                        m_wf[i] = -m_flux[i] / area * aNormal.z();
 
-                            m_flux[aFaceId] = -(m_uf[aFaceId] * aNormal.x() + m_vf[aFaceId] * aNormal.y() + m_wf[aFaceId] * aNormal.z()) * area;
+                    }
 
-                        }
-                        else if (m_fvmMesh.face(aFaceId).boundaryType() == BT_INLET_PRESSURE)
-                        {
+                }
 
-                            // specified pressure 
-                            // velocity gradient = 0
+            }
 
-                            A.coeffRef(anIndexP, anIndexP) += -1.0 / (apj * dist) * area;
-                            b[anIndexP] += -1.0 / (apj * dist) * area * m_pf[aFaceId];
+            A.setFromTriplets(sCoefficients.begin(), sCoefficients.end());
 
-                            m_flux[aFaceId] = -Hf / apj * area;
+            Eigen::Matrix<Real, Eigen::Dynamic, 1> p = m_pressureSolver.solve(ENigMA::sle::MT_SPARSE_SYMMETRIC, A, b);
 
-                            b[anIndexP] -= m_flux[aFaceId];
+            for (int i = 0; i < p.rows(); ++i)
+                m_p[i] = p[i];
 
-                            m_uf[aFaceId] = -m_flux[aFaceId] / area * aNormal.x();
-                            m_vf[aFaceId] = -m_flux[aFaceId] / area * aNormal.y();
-                            m_wf[aFaceId] = -m_flux[aFaceId] / area * aNormal.z();
+        }
 
-                        }
-                        else if (m_fvmMesh.face(aFaceId).boundaryType() == BT_OUTLET)
-                        {
+        template <typename Real>
+        void CFvmPisoSolver<Real>::correctFlux()
+        {
 
-                            // specified pressure = 0
-                            // velocity gradient = 0
+            const Integer nbFaces = m_fvmMesh.nbFaces();
 
-                            A.coeffRef(anIndexP, anIndexP) += -1.0 / (apj * dist) * area;
+            // Every face writes only its own flux and pressure
+            #pragma omp parallel for if (nbFaces > 1000)
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
 
-                            m_flux[aFaceId] = -Hf / apj * area;
+                Integer anIndexO = m_fvmMesh.faceOwner(i);
+                Integer anIndexN = m_fvmMesh.faceNeighbor(i);
 
-                            b[anIndexP] -= m_flux[aFaceId];
+                Real area = m_fvmMesh.faceArea(i);
+                Real dist = m_fvmMesh.faceOwnerDist(i);
 
-                            m_uf[aFaceId] = -m_flux[aFaceId] / area * aNormal.x();
-                            m_vf[aFaceId] = -m_flux[aFaceId] / area * aNormal.y();
-                            m_wf[aFaceId] = -m_flux[aFaceId] / area * aNormal.z();
+                Real apj = m_ap[anIndexO];
 
-                        }
+                if (anIndexN >= 0)
+                {
 
-                    }
+                    dist += m_fvmMesh.faceNeighborDist(i);
+
+                    apj += m_ap[anIndexN]; apj *= 0.5;
+
+                    m_flux[i] -= area / (apj * dist) * (m_p[anIndexN] - m_p[anIndexO]);
 
                 }
+                else
+                {
 
-            }
+                    CFvmBoundaryType& aBoundaryType = m_faceBoundaryTypes[i];
 
-            A.finalize();
+                    if (aBoundaryType == BT_WALL_NO_SLIP)
+                    {
 
-            Eigen::ConjugateGradient<Eigen::SparseMatrix<Real> > solver;
-            solver.compute(A);
+                        m_flux[i] = 0.0;
+                        m_pf[i] = m_p[anIndexO];
 
-            Eigen::Matrix<Real, Eigen::Dynamic, 1> p = solver.solve(b);
+                    }
+                    else if (aBoundaryType == BT_INLET_FLOW)
+                    {
 
-            for (int i = 0; i < p.rows(); ++i)
-            {
+                        m_pf[i] = m_p[anIndexO];
 
-                Integer aControlVolumeId = m_mapIndexToId[i];
+                    }
+                    else if (aBoundaryType == BT_INLET_PRESSURE)
+                    {
+
+                        m_flux[i] += area / (apj * dist) * (m_pf[i] - m_p[anIndexO]);
+
+                    }
+                    else if (aBoundaryType == BT_OUTLET)
+                    {
 
-                m_p[aControlVolumeId] = p[i];
+                        m_flux[i] -= area / (apj * dist) * m_p[anIndexO];
+                        m_pf[i] = 0.0;
+
+                    }
+
+                }
 
             }
 
         }
 
         template <typename Real>
-        void CFvmPisoSolver<Real>::correctFlux()
+        void CFvmPisoSolver<Real>::correctVelocityField()
         {
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            vecField gradp;
+
+            this->gradient(m_p, m_pf, gradp);
+
+            const Integer nbControlVolumes = m_fvmMesh.nbControlVolumes();
+
+            #pragma omp parallel for if (nbControlVolumes > 1000)
+            for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+                m_u[anIndexP] = (m_Hu[anIndexP] - gradp[anIndexP].x()) / m_ap[anIndexP];
+                m_v[anIndexP] = (m_Hv[anIndexP] - gradp[anIndexP].y()) / m_ap[anIndexP];
+                m_w[anIndexP] = (m_Hw[anIndexP] - gradp[anIndexP].z()) / m_ap[anIndexP];
 
-                for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
-                {
+            }
 
-                    Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+        }
 
-                    Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
-                    Real dist = m_fvmMesh.controlVolume(aControlVolumeId).faceDist(aFaceId);
+        template <typename Real>
+        void CFvmPisoSolver<Real>::correctPressureField()
+        {
 
-                    Real apj = m_ap[aControlVolumeId];
+            Real p_min = std::numeric_limits<Real>::max();
 
-                    if (m_fvmMesh.face(aFaceId).hasPair())
-                    {
+            for (Integer i = 0; i < static_cast<Integer> (m_p.size()); ++i)
+                p_min = std::min(p_min, m_p[i]);
 
-                        Integer aNeighborId = m_fvmMesh.face(aFaceId).neighborId(aControlVolumeId);
+            for (Integer i = 0; i < static_cast<Integer> (m_p.size()); ++i)
+                m_p[i] -= p_min;
 
-                        if (m_fvmMesh.controlVolume(aNeighborId).containsFace(aFaceId))
-                        {
+            for (Integer i = 0; i < static_cast<Integer> (m_pf.size()); ++i)
+                m_pf[i] -= p_min;
 
-                            area += m_fvmMesh.controlVolume(aNeighborId).faceArea(aFaceId); area *= 0.5;
-                            dist += m_fvmMesh.controlVolume(aNeighborId).faceDist(aFaceId);
+        }
 
-                            apj += m_ap[aNeighborId]; apj *= 0.5;
+        template <typename Real>
+        void CFvmPisoSolver<Real>::iterate(const Real dt, const bool bInit)
+        {
 
-                            if (m_fvmMesh.face(aFaceId).controlVolumeId() == aControlVolumeId)
-                                m_flux[aFaceId] -= area / (apj * dist) * (m_p[aNeighborId] - m_p[aControlVolumeId]);
+            this->setTimeInterval(dt);
 
-                        }
+            this->storePreviousQuantities();
 
-                    }
-                    else
-                    {
+            this->calculateVelocityField();
+            this->calculatePressureField();
 
-                        if (m_fvmMesh.face(aFaceId).boundaryType() == BT_WALL_NO_SLIP)
-                        {
+            this->correctFlux();
+            this->correctVelocityField();
+            this->correctPressureField();
 
-                            m_flux[aFaceId] = 0.0;
-                            m_pf[aFaceId] = m_p[aControlVolumeId];
+        }
 
-                        }
-                        else if (m_fvmMesh.face(aFaceId).boundaryType() == BT_INLET_FLOW)
-                        {
+        template <typename Real>
+        void CFvmPisoSolver<Real>::setTimeControl(const Real dtInit, const Real aMaxCourant, const Real aMaxDiffusion, const Real dtMin, const Real dtMax, const Real aMaxGrowth)
+        {
 
-                            m_pf[aFaceId] = m_p[aControlVolumeId];
+            m_dtInit = dtInit;
 
-                        }
-                        else if (m_fvmMesh.face(aFaceId).boundaryType() == BT_INLET_PRESSURE)
-                        {
+            m_maxCourant = aMaxCourant;
+            m_maxDiffusion = aMaxDiffusion;
 
-                            m_flux[aFaceId] += area / (apj * dist) * (m_pf[aFaceId] - m_p[aControlVolumeId]);
+            m_dtMin = dtMin;
+            m_dtMax = dtMax;
 
-                        }
-                        else if (m_fvmMesh.face(aFaceId).boundaryType() == BT_OUTLET)
-                        {
+            m_maxGrowth = aMaxGrowth;
 
-                            m_flux[aFaceId] += area / (apj * dist) * m_p[aControlVolumeId];
-                            m_pf[aFaceId] = 0.0;
+        }
 
-                        }
+        template <typename Real>
+        Real CFvmPisoSolver<Real>::iterateAdaptive(const bool bInit)
+        {
 
-                    }
+            Real dt = m_dtInit;
 
-                }
+            // The next step is sized from the fluxes of the last one
+            if (!m_timeIntervals.empty())
+                dt = this->calculateTimeInterval();
 
-            }
+            dt = std::min(std::max(dt, m_dtMin), m_dtMax);
+
+            this->iterate(dt, bInit);
+
+            m_time += dt;
+            m_timeIntervals.push_back(dt);
+
+            return dt;
 
         }
 
         template <typename Real>
-        void CFvmPisoSolver<Real>::correctVelocityField()
+        Real CFvmPisoSolver<Real>::courant(const Real dt)
         {
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            const Integer nbControlVolumes = m_fvmMesh.nbControlVolumes();
+
+            std::vector<Real> sCourant(nbControlVolumes, 0.0);
+
+            // Co = 0.5 * dt * sum(|flux|) / V, independent of the flux sign convention on the boundary
+            #pragma omp parallel for if (nbControlVolumes > 1000)
+            for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+                Real aVolume = m_fvmMesh.originalVolume(anIndexP);
+
+                if (aVolume <= 0.0)
+                    continue;
+
+                Real sumFlux = 0.0;
 
-                CGeoVector<Real> gradp = this->gradient(m_p, m_pf, aControlVolumeId);
+                for (Integer j = 0; j < m_fvmMesh.nbControlVolumeFaces(anIndexP); ++j)
+                    sumFlux += fabs(m_flux[m_fvmMesh.controlVolumeFace(anIndexP, j)]);
 
-                m_u[aControlVolumeId] = (m_Hu[aControlVolumeId] - gradp.x()) / m_ap[aControlVolumeId];
-                m_v[aControlVolumeId] = (m_Hv[aControlVolumeId] - gradp.y()) / m_ap[aControlVolumeId];
-                m_w[aControlVolumeId] = (m_Hw[aControlVolumeId] - gradp.z()) / m_ap[aControlVolumeId];
+                sCourant[anIndexP] = 0.5 * sumFlux * dt / aVolume;
 
             }
 
+            Real maxCo = 0.0;
+
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+                maxCo = std::max(maxCo, sCourant[i]);
+
+            return maxCo;
+
         }
 
         template <typename Real>
-        void CFvmPisoSolver<Real>::correctPressureField()
+        Real CFvmPisoSolver<Real>::diffusion(const Real dt)
         {
 
-            Real p_min = std::numeric_limits<Real>::max();
+            const Integer nbControlVolumes = m_fvmMesh.nbControlVolumes();
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            std::vector<Real> sDiffusion(nbControlVolumes, 0.0);
+
+            // D = dt * sum(visc * area / dist) / (dens * V)
+            #pragma omp parallel for if (nbControlVolumes > 1000)
+            for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+                Real aVolume = m_fvmMesh.originalVolume(anIndexP);
 
-                p_min = std::min(p_min, m_p[aControlVolumeId]);
+                if (aVolume <= 0.0 || m_dens[anIndexP] <= 0.0)
+                    continue;
 
-            }
+                Real sumCoeff = 0.0;
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
-            {
+                for (Integer j = 0; j < m_fvmMesh.nbControlVolumeFaces(anIndexP); ++j)
+                {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+                    Integer i = m_fvmMesh.controlVolumeFace(anIndexP, j);
 
-                m_p[aControlVolumeId] -= p_min;
+                    Integer anIndexN = m_fvmMesh.faceNeighbor(i);
 
-            }
+                    Real dist = m_fvmMesh.faceOwnerDist(i);
+                    Real visc = m_visc[anIndexP];
 
-            for (Integer i = 0; i < m_fvmMesh.nbFaces(); ++i)
-            {
+                    if (anIndexN >= 0)
+                    {
 
-                Integer aFaceId = m_fvmMesh.faceId(i);
+                        dist += m_fvmMesh.faceNeighborDist(i);
+
+                        visc = m_visc[m_fvmMesh.faceOwner(i)]; visc += m_visc[anIndexN]; visc *= 0.5;
 
-                m_pf[aFaceId] -= p_min;
+                    }
+
+                    if (dist > 0.0)
+                        sumCoeff += visc * m_fvmMesh.faceArea(i) / dist;
+
+                }
+
+                sDiffusion[anIndexP] = sumCoeff * dt / (m_dens[anIndexP] * aVolume);
 
             }
 
+            Real maxD = 0.0;
+
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+                maxD = std::max(maxD, sDiffusion[i]);
+
+            return maxD;
+
         }
 
         template <typename Real>
-        void CFvmPisoSolver<Real>::iterate(const Real dt, const bool bInit)
+        Real CFvmPisoSolver<Real>::time()
         {
 
-            this->setTimeInterval(dt);
+            return m_time;
 
-            this->storePreviousQuantities();
+        }
 
-            this->calculateVelocityField();
-            this->calculatePressureField();
+        template <typename Real>
+        std::vector<Real>& CFvmPisoSolver<Real>::timeIntervals()
+        {
 
-            this->correctFlux();
-            this->correctVelocityField();
-            this->correctPressureField();
+            return m_timeIntervals;
 
         }
 
         template <typename Real>
-        Real CFvmPisoSolver<Real>::checkMassConservationCell(const Integer aControlVolumeId)
+        void CFvmPisoSolver<Real>::writeState(CFvmCheckpoint<Real>& aCheckpoint)
         {
 
-            Real sumCellFlux = 0.0;
+            aCheckpoint.beginBlock("PISO");
 
-            for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
-            {
+            aCheckpoint.write(m_fvmMesh.nbControlVolumes());
+            aCheckpoint.write(m_fvmMesh.nbFaces());
 
-                Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+            aCheckpoint.write(m_calcu);
+            aCheckpoint.write(m_calcv);
+            aCheckpoint.write(m_calcw);
+            aCheckpoint.write(m_calcp);
 
-                Real flux;
+            aCheckpoint.write(m_dt);
+            aCheckpoint.write(m_time);
+            aCheckpoint.write(m_dtInit);
+            aCheckpoint.write(m_dtMin);
+            aCheckpoint.write(m_dtMax);
+            aCheckpoint.write(m_maxCourant);
+            aCheckpoint.write(m_maxDiffusion);
+            aCheckpoint.write(m_maxGrowth);
+            aCheckpoint.write(m_timeIntervals);
 
-                if (m_fvmMesh.face(aFaceId).controlVolumeId() == aControlVolumeId)
-                    flux = +m_flux[aFaceId];
-                else
-                    flux = -m_flux[aFaceId];
+            aCheckpoint.write(m_gx);
+            aCheckpoint.write(m_gy);
+            aCheckpoint.write(m_gz);
+
+            aCheckpoint.write(m_faceBoundaryTypes);
+
+            aCheckpoint.write(m_dens);
+            aCheckpoint.write(m_visc);
+            aCheckpoint.write(m_flux);
+
+            aCheckpoint.write(m_u0); aCheckpoint.write(m_v0); aCheckpoint.write(m_w0);
+            aCheckpoint.write(m_u); aCheckpoint.write(m_v); aCheckpoint.write(m_w);
+            aCheckpoint.write(m_uf); aCheckpoint.write(m_vf); aCheckpoint.write(m_wf);
+
+            aCheckpoint.write(m_p0);
+            aCheckpoint.write(m_p);
+            aCheckpoint.write(m_pf);
+
+            aCheckpoint.write(m_ap);
+            aCheckpoint.write(m_bu); aCheckpoint.write(m_bv); aCheckpoint.write(m_bw);
+            aCheckpoint.write(m_Hu); aCheckpoint.write(m_Hv); aCheckpoint.write(m_Hw);
+
+            aCheckpoint.write(m_massError);
 
-                sumCellFlux += flux;
+            aCheckpoint.endBlock();
 
+        }
+
+        template <typename Real>
+        bool CFvmPisoSolver<Real>::readState(CFvmCheckpoint<Real>& aCheckpoint)
+        {
+
+            if (!aCheckpoint.openBlock("PISO"))
+                return false;
+
+            Integer nbControlVolumes, nbFaces;
+
+            if (!aCheckpoint.read(nbControlVolumes) || !aCheckpoint.read(nbFaces))
+                return false;
+
+            if (nbControlVolumes != m_fvmMesh.nbControlVolumes() || nbFaces != m_fvmMesh.nbFaces())
+                return false;
+
+            return aCheckpoint.read(m_calcu) &&
+                aCheckpoint.read(m_calcv) &&
+                aCheckpoint.read(m_calcw) &&
+                aCheckpoint.read(m_calcp) &&
+                aCheckpoint.read(m_dt) &&
+                aCheckpoint.read(m_time) &&
+                aCheckpoint.read(m_dtInit) &&
+                aCheckpoint.read(m_dtMin) &&
+                aCheckpoint.read(m_dtMax) &&
+                aCheckpoint.read(m_maxCourant) &&
+                aCheckpoint.read(m_maxDiffusion) &&
+                aCheckpoint.read(m_maxGrowth) &&
+                aCheckpoint.read(m_timeIntervals) &&
+                aCheckpoint.read(m_gx) &&
+                aCheckpoint.read(m_gy) &&
+                aCheckpoint.read(m_gz) &&
+                aCheckpoint.read(m_faceBoundaryTypes) &&
+                aCheckpoint.read(m_dens) &&
+                aCheckpoint.read(m_visc) &&
+                aCheckpoint.read(m_flux) &&
+                aCheckpoint.read(m_u0) && aCheckpoint.read(m_v0) && aCheckpoint.read(m_w0) &&
+                aCheckpoint.read(m_u) && aCheckpoint.read(m_v) && aCheckpoint.read(m_w) &&
+                aCheckpoint.read(m_uf) && aCheckpoint.read(m_vf) && aCheckpoint.read(m_wf) &&
+                aCheckpoint.read(m_p0) &&
+                aCheckpoint.read(m_p) &&
+                aCheckpoint.read(m_pf) &&
+                aCheckpoint.read(m_ap) &&
+                aCheckpoint.read(m_bu) && aCheckpoint.read(m_bv) && aCheckpoint.read(m_bw) &&
+                aCheckpoint.read(m_Hu) && aCheckpoint.read(m_Hv) && aCheckpoint.read(m_Hw) &&
+                aCheckpoint.read(m_massError);
+
+        }
+
+        template <typename Real>
+        bool CFvmPisoSolver<Real>::saveCheckpoint(const std::string strFileName, const bool bAsync)
+        {
+
+            // The snapshot buffer is reused, so only one write is in flight
+            this->waitCheckpoint();
+
+            m_checkpoint.clear();
+
+            m_fvmMesh.writeFaceGeometry(m_checkpoint);
+
+            this->writeState(m_checkpoint);
+
+            // The solver keeps iterating on its own fields while the copy is written
+            if (bAsync)
+            {
+                m_checkpointWriter = std::async(std::launch::async, &CFvmCheckpoint<Real>::save, &m_checkpoint, strFileName);
+                return true;
             }
 
-            return sumCellFlux;
+            return m_checkpoint.save(strFileName);
+
+        }
+
+        template <typename Real>
+        bool CFvmPisoSolver<Real>::waitCheckpoint()
+        {
+
+            if (m_checkpointWriter.valid())
+                return m_checkpointWriter.get();
+
+            return true;
+
+        }
+
+        template <typename Real>
+        bool CFvmPisoSolver<Real>::loadCheckpoint(const std::string strFileName)
+        {
+
+            CFvmCheckpoint<Real> aCheckpoint;
+
+            if (!aCheckpoint.load(strFileName))
+                return false;
+
+            return this->loadCheckpoint(aCheckpoint);
+
+        }
+
+        template <typename Real>
+        bool CFvmPisoSolver<Real>::loadCheckpoint(CFvmCheckpoint<Real>& aCheckpoint)
+        {
+
+            return this->readState(aCheckpoint);
 
         }
 
@@ -710,21 +1076,36 @@ namespace ENigMA
         void CFvmPisoSolver<Real>::checkMassConservation(Real& aMassError)
         {
 
-            Real sumFlux = 0.0;
+            const Integer nbControlVolumes = m_fvmMesh.nbControlVolumes();
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            #pragma omp parallel for if (nbControlVolumes > 1000)
+            for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+                Real anError = 0.0;
+
+                for (Integer j = 0; j < m_fvmMesh.nbControlVolumeFaces(anIndexP); ++j)
+                {
 
-                Real sumCellFlux = this->checkMassConservationCell(aControlVolumeId);
+                    Integer i = m_fvmMesh.controlVolumeFace(anIndexP, j);
 
-                m_massError[aControlVolumeId] = sumCellFlux;
+                    if (m_fvmMesh.faceOwner(i) == anIndexP)
+                        anError += m_flux[i];
+                    else
+                        anError -= m_flux[i];
 
-                sumFlux += fabs(sumCellFlux);
+                }
+
+                m_massError[anIndexP] = anError;
 
             }
 
+            // The sum stays serial so the result does not depend on the thread count
+            Real sumFlux = 0.0;
+
+            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+                sumFlux += fabs(m_massError[i]);
+
             if (m_fvmMesh.nbControlVolumes() > 0)
                 sumFlux /= m_fvmMesh.nbControlVolumes();
 
@@ -744,12 +1125,10 @@ namespace ENigMA
             for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
-
-                ru += (m_u[aControlVolumeId] - m_u0[aControlVolumeId]) * (m_u[aControlVolumeId] - m_u0[aControlVolumeId]);
-                rv += (m_v[aControlVolumeId] - m_v0[aControlVolumeId]) * (m_v[aControlVolumeId] - m_v0[aControlVolumeId]);
-                rw += (m_w[aControlVolumeId] - m_w0[aControlVolumeId]) * (m_w[aControlVolumeId] - m_w0[aControlVolumeId]);
-                rp += (m_p[aControlVolumeId] - m_p0[aControlVolumeId]) * (m_p[aControlVolumeId] - m_p0[aControlVolumeId]);
+                ru += (m_u[i] - m_u0[i]) * (m_u[i] - m_u0[i]);
+                rv += (m_v[i] - m_v0[i]) * (m_v[i] - m_v0[i]);
+                rw += (m_w[i] - m_w0[i]) * (m_w[i] - m_w0[i]);
+                rp += (m_p[i] - m_p0[i]) * (m_p[i] - m_p0[i]);
 
             }
 
@@ -759,7 +1138,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::u(const Integer aControlVolumeId)
         {
 
-            return m_u[aControlVolumeId];
+            return m_u[m_controlVolumeIndices[aControlVolumeId]];
 
         }
 
@@ -767,7 +1146,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::v(const Integer aControlVolumeId)
         {
 
-            return m_v[aControlVolumeId];
+            return m_v[m_controlVolumeIndices[aControlVolumeId]];
 
         }
 
@@ -775,7 +1154,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::w(const Integer aControlVolumeId)
         {
 
-            return m_w[aControlVolumeId];
+            return m_w[m_controlVolumeIndices[aControlVolumeId]];
 
         }
 
@@ -783,7 +1162,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::p(const Integer aControlVolumeId)
         {
 
-            return m_p[aControlVolumeId];
+            return m_p[m_controlVolumeIndices[aControlVolumeId]];
 
         }
 
@@ -791,7 +1170,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::uf(const Integer aFaceId)
         {
 
-            return m_uf[aFaceId];
+            return m_uf[m_faceIndices[aFaceId]];
 
         }
 
@@ -799,7 +1178,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::vf(const Integer aFaceId)
         {
 
-            return m_vf[aFaceId];
+            return m_vf[m_faceIndices[aFaceId]];
 
         }
 
@@ -807,7 +1186,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::wf(const Integer aFaceId)
         {
 
-            return m_wf[aFaceId];
+            return m_wf[m_faceIndices[aFaceId]];
 
         }
 
@@ -815,7 +1194,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::pf(const Integer aFaceId)
         {
 
-            return m_pf[aFaceId];
+            return m_pf[m_faceIndices[aFaceId]];
 
         }
 
@@ -823,7 +1202,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::flux(const Integer aFaceId)
         {
 
-            return m_flux[aFaceId];
+            return m_flux[m_faceIndices[aFaceId]];
 
         }
 
@@ -831,7 +1210,7 @@ namespace ENigMA
         CGeoVector<Real> CFvmPisoSolver<Real>::gradu(const Integer aControlVolumeId)
         {
 
-            return this->gradient(m_u, m_uf, aControlVolumeId);
+            return this->gradient(m_u, m_uf, m_controlVolumeIndices[aControlVolumeId]);
 
         }
 
@@ -839,7 +1218,7 @@ namespace ENigMA
         CGeoVector<Real> CFvmPisoSolver<Real>::gradv(const Integer aControlVolumeId)
         {
 
-            return this->gradient(m_v, m_vf, aControlVolumeId);
+            return this->gradient(m_v, m_vf, m_controlVolumeIndices[aControlVolumeId]);
 
         }
 
@@ -847,7 +1226,7 @@ namespace ENigMA
         CGeoVector<Real> CFvmPisoSolver<Real>::gradw(const Integer aControlVolumeId)
         {
 
-            return this->gradient(m_w, m_wf, aControlVolumeId);
+            return this->gradient(m_w, m_wf, m_controlVolumeIndices[aControlVolumeId]);
 
         }
 
@@ -855,7 +1234,7 @@ namespace ENigMA
         CGeoVector<Real> CFvmPisoSolver<Real>::gradp(const Integer aControlVolumeId)
         {
 
-            return this->gradient(m_p, m_pf, aControlVolumeId);
+            return this->gradient(m_p, m_pf, m_controlVolumeIndices[aControlVolumeId]);
 
         }
 
@@ -863,7 +1242,7 @@ namespace ENigMA
         Real CFvmPisoSolver<Real>::massError(const Integer aControlVolumeId)
         {
 
-            return m_massError[aControlVolumeId];
+            return m_massError[m_controlVolumeIndices[aControlVolumeId]];
 
         }
 
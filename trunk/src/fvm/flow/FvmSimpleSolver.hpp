@@ -0,0 +1,71 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include "FvmPisoSolver.hpp"
+
+namespace ENigMA
+{
+
+    namespace fvm
+    {
+
+        template <typename Real>
+        class CFvmSimpleSolver : public CFvmPisoSolver<Real>
+        {
+        protected:
+
+            typedef typename CFvmPisoSolver<Real>::varField varField;
+            typedef typename CFvmPisoSolver<Real>::vecField vecField;
+
+            Real m_alphau;              // Velocity under-relaxation factor
+            Real m_alphap;              // Pressure under-relaxation factor
+
+            bool m_consistent;          // SIMPLEC
+
+            Integer m_iteration;        // Outer iteration counter
+
+            Real m_ru0, m_rp0;          // Residuals of the first outer iteration
+            Real m_ru, m_rp;            // Normalized residuals of the last outer iteration
+
+            varField m_pf0;             // Face center pressure - previous outer iteration
+
+            virtual void storePreviousQuantities();
+
+            virtual void calculateVelocityField();
+
+            virtual void correctPressureField();
+
+            virtual void writeState(CFvmCheckpoint<Real>& aCheckpoint);
+            virtual bool readState(CFvmCheckpoint<Real>& aCheckpoint);
+
+        public:
+
+            CFvmSimpleSolver(CFvmMesh<Real>& aFvmMesh);
+            ~CFvmSimpleSolver();
+
+            void setRelaxationFactors(const Real alphau, const Real alphap);
+            void setConsistent(const bool bConsistent);
+
+            virtual void iterate(const Real dt, const bool bInit = false);
+
+            Integer solve(const Integer nMaxIterations, const Real aTolerance);
+
+            Real velocityResidual();
+            Real pressureResidual();
+
+        };
+
+    }
+
+}
+
+#include "FvmSimpleSolver_Imp.hpp"
+
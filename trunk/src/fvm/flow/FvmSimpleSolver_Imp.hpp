@@ -0,0 +1,270 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <Eigen/Sparse>
+
+namespace ENigMA
+{
+
+    namespace fvm
+    {
+
+        template <typename Real>
+        CFvmSimpleSolver<Real>::CFvmSimpleSolver(CFvmMesh<Real>& aFvmMesh) : CFvmPisoSolver<Real>(aFvmMesh)
+        {
+
+            m_alphau = 0.7;
+            m_alphap = 0.3;
+
+            m_consistent = false;
+
+            m_iteration = 0;
+
+            m_ru0 = m_rp0 = 0.0;
+            m_ru = m_rp = 1.0;
+
+            m_pf0.assign(this->m_fvmMesh.nbFaces(), 0.0);
+
+        }
+
+        template <typename Real>
+        CFvmSimpleSolver<Real>::~CFvmSimpleSolver()
+        {
+
+        }
+
+        template <typename Real>
+        void CFvmSimpleSolver<Real>::setRelaxationFactors(const Real alphau, const Real alphap)
+        {
+
+            m_alphau = alphau;
+            m_alphap = alphap;
+
+        }
+
+        template <typename Real>
+        void CFvmSimpleSolver<Real>::setConsistent(const bool bConsistent)
+        {
+
+            m_consistent = bConsistent;
+
+        }
+
+        template <typename Real>
+        void CFvmSimpleSolver<Real>::storePreviousQuantities()
+        {
+
+            CFvmPisoSolver<Real>::storePreviousQuantities();
+
+            m_pf0 = this->m_pf;
+
+        }
+
+        template <typename Real>
+        void CFvmSimpleSolver<Real>::calculateVelocityField()
+        {
+
+            const Integer nbControlVolumes = this->m_fvmMesh.nbControlVolumes();
+
+            Eigen::SparseMatrix<Real> A;
+            Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> b;
+
+            vecField gradp;
+
+            this->gradient(this->m_p, this->m_pf, gradp);
+
+            this->assembleVelocityField(A, b, gradp);
+
+            // Implicit under-relaxation of the momentum equations
+            for (Integer i = 0; i < nbControlVolumes; ++i)
+            {
+
+                Real ap = A.coeff(i, i);
+
+                if (ap == 0.0)
+                    continue;
+
+                A.coeffRef(i, i) = ap / m_alphau;
+
+                b(i, 0) += (1.0 - m_alphau) / m_alphau * ap * this->m_u[i];
+                b(i, 1) += (1.0 - m_alphau) / m_alphau * ap * this->m_v[i];
+                b(i, 2) += (1.0 - m_alphau) / m_alphau * ap * this->m_w[i];
+
+            }
+
+            Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> x = this->m_momentumSolver.solve(ENigMA::sle::MT_SPARSE, A, b);
+
+            this->calculateVelocityCoefficients(A, b, x, gradp);
+
+            if (m_consistent)
+            {
+
+                // SIMPLEC - the neighbor coefficients are moved to the diagonal of the pressure equation
+                std::vector<Real> sumNb(nbControlVolumes, 0.0);
+
+                for (int k = 0; k < A.outerSize(); ++k)
+                {
+
+                    for (typename Eigen::SparseMatrix<Real>::InnerIterator it(A, k); it; ++it)
+                    {
+
+                        if (it.row() != it.col())
+                            sumNb[it.row()] += it.value();
+
+                    }
+
+                }
+
+                for (Integer i = 0; i < nbControlVolumes; ++i)
+                {
+
+                    if (this->m_ap[i] + sumNb[i] <= 0.0)
+                        continue;
+
+                    this->m_ap[i] += sumNb[i];
+
+                    this->m_Hu[i] += sumNb[i] * x(i, 0);
+                    this->m_Hv[i] += sumNb[i] * x(i, 1);
+                    this->m_Hw[i] += sumNb[i] * x(i, 2);
+
+                }
+
+            }
+
+        }
+
+        template <typename Real>
+        void CFvmSimpleSolver<Real>::correctPressureField()
+        {
+
+            CFvmPisoSolver<Real>::correctPressureField();
+
+            // Explicit under-relaxation of the pressure, the fluxes already satisfy continuity
+            for (Integer i = 0; i < static_cast<Integer> (this->m_p.size()); ++i)
+                this->m_p[i] = this->m_p0[i] + m_alphap * (this->m_p[i] - this->m_p0[i]);
+
+            for (Integer i = 0; i < static_cast<Integer> (this->m_pf.size()); ++i)
+                this->m_pf[i] = m_pf0[i] + m_alphap * (this->m_pf[i] - m_pf0[i]);
+
+        }
+
+        template <typename Real>
+        void CFvmSimpleSolver<Real>::writeState(CFvmCheckpoint<Real>& aCheckpoint)
+        {
+
+            CFvmPisoSolver<Real>::writeState(aCheckpoint);
+
+            aCheckpoint.beginBlock("SIMPLE");
+
+            aCheckpoint.write(m_alphau);
+            aCheckpoint.write(m_alphap);
+            aCheckpoint.write(m_consistent);
+
+            aCheckpoint.write(m_iteration);
+
+            aCheckpoint.write(m_ru0);
+            aCheckpoint.write(m_rp0);
+            aCheckpoint.write(m_ru);
+            aCheckpoint.write(m_rp);
+
+            aCheckpoint.write(m_pf0);
+
+            aCheckpoint.endBlock();
+
+        }
+
+        template <typename Real>
+        bool CFvmSimpleSolver<Real>::readState(CFvmCheckpoint<Real>& aCheckpoint)
+        {
+
+            if (!CFvmPisoSolver<Real>::readState(aCheckpoint))
+                return false;
+
+            if (!aCheckpoint.openBlock("SIMPLE"))
+                return false;
+
+            return aCheckpoint.read(m_alphau) &&
+                aCheckpoint.read(m_alphap) &&
+                aCheckpoint.read(m_consistent) &&
+                aCheckpoint.read(m_iteration) &&
+                aCheckpoint.read(m_ru0) &&
+                aCheckpoint.read(m_rp0) &&
+                aCheckpoint.read(m_ru) &&
+                aCheckpoint.read(m_rp) &&
+                aCheckpoint.read(m_pf0);
+
+        }
+
+        template <typename Real>
+        void CFvmSimpleSolver<Real>::iterate(const Real dt, const bool bInit)
+        {
+
+            CFvmPisoSolver<Real>::iterate(dt, bInit);
+
+            Real ru, rv, rw, rp;
+
+            this->residual(ru, rv, rw, rp);
+
+            ru = sqrt(ru + rv + rw);
+            rp = sqrt(rp);
+
+            // Residuals are scaled by those of the first outer iteration
+            if (m_iteration == 0 || bInit)
+            {
+                m_ru0 = ru;
+                m_rp0 = rp;
+            }
+
+            m_ru = (m_ru0 > 0.0) ? ru / m_ru0 : ru;
+            m_rp = (m_rp0 > 0.0) ? rp / m_rp0 : rp;
+
+            m_iteration++;
+
+        }
+
+        template <typename Real>
+        Integer CFvmSimpleSolver<Real>::solve(const Integer nMaxIterations, const Real aTolerance)
+        {
+
+            for (Integer i = 0; i < nMaxIterations; ++i)
+            {
+
+                this->iterate(0.0);
+
+                if (m_ru < aTolerance && m_rp < aTolerance)
+                    return i + 1;
+
+            }
+
+            return nMaxIterations;
+
+        }
+
+        template <typename Real>
+        Real CFvmSimpleSolver<Real>::velocityResidual()
+        {
+
+            return m_ru;
+
+        }
+
+        template <typename Real>
+        Real CFvmSimpleSolver<Real>::pressureResidual()
+        {
+
+            return m_rp;
+
+        }
+
+    }
+
+}
+
@@ -22,29 +22,44 @@ namespace ENigMA
         {
         protected:
 
+            typedef typename CFvmPisoSolver<Real>::varField varField;
+
             Real m_dens0;
             Real m_visc0;
 
             Real m_dens1;
             Real m_visc1;
 
-            varMap m_s0;                // Cell center gamma - previous time step
-            varMap m_s;                 // Cell center gamma
-            varMap m_sf;                // Face center gamma
+            varField m_s0;              // Cell center gamma - previous time step
+            varField m_s;               // Cell center gamma
+            varField m_sf;              // Face center gamma
+
+            varField m_betaf;           // Face center interpolation coefficient
+            varField m_Co;              // Cell center Courant
 
-            varMap m_betaf;             // Face center interpolation coefficient
-            varMap m_Co;                // Cell center Courant
+            Real m_maxInterfaceCourant;                 // Target interface Courant number of the adaptive steps
+
+            Integer m_bandLayers;                       // Interface band width in cell layers (0 = whole domain)
+            std::vector<Integer> m_bandControlVolumes;  // Control volumes advected this time step
+            std::vector<Integer> m_bandFaces;           // Faces of the band control volumes
+            std::vector<Integer> m_bandIndices;         // Control volume index to band index (-1 outside the band)
 
             virtual void storePreviousQuantities();
 
             virtual void updateProperties();
 
+            virtual void updateInterfaceBand(const Real aTolerance);
+
             virtual void calculateGammaField();
 
             virtual Real calculateCourant(double dt, bool bInterface);
+            virtual Real calculateTimeInterval();
             virtual void predictBeta(const Real aTolerance = 0.0);
             virtual void correctBeta(double dt, const Real aTolerance = 0.0);
 
+            virtual void writeState(CFvmCheckpoint<Real>& aCheckpoint);
+            virtual bool readState(CFvmCheckpoint<Real>& aCheckpoint);
+
         public:
 
             CFvmVofSolver(CFvmMesh<Real>& aFvmMesh);
@@ -57,6 +72,11 @@ namespace ENigMA
             void setBoundaryGamma(const Integer aFaceId, const EBoundaryType sFaceType, const Real s);
             void setBoundaryGamma(const std::vector<Integer>& sFaceIds, const EBoundaryType sFaceType, const Real s);
 
+            void setInterfaceCourant(const Real aMaxInterfaceCourant);
+
+            void setInterfaceBand(const Integer nbLayers);
+            Integer nbInterfaceBandControlVolumes();
+
             virtual void iterate(const Real dt, const bool bInit = false);
             virtual void residual(Real& ru, Real& rv, Real& rw, Real& rp, Real &rs);
 
@@ -18,26 +18,24 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CFvmVofSolver<Real>::CFvmVofSolver(CFvmMesh<Real>& aFvmMesh) : CFvmPisoSolver(aFvmMesh)
+        CFvmVofSolver<Real>::CFvmVofSolver(CFvmMesh<Real>& aFvmMesh) : CFvmPisoSolver<Real>(aFvmMesh)
         {
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
-            {
-
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
-
-                m_s0[aControlVolumeId] = m_s[aControlVolumeId] = 0.0;
+            const Integer nbControlVolumes = this->m_fvmMesh.nbControlVolumes();
+            const Integer nbFaces = this->m_fvmMesh.nbFaces();
 
-            }
+            m_s0.assign(nbControlVolumes, 0.0);
+            m_s.assign(nbControlVolumes, 0.0);
+            m_Co.assign(nbControlVolumes, 0.0);
 
-            for (Integer i = 0; i < m_fvmMesh.nbFaces(); ++i)
-            {
+            m_sf.assign(nbFaces, 0.0);
+            m_betaf.assign(nbFaces, 0.0);
 
-                Integer aFaceId = m_fvmMesh.faceId(i);
+            m_maxInterfaceCourant = 0.25;
 
-                m_sf[aFaceId] = 0.0;
+            m_bandLayers = 0;
 
-            }
+            m_bandIndices.assign(nbControlVolumes, -1);
 
         }
 
@@ -51,7 +49,7 @@ namespace ENigMA
         void CFvmVofSolver<Real>::storePreviousQuantities()
         {
 
-            CFvmPisoSolver::storePreviousQuantities();
+            CFvmPisoSolver<Real>::storePreviousQuantities();
 
             m_s0 = m_s;
 
@@ -75,7 +73,7 @@ namespace ENigMA
         void CFvmVofSolver<Real>::setInitialGamma(const Integer aControlVolumeId, const Real s)
         {
 
-            m_s[aControlVolumeId] = s;
+            m_s[this->m_controlVolumeIndices[aControlVolumeId]] = s;
 
         }
 
@@ -83,8 +81,8 @@ namespace ENigMA
         void CFvmVofSolver<Real>::setBoundaryGamma(const Integer aFaceId, const EBoundaryType sFaceType, const Real s)
         {
 
-            m_sf[aFaceId] = s;
-            m_fvmMesh.face(aFaceId).setBoundaryType(sFaceType);
+            m_sf[this->m_faceIndices[aFaceId]] = s;
+            this->setFaceBoundaryType(aFaceId, sFaceType);
 
         }
 
@@ -97,127 +95,276 @@ namespace ENigMA
 
                 Integer aFaceId = sFaceIds[i];
 
-                m_sf[aFaceId] = s;
+                m_sf[this->m_faceIndices[aFaceId]] = s;
 
-                m_fvmMesh.face(aFaceId).setBoundaryType(sFaceType);
+                this->setFaceBoundaryType(aFaceId, sFaceType);
 
             }
 
         }
 
         template <typename Real>
-        Real CFvmVofSolver<Real>::calculateCourant(double dt, bool bInterface)
+        void CFvmVofSolver<Real>::setInterfaceCourant(const Real aMaxInterfaceCourant)
         {
 
-            Real maxCp = 0.0;
+            m_maxInterfaceCourant = aMaxInterfaceCourant;
+
+        }
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+        template <typename Real>
+        void CFvmVofSolver<Real>::setInterfaceBand(const Integer nbLayers)
+        {
+
+            m_bandLayers = nbLayers;
+
+        }
+
+        template <typename Real>
+        Integer CFvmVofSolver<Real>::nbInterfaceBandControlVolumes()
+        {
+
+            return static_cast<Integer> (m_bandControlVolumes.size());
+
+        }
+
+        template <typename Real>
+        void CFvmVofSolver<Real>::updateInterfaceBand(const Real aTolerance)
+        {
+
+            CFvmMesh<Real>& aFvmMesh = this->m_fvmMesh;
+
+            const Integer nbControlVolumes = aFvmMesh.nbControlVolumes();
+            const Integer nbFaces = aFvmMesh.nbFaces();
+
+            m_bandControlVolumes.clear();
+            m_bandFaces.clear();
+
+            std::fill(m_bandIndices.begin(), m_bandIndices.end(), -1);
+
+            if (m_bandLayers <= 0)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+                for (Integer i = 0; i < nbControlVolumes; ++i)
+                {
+                    m_bandIndices[i] = i;
+                    m_bandControlVolumes.push_back(i);
+                }
 
-                Real volume = m_fvmMesh.controlVolume(aControlVolumeId).originalVolume();
+                for (Integer i = 0; i < nbFaces; ++i)
+                    m_bandFaces.push_back(i);
 
-                Real cs = 1.0;
+                return;
+
+            }
+
+            // Seed with mixed cells and cells facing a different gamma, a sharp interface has no mixed cells
+            std::vector<Integer> sFront;
+
+            for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
+            {
+
+                bool bInterface = (m_s[anIndexP] > aTolerance && m_s[anIndexP] < 1.0 - aTolerance);
+
+                for (Integer j = 0; j < aFvmMesh.nbControlVolumeFaces(anIndexP) && !bInterface; ++j)
+                {
+
+                    Integer i = aFvmMesh.controlVolumeFace(anIndexP, j);
+
+                    Integer anIndexN = (aFvmMesh.faceOwner(i) == anIndexP) ? aFvmMesh.faceNeighbor(i) : aFvmMesh.faceOwner(i);
+
+                    if (anIndexN >= 0)
+                        bInterface = fabs(m_s[anIndexN] - m_s[anIndexP]) > aTolerance;
+                    else
+                        bInterface = (this->m_flux[i] != 0.0 && fabs(m_sf[i] - m_s[anIndexP]) > aTolerance);
+
+                }
 
                 if (bInterface)
                 {
-                    Real s = std::min(std::max(m_s[aControlVolumeId], 0.0), 1.0);
-                    cs = (1.0 - s) * (1.0 - s) * s * s * 16.0;
+                    m_bandIndices[anIndexP] = 0;
+                    sFront.push_back(anIndexP);
                 }
 
-                Real Cpp = 0.0;
+            }
+
+            // Grow the band layer by layer across the faces
+            for (Integer l = 0; l < m_bandLayers && !sFront.empty(); ++l)
+            {
+
+                std::vector<Integer> sNextFront;
 
-                for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
+                for (Integer k = 0; k < static_cast<Integer> (sFront.size()); ++k)
                 {
 
-                    Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+                    Integer anIndexP = sFront[k];
 
-                    Real flux;
+                    for (Integer j = 0; j < aFvmMesh.nbControlVolumeFaces(anIndexP); ++j)
+                    {
 
-                    if (m_fvmMesh.face(aFaceId).controlVolumeId() == aControlVolumeId)
-                        flux = +m_flux[aFaceId];
-                    else
-                        flux = -m_flux[aFaceId];
+                        Integer i = aFvmMesh.controlVolumeFace(anIndexP, j);
+
+                        Integer anIndexN = (aFvmMesh.faceOwner(i) == anIndexP) ? aFvmMesh.faceNeighbor(i) : aFvmMesh.faceOwner(i);
 
-                    Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
+                        if (anIndexN >= 0 && m_bandIndices[anIndexN] < 0)
+                        {
+                            m_bandIndices[anIndexN] = 0;
+                            sNextFront.push_back(anIndexN);
+                        }
 
-                    Real Cj = std::max(-flux * area * dt / volume, 0.0);
-                    Cpp += cs * Cj;
+                    }
 
                 }
 
-                maxCp = std::max(maxCp, Cpp);
+                sFront.swap(sNextFront);
+
+            }
 
-                m_Co[aControlVolumeId] = Cpp;
+            for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
+            {
+
+                if (m_bandIndices[anIndexP] >= 0)
+                {
+                    m_bandIndices[anIndexP] = static_cast<Integer> (m_bandControlVolumes.size());
+                    m_bandControlVolumes.push_back(anIndexP);
+                }
 
             }
 
-            return maxCp;
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
+
+                Integer anIndexN = aFvmMesh.faceNeighbor(i);
+
+                if (m_bandIndices[aFvmMesh.faceOwner(i)] >= 0 || (anIndexN >= 0 && m_bandIndices[anIndexN] >= 0))
+                    m_bandFaces.push_back(i);
+
+            }
 
         }
 
         template <typename Real>
-        void CFvmVofSolver<Real>::predictBeta(const Real aTolerance)
+        Real CFvmVofSolver<Real>::calculateCourant(double dt, bool bInterface)
         {
 
-            Integer anAcceptor, aDonor;
-            CGeoVector<Real> grads;
-            Real dot;
-            Real l1, l2;
+            CFvmMesh<Real>& aFvmMesh = this->m_fvmMesh;
+
+            std::fill(m_Co.begin(), m_Co.end(), 0.0);
 
-            for (Integer i = 0; i < m_fvmMesh.nbFaces(); ++i)
+            // Sum the incoming face Courant numbers of each control volume
+            for (Integer k = 0; k < static_cast<Integer> (m_bandFaces.size()); ++k)
             {
 
-                Real betaj = 1.0;
+                Integer i = m_bandFaces[k];
+
+                Integer anIndexO = aFvmMesh.faceOwner(i);
+                Integer anIndexN = aFvmMesh.faceNeighbor(i);
+
+                Real flux = this->m_flux[i];
+
+                m_Co[anIndexO] += std::max(-flux * dt / aFvmMesh.originalVolume(anIndexO), 0.0);
+
+                if (anIndexN >= 0)
+                    m_Co[anIndexN] += std::max(+flux * dt / aFvmMesh.originalVolume(anIndexN), 0.0);
+
+            }
+
+            Real maxCp = 0.0;
 
-                Integer aFaceId = m_fvmMesh.faceId(i);
+            for (Integer k = 0; k < static_cast<Integer> (m_bandControlVolumes.size()); ++k)
+            {
+
+                Integer anIndexP = m_bandControlVolumes[k];
 
-                Integer aControlVolumeId = m_fvmMesh.face(aFaceId).controlVolumeId();
+                Real cs = 1.0;
 
-                if (m_fvmMesh.face(aFaceId).hasPair())
+                if (bInterface)
                 {
+                    Real s = std::min(std::max(m_s[anIndexP], 0.0), 1.0);
+                    cs = (1.0 - s) * (1.0 - s) * s * s * 16.0;
+                }
 
-                    Integer aNeighborId = m_fvmMesh.face(aFaceId).neighborId(aControlVolumeId);
+                m_Co[anIndexP] *= cs;
 
-                    Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
-                    Real dist = m_fvmMesh.controlVolume(aControlVolumeId).faceDist(aFaceId);
+                maxCp = std::max(maxCp, m_Co[anIndexP]);
 
-                    Real flux;
+            }
 
-                    if (m_fvmMesh.face(aFaceId).controlVolumeId() == aControlVolumeId)
-                        flux = +m_flux[aFaceId];
-                    else
-                        flux = -m_flux[aFaceId];
+            return maxCp;
 
-                    if (flux < 0.0)
-                    {
+        }
+
+        template <typename Real>
+        Real CFvmVofSolver<Real>::calculateTimeInterval()
+        {
+
+            Real dt = CFvmPisoSolver<Real>::calculateTimeInterval();
+
+            // The interface Courant number bounds the step so the sub-cycling stays short
+            Real aCourant = this->calculateCourant(this->m_dt, true);
 
-                        anAcceptor = aNeighborId;
-                        aDonor = aControlVolumeId;
+            return std::min(dt, this->adjustTimeInterval(this->m_dt, aCourant, m_maxInterfaceCourant));
 
-                        grads = this->gradient(m_s, m_sf, aDonor);
+        }
 
-                        dot = grads.dot(m_fvmMesh.face(aFaceId).normal()) * dist;
+        template <typename Real>
+        void CFvmVofSolver<Real>::predictBeta(const Real aTolerance)
+        {
+
+            CFvmMesh<Real>& aFvmMesh = this->m_fvmMesh;
+
+            const Integer nbBandControlVolumes = static_cast<Integer> (m_bandControlVolumes.size());
+            const Integer nbBandFaces = static_cast<Integer> (m_bandFaces.size());
+
+            // Outside the band gamma is uniform and its gradient vanishes
+            typename CFvmPisoSolver<Real>::vecField grads(aFvmMesh.nbControlVolumes(), CGeoVector<Real>(0.0, 0.0, 0.0));
+
+            #pragma omp parallel for if (nbBandControlVolumes > 1000)
+            for (Integer k = 0; k < nbBandControlVolumes; ++k)
+                grads[m_bandControlVolumes[k]] = this->gradient(m_s, m_sf, m_bandControlVolumes[k]);
+
+            // Every face writes only its own beta
+            #pragma omp parallel for if (nbBandFaces > 1000)
+            for (Integer k = 0; k < nbBandFaces; ++k)
+            {
+
+                Integer i = m_bandFaces[k];
+
+                Integer anAcceptor, aDonor;
+                Real dot;
+                Real l1, l2;
+
+                Real betaj = 1.0;
 
-                        l1 = grads.norm();
-                        l2 = dist;
+                Integer anIndexP = aFvmMesh.faceOwner(i);
+                Integer anIndexN = aFvmMesh.faceNeighbor(i);
+
+                if (anIndexN >= 0)
+                {
+
+                    Real dist = aFvmMesh.faceOwnerDist(i);
+
+                    // Face fluxes are stored relative to the owner control volume
+                    Real flux = this->m_flux[i];
+
+                    if (flux < 0.0)
+                    {
+
+                        anAcceptor = anIndexN;
+                        aDonor = anIndexP;
 
                     }
                     else
                     {
 
-                        anAcceptor = aControlVolumeId;
-                        aDonor = aNeighborId;
-
-                        grads = this->gradient(m_s, m_sf, aDonor);
+                        anAcceptor = anIndexP;
+                        aDonor = anIndexN;
 
-                        dot = grads.dot(m_fvmMesh.face(aFaceId).normal()) * dist;
+                    }
 
-                        l1 = grads.norm();
-                        l2 = dist;
+                    dot = grads[aDonor].dot(aFvmMesh.faceNormal(i)) * dist;
 
-                    }
+                    l1 = grads[aDonor].norm();
+                    l2 = dist;
 
                     Real su = std::min(std::max(m_s[anAcceptor] - 2 * dot, 0.0), 1.0);
 
@@ -267,7 +414,7 @@ namespace ENigMA
 
                 }
 
-                m_betaf[aFaceId] = betaj;
+                m_betaf[i] = betaj;
 
             }
 
@@ -277,53 +424,51 @@ namespace ENigMA
         void CFvmVofSolver<Real>::correctBeta(double dt, const Real aTolerance)
         {
 
-            Integer anAcceptor, aDonor;
+            CFvmMesh<Real>& aFvmMesh = this->m_fvmMesh;
 
-            for (Integer i = 0; i < m_fvmMesh.nbFaces(); ++i)
+            const Integer nbBandFaces = static_cast<Integer> (m_bandFaces.size());
+
+            #pragma omp parallel for if (nbBandFaces > 1000)
+            for (Integer k = 0; k < nbBandFaces; ++k)
             {
 
-                Integer aFaceId = m_fvmMesh.faceId(i);
+                Integer i = m_bandFaces[k];
 
-                Integer aControlVolumeId = m_fvmMesh.face(aFaceId).controlVolumeId();
+                Integer anAcceptor, aDonor;
 
-                Real volume = m_fvmMesh.controlVolume(aControlVolumeId).originalVolume();
+                Integer anIndexP = aFvmMesh.faceOwner(i);
+                Integer anIndexN = aFvmMesh.faceNeighbor(i);
 
-                Real betaj = m_betaf[aFaceId];
+                Real betaj = m_betaf[i];
 
                 if (betaj < 1E-2)
                     continue;
 
                 Real cbetaj = 0.0;
 
-                if (m_fvmMesh.face(aFaceId).hasPair())
+                if (anIndexN >= 0)
                 {
 
-                    Integer aNeighborId = m_fvmMesh.face(aFaceId).neighborId(aControlVolumeId);
-
-                    Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
-
-                    Real flux;
+                    Real volume = aFvmMesh.originalVolume(anIndexP);
 
-                    if (m_fvmMesh.face(aFaceId).controlVolumeId() == aControlVolumeId)
-                        flux = +m_flux[aFaceId];
-                    else
-                        flux = -m_flux[aFaceId];
+                    // Face fluxes are stored relative to the owner control volume
+                    Real flux = this->m_flux[i];
 
                     if (flux != 0.0)
                     {
 
                         if (flux < 0.0)
                         {
-                            anAcceptor = aNeighborId;
-                            aDonor = aControlVolumeId;
+                            anAcceptor = anIndexN;
+                            aDonor = anIndexP;
                         }
                         else
                         {
-                            anAcceptor = aControlVolumeId;
-                            aDonor = aNeighborId;
+                            anAcceptor = anIndexP;
+                            aDonor = anIndexN;
                         }
 
-                        Real Cj = std::min(std::max(-flux * area * dt / volume, 0.0), 1.0);
+                        Real Cj = std::min(std::max(-flux * dt / volume, 0.0), 1.0);
 
                         Real ds = 0.5 * (m_s0[anAcceptor] + m_s[anAcceptor]) - 0.5 * (m_s0[aDonor] + m_s[aDonor]);
 
@@ -369,7 +514,7 @@ namespace ENigMA
 
                 betaj = std::max(betaj, 0.0);
 
-                m_betaf[aFaceId] = betaj;
+                m_betaf[i] = betaj;
 
             }
 
@@ -379,13 +524,11 @@ namespace ENigMA
         void CFvmVofSolver<Real>::updateProperties()
         {
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            for (Integer i = 0; i < static_cast<Integer> (m_s.size()); ++i)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
-
-                m_dens[aControlVolumeId] = m_dens0 * (1.0 - m_s[aControlVolumeId]) + m_dens1 * m_s[aControlVolumeId];
-                m_visc[aControlVolumeId] = m_visc0 * (1.0 - m_s[aControlVolumeId]) + m_visc1 * m_s[aControlVolumeId];
+                this->m_dens[i] = m_dens0 * (1.0 - m_s[i]) + m_dens1 * m_s[i];
+                this->m_visc[i] = m_visc0 * (1.0 - m_s[i]) + m_visc1 * m_s[i];
 
             }
 
@@ -395,104 +538,173 @@ namespace ENigMA
         void CFvmVofSolver<Real>::calculateGammaField()
         {
 
+            CFvmMesh<Real>& aFvmMesh = this->m_fvmMesh;
+
+            // Only the band is solved, the gamma of the control volumes around it is held fixed
+            const Integer nbBandControlVolumes = static_cast<Integer> (m_bandControlVolumes.size());
+            const Integer nbBandFaces = static_cast<Integer> (m_bandFaces.size());
+
             Eigen::SparseMatrix<Real> A;
             Eigen::Matrix<Real, Eigen::Dynamic, 1> b;
 
-            A.resize(m_fvmMesh.nbControlVolumes(), m_fvmMesh.nbControlVolumes());
-            A.reserve(m_fvmMesh.nbControlVolumes());
+            std::vector<Eigen::Triplet<Real> > sCoefficients;
+            sCoefficients.reserve(nbBandControlVolumes + 4 * nbBandFaces);
+
+            A.resize(nbBandControlVolumes, nbBandControlVolumes);
 
-            b.resize(m_fvmMesh.nbControlVolumes());
+            b.resize(nbBandControlVolumes);
             b.setZero();
 
-            // Assemble gamma matrix
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            // Assemble gamma matrix - face contributions
+            for (Integer k = 0; k < nbBandFaces; ++k)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+                Integer i = m_bandFaces[k];
 
-                Real volume = m_fvmMesh.controlVolume(aControlVolumeId).originalVolume();
+                Integer anIndexO = aFvmMesh.faceOwner(i);
+                Integer anIndexN = aFvmMesh.faceNeighbor(i);
 
-                Integer anIndexP = m_mapIdToIndex[aControlVolumeId];
+                Integer aBandIndexO = m_bandIndices[anIndexO];
 
-                for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
-                {
+                Real flux = this->m_flux[i];
 
-                    Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+                if (anIndexN >= 0)
+                {
 
-                    Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
-                    Real dist = m_fvmMesh.controlVolume(aControlVolumeId).faceDist(aFaceId);
+                    Integer aBandIndexN = m_bandIndices[anIndexN];
 
-                    Real flux;
+                    // The downwind cell weights the face value by beta
+                    Real betaO = (flux < 0.0) ? m_betaf[i] : 1.0 - m_betaf[i];
+                    Real betaN = (flux > 0.0) ? m_betaf[i] : 1.0 - m_betaf[i];
 
-                    if (m_fvmMesh.face(aFaceId).controlVolumeId() == aControlVolumeId)
-                        flux = +m_flux[aFaceId];
-                    else
-                        flux = -m_flux[aFaceId];
-
-                    if (m_fvmMesh.face(aFaceId).hasPair())
+                    // Convection
+                    if (aBandIndexO >= 0)
                     {
 
-                        Integer aNeighborId = m_fvmMesh.face(aFaceId).neighborId(aControlVolumeId);
+                        sCoefficients.push_back(Eigen::Triplet<Real>(aBandIndexO, aBandIndexO, 0.5 * (1.0 - betaO) * flux));
 
-                        Integer anIndexN = m_mapIdToIndex[aNeighborId];
+                        if (aBandIndexN >= 0)
+                            sCoefficients.push_back(Eigen::Triplet<Real>(aBandIndexO, aBandIndexN, 0.5 * betaO * flux));
+                        else
+                            b[aBandIndexO] += -0.5 * betaO * flux * m_s[anIndexN];
 
-                        if (m_fvmMesh.controlVolume(aNeighborId).containsFace(aFaceId))
-                        {
+                        b[aBandIndexO] += -0.5 * (1.0 - betaO) * flux * m_s[anIndexO];
+                        b[aBandIndexO] += -0.5 * betaO * flux * m_s[anIndexN];
 
-                            Real beta = 0.0;
+                    }
 
-                            if (flux < 0.0)
-                                beta = m_betaf[aFaceId];
-                            else
-                                beta = 1.0 - m_betaf[aFaceId];
+                    if (aBandIndexN >= 0)
+                    {
 
-                            // Convection
-                            A.coeffRef(anIndexP, anIndexP) += 0.5 * (1.0 - beta) * flux;
-                            A.coeffRef(anIndexP, anIndexN) += 0.5 * beta * flux;
+                        sCoefficients.push_back(Eigen::Triplet<Real>(aBandIndexN, aBandIndexN, -0.5 * (1.0 - betaN) * flux));
 
-                            b[anIndexP] += -0.5 * (1.0 - beta) * flux * m_s[aControlVolumeId];
-                            b[anIndexP] += -0.5 * beta * flux * m_s[aNeighborId];
+                        if (aBandIndexO >= 0)
+                            sCoefficients.push_back(Eigen::Triplet<Real>(aBandIndexN, aBandIndexO, -0.5 * betaN * flux));
+                        else
+                            b[aBandIndexN] += 0.5 * betaN * flux * m_s[anIndexO];
 
-                        }
+                        b[aBandIndexN] += 0.5 * (1.0 - betaN) * flux * m_s[anIndexN];
+                        b[aBandIndexN] += 0.5 * betaN * flux * m_s[anIndexO];
 
                     }
-                    else
-                    {
 
-                        // Convection
-                        b[anIndexP] += -1.0 * flux * m_sf[aFaceId];
+                }
+                else
+                {
 
-                    }
+                    // Convection
+                    b[aBandIndexO] += -1.0 * flux * m_sf[i];
 
                 }
 
-                if (m_dt > 0)
+            }
+
+            if (this->m_dt > 0)
+            {
+
+                for (Integer k = 0; k < nbBandControlVolumes; ++k)
                 {
 
+                    Real volume = aFvmMesh.originalVolume(m_bandControlVolumes[k]);
+
                     // Unsteady term - Euler 
-                    A.coeffRef(anIndexP, anIndexP) += volume / m_dt;
-                    b[anIndexP] += volume / m_dt * m_s0[aControlVolumeId];
+                    sCoefficients.push_back(Eigen::Triplet<Real>(k, k, volume / this->m_dt));
+                    b[k] += volume / this->m_dt * m_s0[m_bandControlVolumes[k]];
 
                 }
 
-
             }
 
-            A.finalize();
+            if (nbBandControlVolumes == 0)
+                return;
+
+            A.setFromTriplets(sCoefficients.begin(), sCoefficients.end());
 
             Eigen::BiCGSTAB<Eigen::SparseMatrix<Real> > solver;
             solver.compute(A);
 
             Eigen::Matrix<Real, Eigen::Dynamic, 1> s = solver.solve(b);
 
-            for (int i = 0; i < s.rows(); ++i)
-            {
+            for (int k = 0; k < s.rows(); ++k)
+                m_s[m_bandControlVolumes[k]] = std::min(std::max(s[k], 0.0), 1.0);
+
+        }
 
-                Integer aControlVolumeId = m_mapIndexToId[i];
+        template <typename Real>
+        void CFvmVofSolver<Real>::writeState(CFvmCheckpoint<Real>& aCheckpoint)
+        {
 
-                m_s[aControlVolumeId] = std::min(std::max(s[i], 0.0), 1.0);
+            CFvmPisoSolver<Real>::writeState(aCheckpoint);
 
-            }
+            aCheckpoint.beginBlock("VOF");
+
+            aCheckpoint.write(m_dens0);
+            aCheckpoint.write(m_visc0);
+            aCheckpoint.write(m_dens1);
+            aCheckpoint.write(m_visc1);
+
+            aCheckpoint.write(m_s0);
+            aCheckpoint.write(m_s);
+            aCheckpoint.write(m_sf);
+
+            aCheckpoint.write(m_betaf);
+            aCheckpoint.write(m_Co);
+
+            aCheckpoint.write(m_maxInterfaceCourant);
+
+            aCheckpoint.write(m_bandLayers);
+            aCheckpoint.write(m_bandControlVolumes);
+            aCheckpoint.write(m_bandFaces);
+            aCheckpoint.write(m_bandIndices);
+
+            aCheckpoint.endBlock();
+
+        }
+
+        template <typename Real>
+        bool CFvmVofSolver<Real>::readState(CFvmCheckpoint<Real>& aCheckpoint)
+        {
+
+            if (!CFvmPisoSolver<Real>::readState(aCheckpoint))
+                return false;
+
+            if (!aCheckpoint.openBlock("VOF"))
+                return false;
+
+            return aCheckpoint.read(m_dens0) &&
+                aCheckpoint.read(m_visc0) &&
+                aCheckpoint.read(m_dens1) &&
+                aCheckpoint.read(m_visc1) &&
+                aCheckpoint.read(m_s0) &&
+                aCheckpoint.read(m_s) &&
+                aCheckpoint.read(m_sf) &&
+                aCheckpoint.read(m_betaf) &&
+                aCheckpoint.read(m_Co) &&
+                aCheckpoint.read(m_maxInterfaceCourant) &&
+                aCheckpoint.read(m_bandLayers) &&
+                aCheckpoint.read(m_bandControlVolumes) &&
+                aCheckpoint.read(m_bandFaces) &&
+                aCheckpoint.read(m_bandIndices);
 
         }
 
@@ -502,7 +714,9 @@ namespace ENigMA
 
             this->updateProperties();
 
-            CFvmPisoSolver::iterate(dt, bInit);
+            CFvmPisoSolver<Real>::iterate(dt, bInit);
+
+            this->updateInterfaceBand(1E-6);
 
             Real maxCp = this->calculateCourant(dt, true);
 
@@ -536,24 +750,12 @@ namespace ENigMA
         void CFvmVofSolver<Real>::residual(Real& ru, Real& rv, Real& rw, Real& rp, Real &rs)
         {
 
-            ru = 0;
-            rv = 0;
-            rw = 0;
-            rp = 0;
-            rs = 0;
+            CFvmPisoSolver<Real>::residual(ru, rv, rw, rp);
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
-            {
-
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
-
-                ru += (m_u[aControlVolumeId] - m_u0[aControlVolumeId]) * (m_u[aControlVolumeId] - m_u0[aControlVolumeId]);
-                rv += (m_v[aControlVolumeId] - m_v0[aControlVolumeId]) * (m_v[aControlVolumeId] - m_v0[aControlVolumeId]);
-                rw += (m_w[aControlVolumeId] - m_w0[aControlVolumeId]) * (m_w[aControlVolumeId] - m_w0[aControlVolumeId]);
-                rp += (m_p[aControlVolumeId] - m_p0[aControlVolumeId]) * (m_p[aControlVolumeId] - m_p0[aControlVolumeId]);
-                rs += (m_s[aControlVolumeId] - m_s0[aControlVolumeId]) * (m_s[aControlVolumeId] - m_s0[aControlVolumeId]);
+            rs = 0;
 
-            }
+            for (Integer i = 0; i < static_cast<Integer> (m_s.size()); ++i)
+                rs += (m_s[i] - m_s0[i]) * (m_s[i] - m_s0[i]);
 
         }
 
@@ -561,7 +763,7 @@ namespace ENigMA
         Real CFvmVofSolver<Real>::s(const Integer aControlVolumeId)
         {
 
-            return m_s[aControlVolumeId];
+            return m_s[this->m_controlVolumeIndices[aControlVolumeId]];
 
         }
 
@@ -569,7 +771,7 @@ namespace ENigMA
         Real CFvmVofSolver<Real>::sf(const Integer aFaceId)
         {
 
-            return m_sf[aFaceId];
+            return m_sf[this->m_faceIndices[aFaceId]];
 
         }
 
@@ -577,7 +779,7 @@ namespace ENigMA
         CGeoVector<Real> CFvmVofSolver<Real>::grads(const Integer aControlVolumeId)
         {
 
-            return this->gradient(m_s, m_sf, aControlVolumeId);
+            return this->gradient(m_s, m_sf, this->m_controlVolumeIndices[aControlVolumeId]);
 
         }
 
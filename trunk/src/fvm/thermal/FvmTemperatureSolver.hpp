@@ -22,19 +22,26 @@ namespace ENigMA
         {
         protected:
 
+            typedef typename CFvmPisoSolver<Real>::varField varField;
+
             bool m_calcT;
 
             Real m_bthcond;             // Boundary thermal conductivity
 
-            varMap m_thcond;            // Cell thermal conductivity
-            varMap m_spheat;            // Cell specific heat
+            varField m_thcond;          // Cell thermal conductivity
+            varField m_spheat;          // Cell specific heat
+
+            varField m_T0;              // Cell center temperature - previous time step
+            varField m_T;               // Cell center temperature
+            varField m_Tf;              // Face center temperature
 
-            varMap m_T0;                // Cell center temperature - previous time step
-            varMap m_T;                 // Cell center temperature
-            varMap m_Tf;                // Face center temperature
+            ENigMA::sle::CSleSolver<Real> m_temperatureSolver;
 
             void calculateTemperatureField();
 
+            virtual void writeState(CFvmCheckpoint<Real>& aCheckpoint);
+            virtual bool readState(CFvmCheckpoint<Real>& aCheckpoint);
+
         public:
 
             CFvmTemperatureSolver(CFvmMesh<Real>& aFvmMesh);
@@ -54,6 +61,8 @@ namespace ENigMA
             Real Tf(const Integer aFaceId);
 
             CGeoVector<Real> gradT(const Integer aControlVolumeId);
+
+            ENigMA::sle::CSleSolver<Real>& temperatureSolver();
             
         };
 
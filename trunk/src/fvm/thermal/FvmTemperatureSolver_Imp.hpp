@@ -18,28 +18,22 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CFvmTemperatureSolver<Real>::CFvmTemperatureSolver(CFvmMesh<Real>& aFvmMesh) : CFvmPisoSolver(aFvmMesh)
+        CFvmTemperatureSolver<Real>::CFvmTemperatureSolver(CFvmMesh<Real>& aFvmMesh) : CFvmPisoSolver<Real>(aFvmMesh)
         {
 
-            m_bthcond = 1.0;
-
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
-            {
-
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
-
-                m_T0[aControlVolumeId] = m_T[aControlVolumeId] = 0.0;
+            m_calcT = true;
 
-            }
+            m_bthcond = 1.0;
 
-            for (Integer i = 0; i < m_fvmMesh.nbFaces(); ++i)
-            {
+            const Integer nbControlVolumes = this->m_fvmMesh.nbControlVolumes();
 
-                Integer aFaceId = m_fvmMesh.faceId(i);
+            m_thcond.assign(nbControlVolumes, 0.0);
+            m_spheat.assign(nbControlVolumes, 0.0);
 
-                m_Tf[aFaceId] = 0.0;
+            m_T0.assign(nbControlVolumes, 0.0);
+            m_T.assign(nbControlVolumes, 0.0);
 
-            }
+            m_Tf.assign(this->m_fvmMesh.nbFaces(), 0.0);
 
         }
 
@@ -53,7 +47,7 @@ namespace ENigMA
         void CFvmTemperatureSolver<Real>::storePreviousQuantities()
         {
 
-            CFvmPisoSolver::storePreviousQuantities();
+            CFvmPisoSolver<Real>::storePreviousQuantities();
 
             m_T0 = m_T;
 
@@ -63,17 +57,10 @@ namespace ENigMA
         void CFvmTemperatureSolver<Real>::setMaterialProperties(const Real aDensity, const Real aViscosity, const Real aThermalConductivity, const Real aSpecificHeat)
         {
 
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
-            {
-
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+            CFvmPisoSolver<Real>::setMaterialProperties(aDensity, aViscosity);
 
-                m_dens[aControlVolumeId] = aDensity;
-                m_visc[aControlVolumeId] = aViscosity;
-                m_thcond[aControlVolumeId] = aThermalConductivity;
-                m_spheat[aControlVolumeId] = aSpecificHeat;
-
-            }
+            std::fill(m_thcond.begin(), m_thcond.end(), aThermalConductivity);
+            std::fill(m_spheat.begin(), m_spheat.end(), aSpecificHeat);
 
         }
 
@@ -86,9 +73,9 @@ namespace ENigMA
 
                 Integer aFaceId = sFaceIds[i];
 
-                m_Tf[aFaceId] = T;
+                m_Tf[this->m_faceIndices[aFaceId]] = T;
 
-                m_fvmMesh.face(aFaceId).setBoundaryType(sFaceType);
+                this->setFaceBoundaryType(aFaceId, sFaceType);
 
             }
 
@@ -98,122 +85,152 @@ namespace ENigMA
         void CFvmTemperatureSolver<Real>::calculateTemperatureField()
         {
 
+            CFvmMesh<Real>& aFvmMesh = this->m_fvmMesh;
+
+            const Integer nbControlVolumes = aFvmMesh.nbControlVolumes();
+
             Eigen::SparseMatrix<Real> A;
             Eigen::Matrix<Real, Eigen::Dynamic, 1> b;
 
-            A.resize(m_fvmMesh.nbControlVolumes(), m_fvmMesh.nbControlVolumes());
-            A.reserve(m_fvmMesh.nbControlVolumes());
+            std::vector<Eigen::Triplet<Real> > sCoefficients;
+            sCoefficients.reserve(nbControlVolumes + 4 * aFvmMesh.nbFaces());
 
-            b.resize(m_fvmMesh.nbControlVolumes());
+            A.resize(nbControlVolumes, nbControlVolumes);
+
+            b.resize(nbControlVolumes);
             b.setZero();
 
-            // Assemble temperature matrix
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
+            // Assemble temperature matrix - face contributions
+            for (Integer i = 0; i < aFvmMesh.nbFaces(); ++i)
             {
 
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
-
-                Real volume = m_fvmMesh.controlVolume(aControlVolumeId).originalVolume();
+                Integer anIndexO = aFvmMesh.faceOwner(i);
+                Integer anIndexN = aFvmMesh.faceNeighbor(i);
 
-                Integer anIndexP = m_mapIdToIndex[aControlVolumeId];
+                Real area = aFvmMesh.faceArea(i);
+                Real dist = aFvmMesh.faceOwnerDist(i);
 
-                Real dens = m_dens[aControlVolumeId];
-                Real visc = m_visc[aControlVolumeId];
-                Real thcond = m_thcond[aControlVolumeId];
-                Real spheat = m_spheat[aControlVolumeId];
+                Real flux = this->m_flux[i];
 
-                for (Integer j = 0; j < m_fvmMesh.controlVolume(aControlVolumeId).nbFaces(); ++j)
+                if (anIndexN >= 0)
                 {
 
-                    Integer aFaceId = m_fvmMesh.controlVolume(aControlVolumeId).faceId(j);
+                    dist += aFvmMesh.faceNeighborDist(i);
 
-                    Real area = m_fvmMesh.controlVolume(aControlVolumeId).faceArea(aFaceId);
-                    Real dist = m_fvmMesh.controlVolume(aControlVolumeId).faceDist(aFaceId);
+                    Real dens = this->m_dens[anIndexO]; dens += this->m_dens[anIndexN]; dens *= 0.5;
+                    Real thcond = m_thcond[anIndexO]; thcond += m_thcond[anIndexN]; thcond *= 0.5;
+                    Real spheat = m_spheat[anIndexO]; spheat += m_spheat[anIndexN]; spheat *= 0.5;
 
-                    Real flux;
+                    // Conduction 
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, thcond * area / dist));
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexN, -thcond * area / dist));
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexN, anIndexN, thcond * area / dist));
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexN, anIndexO, -thcond * area / dist));
 
-                    if (m_fvmMesh.face(aFaceId).controlVolumeId() == aControlVolumeId)
-                        flux = +m_flux[aFaceId];
+                    // Convection - the upwind cell carries the face value
+                    if (flux > 0.0)
+                    {
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, dens * spheat * flux));
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexN, anIndexO, -dens * spheat * flux));
+                    }
                     else
-                        flux = -m_flux[aFaceId];
-
-                    if (m_fvmMesh.face(aFaceId).hasPair())
                     {
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexN, dens * spheat * flux));
+                        sCoefficients.push_back(Eigen::Triplet<Real>(anIndexN, anIndexN, -dens * spheat * flux));
+                    }
 
-                        Integer aNeighborId = m_fvmMesh.face(aFaceId).neighborId(aControlVolumeId);
+                }
+                else
+                {
 
-                        Integer anIndexN = m_mapIdToIndex[aNeighborId];
+                    Real volume = aFvmMesh.originalVolume(anIndexO);
 
-                        if (m_fvmMesh.controlVolume(aNeighborId).containsFace(aFaceId))
-                        {
+                    Real dens = this->m_dens[anIndexO];
+                    Real thcond = m_thcond[anIndexO]; thcond += m_bthcond; thcond *= 0.5;
+                    Real spheat = m_spheat[anIndexO];
 
-                            area += m_fvmMesh.controlVolume(aNeighborId).faceArea(aFaceId); area *= 0.5;
-                            dist += m_fvmMesh.controlVolume(aNeighborId).faceDist(aFaceId);
+                    // Conduction
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, thcond * area / dist));
+                    b[anIndexO] += thcond * area / dist / volume * m_Tf[i];
 
-                            dens += m_dens[aNeighborId]; dens *= 0.5;
-                            thcond += m_thcond[aNeighborId]; thcond *= 0.5;
-                            spheat += m_spheat[aNeighborId]; spheat *= 0.5;
+                    // Convection
+                    Real xsi;
+                    if (flux > 0.0) xsi = 0.0; else xsi = 1.0; // UPWIND
 
-                            // Conduction 
-                            A.coeffRef(anIndexP, anIndexP) += thcond * area / dist;
-                            A.coeffRef(anIndexP, anIndexN) += -thcond * area / dist;
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexO, anIndexO, (1.0 - xsi) * dens * spheat * flux));
+                    b[anIndexO] += -xsi * dens * spheat * flux * m_Tf[i];
 
-                            // Convection
-                            Real xsi;
-                            if (flux > 0.0) xsi = 0.0; else xsi = 1.0; // UPWIND
+                }
 
-                            A.coeffRef(anIndexP, anIndexP) += (1.0 - xsi) * dens * spheat * flux;
-                            A.coeffRef(anIndexP, anIndexN) += xsi * dens * spheat * flux;
+            }
 
-                        }
+            if (this->m_dt > 0)
+            {
 
-                    }
-                    else
-                    {
+                for (Integer anIndexP = 0; anIndexP < nbControlVolumes; ++anIndexP)
+                {
 
-                        thcond += m_bthcond; thcond *= 0.5;
+                    Real volume = aFvmMesh.originalVolume(anIndexP);
 
-                        // Conduction
-                        A.coeffRef(anIndexP, anIndexP) += thcond * area / dist;
-                        b[anIndexP] += thcond * area / dist / volume * m_Tf[aFaceId];
+                    Real dens = this->m_dens[anIndexP];
+                    Real spheat = m_spheat[anIndexP];
 
-                        // Convection
-                        Real xsi;
-                        if (flux > 0.0) xsi = 0.0; else xsi = 1.0; // UPWIND
+                    // Unsteady term - Euler 
+                    sCoefficients.push_back(Eigen::Triplet<Real>(anIndexP, anIndexP, volume * spheat * dens / this->m_dt));
+                    b[anIndexP] += volume * spheat * dens / this->m_dt * m_T0[anIndexP];
 
-                        A.coeffRef(anIndexP, anIndexP) += (1.0 - xsi) * dens * spheat * flux;
-                        b[anIndexP] += -xsi * dens * spheat * flux * m_Tf[aFaceId];
+                }
 
-                    }
+            }
 
-                }
+            A.setFromTriplets(sCoefficients.begin(), sCoefficients.end());
 
-                if (m_dt > 0)
-                {
+            Eigen::Matrix<Real, Eigen::Dynamic, 1> T = m_temperatureSolver.solve(ENigMA::sle::MT_SPARSE, A, b);
 
-                    // Unsteady term - Euler 
-                    A.coeffRef(anIndexP, anIndexP) += volume * spheat * dens / m_dt;
-                    b[anIndexP] += volume * spheat * dens / m_dt * m_T0[aControlVolumeId];
+            for (int i = 0; i < T.rows(); ++i)
+                m_T[i] = T[i];
 
-                }
+        }
 
-            }
+        template <typename Real>
+        void CFvmTemperatureSolver<Real>::writeState(CFvmCheckpoint<Real>& aCheckpoint)
+        {
 
-            A.finalize();
+            CFvmPisoSolver<Real>::writeState(aCheckpoint);
 
-            Eigen::BiCGSTAB<Eigen::SparseMatrix<Real> > solver;
-            solver.compute(A);
+            aCheckpoint.beginBlock("TEMPERATURE");
 
-            Eigen::Matrix<Real, Eigen::Dynamic, 1> T = solver.solve(b);
+            aCheckpoint.write(m_calcT);
+            aCheckpoint.write(m_bthcond);
 
-            for (int i = 0; i < T.rows(); ++i)
-            {
+            aCheckpoint.write(m_thcond);
+            aCheckpoint.write(m_spheat);
 
-                Integer aControlVolumeId = m_mapIndexToId[i];
+            aCheckpoint.write(m_T0);
+            aCheckpoint.write(m_T);
+            aCheckpoint.write(m_Tf);
 
-                m_T[aControlVolumeId] = T[i];
+            aCheckpoint.endBlock();
 
-            }
+        }
+
+        template <typename Real>
+        bool CFvmTemperatureSolver<Real>::readState(CFvmCheckpoint<Real>& aCheckpoint)
+        {
+
+            if (!CFvmPisoSolver<Real>::readState(aCheckpoint))
+                return false;
+
+            if (!aCheckpoint.openBlock("TEMPERATURE"))
+                return false;
+
+            return aCheckpoint.read(m_calcT) &&
+                aCheckpoint.read(m_bthcond) &&
+                aCheckpoint.read(m_thcond) &&
+                aCheckpoint.read(m_spheat) &&
+                aCheckpoint.read(m_T0) &&
+                aCheckpoint.read(m_T) &&
+                aCheckpoint.read(m_Tf);
 
         }
 
@@ -221,7 +238,7 @@ namespace ENigMA
         void CFvmTemperatureSolver<Real>::iterate(const Real dt, const bool bInit)
         {
 
-            CFvmPisoSolver::iterate(dt, bInit);
+            CFvmPisoSolver<Real>::iterate(dt, bInit);
 
             this->calculateTemperatureField();
 
@@ -231,24 +248,12 @@ namespace ENigMA
         void CFvmTemperatureSolver<Real>::residual(Real& ru, Real& rv, Real& rw, Real& rp, Real &rT)
         {
 
-            ru = 0;
-            rv = 0;
-            rw = 0;
-            rp = 0;
-            rT = 0;
-
-            for (Integer i = 0; i < m_fvmMesh.nbControlVolumes(); ++i)
-            {
-
-                Integer aControlVolumeId = m_fvmMesh.controlVolumeId(i);
+            CFvmPisoSolver<Real>::residual(ru, rv, rw, rp);
 
-                ru += (m_u[aControlVolumeId] - m_u0[aControlVolumeId]) * (m_u[aControlVolumeId] - m_u0[aControlVolumeId]);
-                rv += (m_v[aControlVolumeId] - m_v0[aControlVolumeId]) * (m_v[aControlVolumeId] - m_v0[aControlVolumeId]);
-                rw += (m_w[aControlVolumeId] - m_w0[aControlVolumeId]) * (m_w[aControlVolumeId] - m_w0[aControlVolumeId]);
-                rp += (m_p[aControlVolumeId] - m_p0[aControlVolumeId]) * (m_p[aControlVolumeId] - m_p0[aControlVolumeId]);
-                rT += (m_T[aControlVolumeId] - m_T0[aControlVolumeId]) * (m_T[aControlVolumeId] - m_T0[aControlVolumeId]);
+            rT = 0;
 
-            }
+            for (Integer i = 0; i < static_cast<Integer> (m_T.size()); ++i)
+                rT += (m_T[i] - m_T0[i]) * (m_T[i] - m_T0[i]);
 
         }
 
@@ -256,7 +261,7 @@ namespace ENigMA
         Real CFvmTemperatureSolver<Real>::T(const Integer aControlVolumeId)
         {
 
-            return m_T[aControlVolumeId];
+            return m_T[this->m_controlVolumeIndices[aControlVolumeId]];
 
         }
 
@@ -264,7 +269,7 @@ namespace ENigMA
         Real CFvmTemperatureSolver<Real>::Tf(const Integer aFaceId)
         {
 
-            return m_Tf[aFaceId];
+            return m_Tf[this->m_faceIndices[aFaceId]];
 
         }
 
@@ -272,7 +277,15 @@ namespace ENigMA
         CGeoVector<Real> CFvmTemperatureSolver<Real>::gradT(const Integer aControlVolumeId)
         {
 
-            return this->gradient(m_T, m_Tf, aControlVolumeId);
+            return this->gradient(m_T, m_Tf, this->m_controlVolumeIndices[aControlVolumeId]);
+
+        }
+
+        template <typename Real>
+        ENigMA::sle::CSleSolver<Real>& CFvmTemperatureSolver<Real>::temperatureSolver()
+        {
+
+            return m_temperatureSolver;
 
         }
 
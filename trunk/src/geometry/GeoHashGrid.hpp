@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "GeoCoordinate.hpp"
@@ -32,11 +33,34 @@ namespace ENigMA
             std::vector<Integer> m_coordinateList;
             std::vector<Integer> m_coordinateListPtr;
 
+            // Coordinates and ids in cell order, scanned contiguously by the queries
+            std::vector<Real> m_coordinateX, m_coordinateY, m_coordinateZ;
+            std::vector<Integer> m_coordinateIds;
+
             CGeoBoundingBox<Real> m_boundingBox;
 
             CGeoVector<Real> m_adOrig;
             CGeoVector<Real> m_adDelta;
 
+            // Buffers kept between queries
+            std::vector<std::pair<Real, Integer> > m_nearest;
+            std::vector<std::vector<Integer> > m_threadIds;
+            std::vector<std::vector<std::pair<Real, Integer> > > m_threadNearest;
+            std::vector<Integer> m_threadFirst;
+
+            void initThreads();
+            Integer threadId();
+
+            void cellIndex(const Real x, const Real y, const Real z, Integer& i, Integer& j, Integer& k);
+
+            void scanCell(const Integer ie, const CGeoCoordinate<Real>& aCoordinate, const Real aTolerance, std::vector<Integer>& coordinateIds);
+            void scanCellNearest(const Integer ie, const CGeoCoordinate<Real>& aCoordinate, const Integer nbNearest, std::vector<std::pair<Real, Integer> >& sNearest);
+
+            void findInRadius(const CGeoCoordinate<Real>& aCoordinate, const Real aTolerance, std::vector<Integer>& coordinateIds);
+            void findNearestInShells(const CGeoCoordinate<Real>& aCoordinate, const Integer nbNearest, std::vector<std::pair<Real, Integer> >& sNearest);
+
+            void gatherThreads(const Integer nbCoordinates, std::vector<Integer>& sOffsets, std::vector<Integer>& coordinateIds);
+
         public:
             CGeoHashGrid();
             ~CGeoHashGrid();
@@ -46,6 +70,10 @@ namespace ENigMA
             void build();
 
             void find(std::vector<Integer>& coordinateIds, CGeoCoordinate<Real>& aCoordinate, const Real aTolerance = 0.0);
+            void find(const std::vector<CGeoCoordinate<Real> >& sCoordinates, std::vector<Integer>& sOffsets, std::vector<Integer>& coordinateIds, const Real aTolerance = 0.0);
+
+            void findNearest(std::vector<Integer>& coordinateIds, const CGeoCoordinate<Real>& aCoordinate, const Integer nbNearest);
+            void findNearest(const std::vector<CGeoCoordinate<Real> >& sCoordinates, std::vector<Integer>& sOffsets, std::vector<Integer>& coordinateIds, const Integer nbNearest);
 
         };
 
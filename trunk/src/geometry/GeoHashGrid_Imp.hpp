@@ -9,6 +9,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace ENigMA
 {
 
@@ -16,7 +23,7 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CGeoHashGrid<Real>::CGeoHashGrid() : m_nbCellsX(0), m_nbCellsY(0), m_nbCellsZ(0), m_nbCellsXY(0)
+        CGeoHashGrid<Real>::CGeoHashGrid() : m_nbCellsX(0), m_nbCellsY(0), m_nbCellsZ(0), m_nbCellsXY(0), m_nbCells(0)
         {
 
             m_adOrig.resize(3);
@@ -39,6 +46,11 @@ namespace ENigMA
             m_coordinateList.clear();
             m_coordinateListPtr.clear();
 
+            m_coordinateX.clear();
+            m_coordinateY.clear();
+            m_coordinateZ.clear();
+            m_coordinateIds.clear();
+
         }
 
         template <typename Real>
@@ -172,6 +184,27 @@ namespace ENigMA
 
                 }
 
+                // Copy the points in cell order
+                const Integer nbCoordinates = static_cast<Integer>(m_coordinateList.size());
+
+                m_coordinateX.resize(nbCoordinates);
+                m_coordinateY.resize(nbCoordinates);
+                m_coordinateZ.resize(nbCoordinates);
+                m_coordinateIds.resize(nbCoordinates);
+
+                for (Integer iptr = 0; iptr < nbCoordinates; ++iptr)
+                {
+
+                    Integer aCoordinateIndex = m_coordinateList[iptr];
+
+                    m_coordinateX[iptr] = CGeoContainer<CGeoCoordinate<Real>, Real>::m_geometricObjects[aCoordinateIndex].x();
+                    m_coordinateY[iptr] = CGeoContainer<CGeoCoordinate<Real>, Real>::m_geometricObjects[aCoordinateIndex].y();
+                    m_coordinateZ[iptr] = CGeoContainer<CGeoCoordinate<Real>, Real>::m_geometricObjects[aCoordinateIndex].z();
+
+                    m_coordinateIds[iptr] = CGeoContainer<CGeoCoordinate<Real>, Real>::m_geometricObjectIds[aCoordinateIndex];
+
+                }
+
             }
             catch (const std::exception& e)
             {
@@ -185,81 +218,266 @@ namespace ENigMA
         }
 
         template <typename Real>
-        void CGeoHashGrid<Real>::find(std::vector<Integer>& coordinateIds, CGeoCoordinate<Real>& aCoordinate, const Real aTolerance)
+        void CGeoHashGrid<Real>::initThreads()
         {
 
-            try
+            Integer nbThreads = 1;
+
+#ifdef _OPENMP
+            nbThreads = omp_get_max_threads();
+#endif
+
+            m_threadIds.resize(nbThreads);
+            m_threadNearest.resize(nbThreads);
+            m_threadFirst.assign(nbThreads, -1);
+
+            for (Integer t = 0; t < nbThreads; ++t)
+                m_threadIds[t].clear();
+
+        }
+
+        template <typename Real>
+        Integer CGeoHashGrid<Real>::threadId()
+        {
+
+#ifdef _OPENMP
+            return omp_get_thread_num();
+#else
+            return 0;
+#endif
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::cellIndex(const Real x, const Real y, const Real z, Integer& i, Integer& j, Integer& k)
+        {
+
+            Real dRm1DeltaX = 1.0 / m_adDelta[0];
+            Real dRm1DeltaY = 1.0 / m_adDelta[1];
+            Real dRm1DeltaZ = 1.0 / m_adDelta[2];
+
+            // Find in which bucket this point falls
+            Real di = (x - m_adOrig[0]) * dRm1DeltaX;
+            Real dj = (y - m_adOrig[1]) * dRm1DeltaY;
+            Real dk = (z - m_adOrig[2]) * dRm1DeltaZ;
+
+            i = static_cast<Integer>(std::min(std::max(di, static_cast<Real>(std::numeric_limits<Integer>::min())), static_cast<Real>(std::numeric_limits<Integer>::max())));
+            j = static_cast<Integer>(std::min(std::max(dj, static_cast<Real>(std::numeric_limits<Integer>::min())), static_cast<Real>(std::numeric_limits<Integer>::max())));
+            k = static_cast<Integer>(std::min(std::max(dk, static_cast<Real>(std::numeric_limits<Integer>::min())), static_cast<Real>(std::numeric_limits<Integer>::max())));
+
+            // Bound this value with correct values
+            i = std::min(std::max(0, i), static_cast<Integer> (m_nbCellsX - 1));
+            j = std::min(std::max(0, j), static_cast<Integer> (m_nbCellsY - 1));
+            k = std::min(std::max(0, k), static_cast<Integer> (m_nbCellsZ - 1));
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::scanCell(const Integer ie, const CGeoCoordinate<Real>& aCoordinate, const Real aTolerance, std::vector<Integer>& coordinateIds)
+        {
+
+            const Real x = aCoordinate.x();
+            const Real y = aCoordinate.y();
+            const Real z = aCoordinate.z();
+
+            // Ptrs to start and end nodes in this cell
+            const Integer ip_start = m_coordinateListPtr[ie];
+            const Integer ip_end = m_coordinateListPtr[ie + 1];
+
+            for (Integer iptr = ip_start; iptr < ip_end; iptr++)
             {
 
-                Real dRm1DeltaX = 1.0 / m_adDelta[0];
-                Real dRm1DeltaY = 1.0 / m_adDelta[1];
-                Real dRm1DeltaZ = 1.0 / m_adDelta[2];
+                Real dx = m_coordinateX[iptr] - x;
+                Real dy = m_coordinateY[iptr] - y;
+                Real dz = m_coordinateZ[iptr] - z;
+
+                if (std::sqrt(dx * dx + dy * dy + dz * dz) <= aTolerance)
+                    coordinateIds.push_back(m_coordinateIds[iptr]);
+
+            }
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::scanCellNearest(const Integer ie, const CGeoCoordinate<Real>& aCoordinate, const Integer nbNearest, std::vector<std::pair<Real, Integer> >& sNearest)
+        {
+
+            const Real x = aCoordinate.x();
+            const Real y = aCoordinate.y();
+            const Real z = aCoordinate.z();
+
+            const Integer ip_start = m_coordinateListPtr[ie];
+            const Integer ip_end = m_coordinateListPtr[ie + 1];
+
+            // Max heap on distance of the best candidates so far
+            for (Integer iptr = ip_start; iptr < ip_end; iptr++)
+            {
+
+                Real dx = m_coordinateX[iptr] - x;
+                Real dy = m_coordinateY[iptr] - y;
+                Real dz = m_coordinateZ[iptr] - z;
+
+                std::pair<Real, Integer> aCandidate(dx * dx + dy * dy + dz * dz, iptr);
+
+                if (static_cast<Integer>(sNearest.size()) < nbNearest)
+                {
+                    sNearest.push_back(aCandidate);
+                    std::push_heap(sNearest.begin(), sNearest.end());
+                }
+                else if (aCandidate < sNearest.front())
+                {
+                    std::pop_heap(sNearest.begin(), sNearest.end());
+                    sNearest.back() = aCandidate;
+                    std::push_heap(sNearest.begin(), sNearest.end());
+                }
+
+            }
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::findInRadius(const CGeoCoordinate<Real>& aCoordinate, const Real aTolerance, std::vector<Integer>& coordinateIds)
+        {
+
+            if (m_coordinateIds.empty())
+                return;
+
+            // Cells intersecting the cube around the point
+            Integer imin, jmin, kmin;
+            Integer imax, jmax, kmax;
+
+            this->cellIndex(aCoordinate.x() - aTolerance, aCoordinate.y() - aTolerance, aCoordinate.z() - aTolerance, imin, jmin, kmin);
+            this->cellIndex(aCoordinate.x() + aTolerance, aCoordinate.y() + aTolerance, aCoordinate.z() + aTolerance, imax, jmax, kmax);
+
+            for (Integer i = imin; i <= imax; ++i)
+            {
+
+                for (Integer j = jmin; j <= jmax; ++j)
+                {
+
+                    Integer j_off = j * m_nbCellsX;
+
+                    for (Integer k = kmin; k <= kmax; ++k)
+                        this->scanCell(i + j_off + k * m_nbCellsXY, aCoordinate, aTolerance, coordinateIds);
+
+                }
+
+            }
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::findNearestInShells(const CGeoCoordinate<Real>& aCoordinate, const Integer nbNearest, std::vector<std::pair<Real, Integer> >& sNearest)
+        {
+
+            sNearest.clear();
+
+            if (m_coordinateIds.empty() || nbNearest <= 0)
+                return;
+
+            Integer ci, cj, ck;
+
+            this->cellIndex(aCoordinate.x(), aCoordinate.y(), aCoordinate.z(), ci, cj, ck);
+
+            const Integer nbShells = std::max(std::max(std::max(ci, m_nbCellsX - 1 - ci), std::max(cj, m_nbCellsY - 1 - cj)), std::max(ck, m_nbCellsZ - 1 - ck));
+
+            // Visit cells in shells of growing Chebyshev distance around the cell of the point
+            for (Integer s = 0; s <= nbShells; ++s)
+            {
+
+                const Integer imin = std::max(ci - s, 0);
+                const Integer imax = std::min(ci + s, m_nbCellsX - 1);
+                const Integer jmin = std::max(cj - s, 0);
+                const Integer jmax = std::min(cj + s, m_nbCellsY - 1);
 
-                // Find cell where node falls - build a cube around the node
-                Real dXMin = aCoordinate.x() - aTolerance;
-                Real dYMin = aCoordinate.y() - aTolerance;
-                Real dZMin = aCoordinate.z() - aTolerance;
-
-                // Find in which bucket this point falls
-                Integer imin = static_cast<Integer> ((dXMin - m_adOrig[0]) * dRm1DeltaX > std::numeric_limits<Integer>::min() ? (dXMin - m_adOrig[0]) * dRm1DeltaX : std::numeric_limits<Integer>::min());
-                Integer jmin = static_cast<Integer> ((dYMin - m_adOrig[1]) * dRm1DeltaY > std::numeric_limits<Integer>::min() ? (dYMin - m_adOrig[1]) * dRm1DeltaY : std::numeric_limits<Integer>::min());
-                Integer kmin = static_cast<Integer> ((dZMin - m_adOrig[2]) * dRm1DeltaZ > std::numeric_limits<Integer>::min() ? (dZMin - m_adOrig[2]) * dRm1DeltaZ : std::numeric_limits<Integer>::min());
-
-                // Bound this value with correct values
-                imin = std::min(std::max(0, imin), static_cast<Integer> (m_nbCellsX - 1));
-                jmin = std::min(std::max(0, jmin), static_cast<Integer> (m_nbCellsY - 1));
-                kmin = std::min(std::max(0, kmin), static_cast<Integer> (m_nbCellsZ - 1));
-
-                Real dXMax = aCoordinate.x() + aTolerance;
-                Real dYMax = aCoordinate.y() + aTolerance;
-                Real dZMax = aCoordinate.z() + aTolerance;
-
-                // Find in which bucket this point falls
-                Integer imax = static_cast<Integer> ((dXMax - m_adOrig[0]) * dRm1DeltaX < std::numeric_limits<Integer>::max() ? (dXMax - m_adOrig[0]) * dRm1DeltaX : std::numeric_limits<Integer>::max());
-                Integer jmax = static_cast<Integer> ((dYMax - m_adOrig[1]) * dRm1DeltaY < std::numeric_limits<Integer>::max() ? (dYMax - m_adOrig[1]) * dRm1DeltaY : std::numeric_limits<Integer>::max());
-                Integer kmax = static_cast<Integer> ((dZMax - m_adOrig[2]) * dRm1DeltaZ < std::numeric_limits<Integer>::max() ? (dZMax - m_adOrig[2]) * dRm1DeltaZ : std::numeric_limits<Integer>::max());
-
-                // Bound this value with correct values
-                imax = std::min(std::max(0, imax), static_cast<Integer> (m_nbCellsX - 1));
-                jmax = std::min(std::max(0, jmax), static_cast<Integer> (m_nbCellsY - 1));
-                kmax = std::min(std::max(0, kmax), static_cast<Integer> (m_nbCellsZ - 1));
-
-                // Loop over cells Intersecting node Bounding Box
-                for (int i = imin; i <= imax; ++i)
+                for (Integer i = imin; i <= imax; ++i)
                 {
 
-                    for (int j = jmin; j <= jmax; ++j)
+                    for (Integer j = jmin; j <= jmax; ++j)
                     {
 
                         Integer j_off = j * m_nbCellsX;
 
-                        for (int k = kmin; k <= kmax; ++k)
+                        if (std::abs(i - ci) == s || std::abs(j - cj) == s)
+                        {
+                            for (Integer k = std::max(ck - s, 0); k <= std::min(ck + s, m_nbCellsZ - 1); ++k)
+                                this->scanCellNearest(i + j_off + k * m_nbCellsXY, aCoordinate, nbNearest, sNearest);
+                        }
+                        else
                         {
 
-                            Integer ie = i + j_off + k * m_nbCellsXY;
+                            if (ck - s >= 0)
+                                this->scanCellNearest(i + j_off + (ck - s) * m_nbCellsXY, aCoordinate, nbNearest, sNearest);
+
+                            if (ck + s <= m_nbCellsZ - 1)
+                                this->scanCellNearest(i + j_off + (ck + s) * m_nbCellsXY, aCoordinate, nbNearest, sNearest);
 
-                            // Ptrs to start and end nodes in this cell
-                            Integer ip_start = m_coordinateListPtr[ie];
-                            Integer ip_end = m_coordinateListPtr[ie + 1];
+                        }
 
-                            // Loop over points in these cells
-                            for (Integer iptr = ip_start; iptr < ip_end; iptr++)
-                            {
+                    }
 
-                                Integer aCoordinateIndex = m_coordinateList[iptr];
+                }
 
-                                Real dist = (CGeoContainer<CGeoCoordinate<Real>, Real>::m_geometricObjects[aCoordinateIndex] - aCoordinate).norm();
+                if (static_cast<Integer>(sNearest.size()) < nbNearest)
+                    continue;
 
-                                if (dist <= aTolerance)
-                                    coordinateIds.push_back(CGeoContainer<CGeoCoordinate<Real>, Real>::m_geometricObjectIds[aCoordinateIndex]);
+                // Points outside the visited block are at least as far as its closest open face
+                Real dmin = std::numeric_limits<Real>::max();
 
-                            }
+                for (Integer d = 0; d < 3; ++d)
+                {
 
-                        }
+                    Integer c = (d == 0) ? ci : (d == 1) ? cj : ck;
+                    Integer n = (d == 0) ? m_nbCellsX : (d == 1) ? m_nbCellsY : m_nbCellsZ;
 
-                    }
+                    if (c - s > 0)
+                        dmin = std::min(dmin, aCoordinate[d] - (m_adOrig[d] + (c - s) * m_adDelta[d]));
+
+                    if (c + s < n - 1)
+                        dmin = std::min(dmin, (m_adOrig[d] + (c + s + 1) * m_adDelta[d]) - aCoordinate[d]);
 
                 }
+
+                if (dmin == std::numeric_limits<Real>::max() || (dmin > 0 && sNearest.front().first <= dmin * dmin))
+                    break;
+
+            }
+
+            std::sort_heap(sNearest.begin(), sNearest.end());
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::gatherThreads(const Integer nbCoordinates, std::vector<Integer>& sOffsets, std::vector<Integer>& coordinateIds)
+        {
+
+            for (Integer q = 0; q < nbCoordinates; ++q)
+                sOffsets[q + 1] += sOffsets[q];
+
+            coordinateIds.resize(sOffsets[nbCoordinates]);
+
+            // Static schedules hand out contiguous blocks, each thread buffer holds the results of one block in order
+            for (Integer t = 0; t < static_cast<Integer>(m_threadIds.size()); ++t)
+            {
+
+                if (m_threadFirst[t] < 0)
+                    continue;
+
+                std::copy(m_threadIds[t].begin(), m_threadIds[t].end(), coordinateIds.begin() + sOffsets[m_threadFirst[t]]);
+
+            }
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::find(std::vector<Integer>& coordinateIds, CGeoCoordinate<Real>& aCoordinate, const Real aTolerance)
+        {
+
+            try
+            {
+
+                this->findInRadius(aCoordinate, aTolerance, coordinateIds);
+
             }
             catch (const std::exception& e)
             {
@@ -272,6 +490,92 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        void CGeoHashGrid<Real>::find(const std::vector<CGeoCoordinate<Real> >& sCoordinates, std::vector<Integer>& sOffsets, std::vector<Integer>& coordinateIds, const Real aTolerance)
+        {
+
+            const Integer nbCoordinates = static_cast<Integer>(sCoordinates.size());
+
+            this->initThreads();
+
+            sOffsets.assign(nbCoordinates + 1, 0);
+
+            #pragma omp parallel
+            {
+
+                const Integer t = this->threadId();
+
+                #pragma omp for schedule(static)
+                for (Integer q = 0; q < nbCoordinates; ++q)
+                {
+
+                    if (m_threadFirst[t] < 0)
+                        m_threadFirst[t] = q;
+
+                    Integer nbFound = static_cast<Integer>(m_threadIds[t].size());
+
+                    this->findInRadius(sCoordinates[q], aTolerance, m_threadIds[t]);
+
+                    sOffsets[q + 1] = static_cast<Integer>(m_threadIds[t].size()) - nbFound;
+
+                }
+
+            }
+
+            this->gatherThreads(nbCoordinates, sOffsets, coordinateIds);
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::findNearest(std::vector<Integer>& coordinateIds, const CGeoCoordinate<Real>& aCoordinate, const Integer nbNearest)
+        {
+
+            coordinateIds.clear();
+
+            this->findNearestInShells(aCoordinate, nbNearest, m_nearest);
+
+            for (Integer n = 0; n < static_cast<Integer>(m_nearest.size()); ++n)
+                coordinateIds.push_back(m_coordinateIds[m_nearest[n].second]);
+
+        }
+
+        template <typename Real>
+        void CGeoHashGrid<Real>::findNearest(const std::vector<CGeoCoordinate<Real> >& sCoordinates, std::vector<Integer>& sOffsets, std::vector<Integer>& coordinateIds, const Integer nbNearest)
+        {
+
+            const Integer nbCoordinates = static_cast<Integer>(sCoordinates.size());
+
+            this->initThreads();
+
+            sOffsets.assign(nbCoordinates + 1, 0);
+
+            #pragma omp parallel
+            {
+
+                const Integer t = this->threadId();
+
+                #pragma omp for schedule(static)
+                for (Integer q = 0; q < nbCoordinates; ++q)
+                {
+
+                    if (m_threadFirst[t] < 0)
+                        m_threadFirst[t] = q;
+
+                    this->findNearestInShells(sCoordinates[q], nbNearest, m_threadNearest[t]);
+
+                    for (Integer n = 0; n < static_cast<Integer>(m_threadNearest[t].size()); ++n)
+                        m_threadIds[t].push_back(m_coordinateIds[m_threadNearest[t][n].second]);
+
+                    sOffsets[q + 1] = static_cast<Integer>(m_threadNearest[t].size());
+
+                }
+
+            }
+
+            this->gatherThreads(nbCoordinates, sOffsets, coordinateIds);
+
+        }
+
     }
 
 }
@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "CmnTypes.hpp"
@@ -28,14 +30,8 @@ namespace ENigMA
         {
         private:
 
-            typedef std::map<Integer, CMshNode<Real> > mapNode;
-            typedef std::map<Integer, CMshFace<Real> > mapFace;
-            typedef std::map<Integer, CMshElement<Real> > mapElement;
-
-            typedef std::map<Integer, Integer> mapNodeIndex;
-            typedef std::map<Integer, Integer> mapFaceIndex;
-            typedef std::map<Integer, Integer> mapElementIndex;
-
+            // Entities are stored contiguously by index and located through dense id tables.
+            // Removed entities leave a free slot until the indices are rebuilt.
             std::vector<Integer> m_nodeIds;
             std::vector<Integer> m_faceIds;
             std::vector<Integer> m_elementIds;
@@ -44,13 +40,52 @@ namespace ENigMA
             Integer m_faceIndex;
             Integer m_elementIndex;
 
-            mapNodeIndex m_nodeIndices;
-            mapFaceIndex m_faceIndices;
-            mapElementIndex m_elementIndices;
+            std::vector<Integer> m_nodeIndices;
+            std::vector<Integer> m_faceIndices;
+            std::vector<Integer> m_elementIndices;
+
+            std::vector<CMshNode<Real> > m_nodes;
+            std::vector<CMshFace<Real> > m_faces;
+            std::vector<CMshElement<Real> > m_elements;
+
+            // Faces are matched by their sorted node ids
+            struct SFaceKey
+            {
+                Integer nodeIds[4];
+                Integer nbNodeIds;
+
+                bool operator== (const SFaceKey& aKey) const
+                {
+
+                    if (this->nbNodeIds != aKey.nbNodeIds)
+                        return false;
+
+                    for (Integer i = 0; i < this->nbNodeIds; ++i)
+                    {
+                        if (this->nodeIds[i] != aKey.nodeIds[i])
+                            return false;
+                    }
+
+                    return true;
+
+                }
+
+            };
+
+            struct SFaceKeyHash
+            {
+                std::size_t operator() (const SFaceKey& aKey) const
+                {
+
+                    std::size_t aHash = static_cast<std::size_t>(aKey.nbNodeIds);
+
+                    for (Integer i = 0; i < aKey.nbNodeIds; ++i)
+                        aHash = aHash * 1000003 ^ static_cast<std::size_t>(aKey.nodeIds[i]);
+
+                    return aHash;
 
-            mapNode m_nodes;
-            mapFace m_faces;
-            mapElement m_elements;
+                }
+            };
 
             Integer m_nbBoundaryFaces;
 
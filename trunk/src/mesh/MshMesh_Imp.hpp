@@ -95,7 +95,17 @@ namespace ENigMA
         void CMshMesh<Real>::addNode(const Integer aNodeId, const ENigMA::mesh::CMshNode<Real>& aNode)
         {
 
-            m_nodes[aNodeId] = aNode;
+            if (aNodeId >= static_cast<Integer> (m_nodeIndices.size()))
+                m_nodeIndices.resize(aNodeId + 1, -1);
+
+            // Existing ids are overwritten in place
+            if (m_nodeIndices[aNodeId] >= 0)
+            {
+                m_nodes[m_nodeIndices[aNodeId]] = aNode;
+                return;
+            }
+
+            m_nodes.push_back(aNode);
             m_nodeIds.push_back(aNodeId);
 
             m_nodeIndices[aNodeId] = m_nodeIndex;
@@ -107,7 +117,17 @@ namespace ENigMA
         void CMshMesh<Real>::addFace(const Integer aFaceId, const ENigMA::mesh::CMshFace<Real>& aFace)
         {
 
-            m_faces[aFaceId] = aFace;
+            if (aFaceId >= static_cast<Integer> (m_faceIndices.size()))
+                m_faceIndices.resize(aFaceId + 1, -1);
+
+            // Existing ids are overwritten in place
+            if (m_faceIndices[aFaceId] >= 0)
+            {
+                m_faces[m_faceIndices[aFaceId]] = aFace;
+                return;
+            }
+
+            m_faces.push_back(aFace);
             m_faceIds.push_back(aFaceId);
 
             m_faceIndices[aFaceId] = m_faceIndex;
@@ -119,7 +139,17 @@ namespace ENigMA
         void CMshMesh<Real>::addElement(const Integer anElementId, const ENigMA::mesh::CMshElement<Real>& anElement)
         {
 
-            m_elements[anElementId] = anElement;
+            if (anElementId >= static_cast<Integer> (m_elementIndices.size()))
+                m_elementIndices.resize(anElementId + 1, -1);
+
+            // Existing ids are overwritten in place
+            if (m_elementIndices[anElementId] >= 0)
+            {
+                m_elements[m_elementIndices[anElementId]] = anElement;
+                return;
+            }
+
+            m_elements.push_back(anElement);
             m_elementIds.push_back(anElementId);
 
             m_elementIndices[anElementId] = m_elementIndex;
@@ -131,8 +161,15 @@ namespace ENigMA
         void CMshMesh<Real>::removeNode(const Integer aNodeId)
         {
 
-            m_nodes.erase(aNodeId);
-            m_nodeIndices.erase(aNodeId);
+            if (aNodeId >= static_cast<Integer> (m_nodeIndices.size()) || m_nodeIndices[aNodeId] < 0)
+                return;
+
+            m_nodes[m_nodeIndices[aNodeId]] = CMshNode<Real>();
+            m_nodeIndices[aNodeId] = -1;
+
+            while (!m_nodeIndices.empty() && m_nodeIndices.back() < 0)
+                m_nodeIndices.pop_back();
+
             m_nodeIds.erase(std::find(m_nodeIds.begin(), m_nodeIds.end(), aNodeId));
 
         }
@@ -141,8 +178,15 @@ namespace ENigMA
         void CMshMesh<Real>::removeFace(const Integer aFaceId)
         {
 
-            m_faces.erase(aFaceId);
-            m_faceIndices.erase(aFaceId);
+            if (aFaceId >= static_cast<Integer> (m_faceIndices.size()) || m_faceIndices[aFaceId] < 0)
+                return;
+
+            m_faces[m_faceIndices[aFaceId]] = CMshFace<Real>();
+            m_faceIndices[aFaceId] = -1;
+
+            while (!m_faceIndices.empty() && m_faceIndices.back() < 0)
+                m_faceIndices.pop_back();
+
             m_faceIds.erase(std::find(m_faceIds.begin(), m_faceIds.end(), aFaceId));
 
         }
@@ -151,8 +195,15 @@ namespace ENigMA
         void CMshMesh<Real>::removeElement(const Integer anElementId)
         {
 
-            m_elements.erase(anElementId);
-            m_elementIndices.erase(anElementId);
+            if (anElementId >= static_cast<Integer> (m_elementIndices.size()) || m_elementIndices[anElementId] < 0)
+                return;
+
+            m_elements[m_elementIndices[anElementId]] = CMshElement<Real>();
+            m_elementIndices[anElementId] = -1;
+
+            while (!m_elementIndices.empty() && m_elementIndices.back() < 0)
+                m_elementIndices.pop_back();
+
             m_elementIds.erase(std::find(m_elementIds.begin(), m_elementIds.end(), anElementId));
 
         }
@@ -204,7 +255,7 @@ namespace ENigMA
         ENigMA::mesh::CMshNode<Real>& CMshMesh<Real>::node(const Integer aNodeId)
         {
 
-            return m_nodes[aNodeId];
+            return m_nodes[m_nodeIndices[aNodeId]];
 
         }
 
@@ -212,7 +263,7 @@ namespace ENigMA
         ENigMA::mesh::CMshFace<Real>& CMshMesh<Real>::face(const Integer aFaceId)
         {
 
-            return m_faces[aFaceId];
+            return m_faces[m_faceIndices[aFaceId]];
 
         }
 
@@ -220,7 +271,7 @@ namespace ENigMA
         ENigMA::mesh::CMshElement<Real>& CMshMesh<Real>::element(const Integer anElementId)
         {
 
-            return m_elements[anElementId];
+            return m_elements[m_elementIndices[anElementId]];
 
         }
 
@@ -283,83 +334,176 @@ namespace ENigMA
 
             m_faceIndex = 0;
 
-            for (Integer i = 0; i < static_cast<Integer> (m_elementIds.size()); ++i)
+            Integer nbElements = static_cast<Integer> (m_elementIds.size());
+
+            std::vector<std::vector<CMshFace<Real> > > sElementFaces(nbElements);
+
+            #pragma omp parallel for if (nbElements > 1000)
+            for (Integer i = 0; i < nbElements; ++i)
+                m_elements[m_elementIndices[m_elementIds[i]]].generateFaces(sElementFaces[i]);
+
+            Integer nbFaces = 0;
+
+            for (Integer i = 0; i < nbElements; ++i)
+                nbFaces += static_cast<Integer> (sElementFaces[i].size());
+
+            m_faceIds.reserve(nbFaces);
+            m_faces.reserve(nbFaces);
+
+            for (Integer i = 0; i < nbElements; ++i)
             {
 
                 Integer anElementId = m_elementIds[i];
 
-                std::vector<CMshFace<Real> > sFaces;
-
-                m_elements[anElementId].generateFaces(sFaces);
+                std::vector<CMshFace<Real> >& sFaces = sElementFaces[i];
 
                 for (Integer j = 0; j < static_cast<Integer> (sFaces.size()); ++j)
                 {
                     sFaces[j].setElementId(anElementId);
                     Integer aFaceId = this->nextFaceId();
                     this->addFace(aFaceId, sFaces[j]);
-                    m_elements[anElementId].addFaceId(aFaceId);
+                    this->element(anElementId).addFaceId(aFaceId);
                 }
 
+                std::vector<CMshFace<Real> >().swap(sFaces);
+
             }
 
-            // Discover double faces
-            CGeoHashGrid<Real> aHashGrid;
+            // Build the face keys
+            std::vector<SFaceKey> sKeys(nbFaces);
 
-            std::vector<CGeoCoordinate<Real> > sCenterCoordinates;
+            #pragma omp parallel for if (nbFaces > 1000)
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
 
-            for (Integer i = 0; i < static_cast<Integer> (m_faceIds.size()); ++i)
+                CMshFace<Real>& aFace = m_faces[i];
+
+                SFaceKey& aKey = sKeys[i];
+
+                aKey.nbNodeIds = aFace.nbNodeIds();
+
+                // Larger faces are left to the geometric search
+                if (aKey.nbNodeIds > 4)
+                    continue;
+
+                for (Integer j = 0; j < aKey.nbNodeIds; ++j)
+                    aKey.nodeIds[j] = aFace.nodeId(j);
+
+                std::sort(aKey.nodeIds, aKey.nodeIds + aKey.nbNodeIds);
+
+            }
+
+            // Pair faces sharing the same nodes
+            std::unordered_map<SFaceKey, Integer, SFaceKeyHash> sOpenFaces;
+
+            sOpenFaces.reserve(nbFaces);
+
+            for (Integer i = 0; i < nbFaces; ++i)
             {
 
+                if (sKeys[i].nbNodeIds > 4)
+                    continue;
+
                 Integer aFaceId = m_faceIds[i];
 
-                CGeoCoordinate<Real> aCenterCoordinate(0.0, 0.0, 0.0);
+                typename std::unordered_map<SFaceKey, Integer, SFaceKeyHash>::iterator it = sOpenFaces.find(sKeys[i]);
+
+                if (it == sOpenFaces.end())
+                {
+                    sOpenFaces[sKeys[i]] = aFaceId;
+                    continue;
+                }
+
+                Integer aPairFaceId = it->second;
 
-                for (Integer j = 0; j < m_faces[aFaceId].nbNodeIds(); ++j)
+                if (m_faces[i].faceType() == this->face(aPairFaceId).faceType())
                 {
+                    m_faces[i].setPairFaceId(aPairFaceId);
+                    this->face(aPairFaceId).setPairFaceId(aFaceId);
+                    sOpenFaces.erase(it);
+                }
 
-                    Integer aNodeId = m_faces[aFaceId].nodeId(j);
-                    Integer aNodeIndex = m_nodeIndices[aNodeId];
+            }
 
-                    CMshNode<Real> aNode = m_nodes[aNodeIndex];
+            // Discover remaining double faces whose nodes have not been merged
+            CGeoHashGrid<Real> aHashGrid;
 
-                    aCenterCoordinate += aNode;
+            std::vector<Integer> sUnpairedFaceIds;
+            std::vector<CGeoCoordinate<Real> > sCenterCoordinates;
 
-                }
+            for (Integer i = 0; i < nbFaces; ++i)
+            {
 
-                if (m_faces[m_faceIds[i]].nbNodeIds() > 0)
-                    aCenterCoordinate /= static_cast<Real>(m_faces[aFaceId].nbNodeIds());
+                CMshFace<Real>& aFace = m_faces[i];
 
+                if (aFace.hasPair())
+                    continue;
+
+                Integer aFaceId = m_faceIds[i];
+
+                CGeoCoordinate<Real> aCenterCoordinate(0.0, 0.0, 0.0);
+
+                for (Integer j = 0; j < aFace.nbNodeIds(); ++j)
+                    aCenterCoordinate += this->node(aFace.nodeId(j));
+
+                if (aFace.nbNodeIds() > 0)
+                    aCenterCoordinate /= static_cast<Real>(aFace.nbNodeIds());
+
+                sUnpairedFaceIds.push_back(aFaceId);
                 sCenterCoordinates.push_back(aCenterCoordinate);
 
                 aHashGrid.addGeometricObject(aFaceId, aCenterCoordinate);
 
             }
 
-            aHashGrid.build();
+            std::vector<Integer> sOffsets;
+            std::vector<Integer> sCoordinates;
 
-            for (Integer i = 0; i < static_cast<Integer> (m_faceIds.size()); ++i)
+            if (!sUnpairedFaceIds.empty())
             {
+                aHashGrid.build();
+                aHashGrid.find(sCenterCoordinates, sOffsets, sCoordinates, aTolerance);
+            }
 
-                Integer aFaceId = m_faceIds[i];
+            for (Integer i = 0; i < static_cast<Integer> (sUnpairedFaceIds.size()); ++i)
+            {
 
-                std::vector<Integer> sCoordinates;
+                Integer aFaceId = sUnpairedFaceIds[i];
 
-                aHashGrid.find(sCoordinates, sCenterCoordinates[i], aTolerance);
+                if (this->face(aFaceId).hasPair())
+                    continue;
 
-                for (Integer j = 0; j < static_cast<Integer> (sCoordinates.size()); ++j)
+                for (Integer j = sOffsets[i]; j < sOffsets[i + 1]; ++j)
                 {
 
-                    if (sCoordinates[j] != aFaceId)
+                    Integer aPairFaceId = sCoordinates[j];
+
+                    CMshFace<Real>& aFace = this->face(aFaceId);
+                    CMshFace<Real>& aPairFace = this->face(aPairFaceId);
+
+                    if (aPairFaceId == aFaceId || aPairFace.hasPair() || aFace.faceType() != aPairFace.faceType())
+                        continue;
+
+                    // Every node must coincide, not only the centroid
+                    bool bCoincident = true;
+
+                    for (Integer k = 0; k < aFace.nbNodeIds() && bCoincident; ++k)
                     {
 
-                        Integer aPairFaceId = sCoordinates[j];
+                        bool bFound = false;
 
-                        if (m_faces[aFaceId].faceType() == m_faces[aPairFaceId].faceType())
-                        {
-                            m_faces[aFaceId].setPairFaceId(aPairFaceId);
-                            m_faces[aPairFaceId].setPairFaceId(aFaceId);
-                            break;
-                        }
+                        for (Integer l = 0; l < aPairFace.nbNodeIds() && !bFound; ++l)
+                            bFound = (this->node(aFace.nodeId(k)) - this->node(aPairFace.nodeId(l))).norm() <= aTolerance;
+
+                        bCoincident = bFound;
+
+                    }
+
+                    if (bCoincident)
+                    {
+                        aFace.setPairFaceId(aPairFaceId);
+                        aPairFace.setPairFaceId(aFaceId);
+                        break;
                     }
 
                 }
@@ -368,10 +512,10 @@ namespace ENigMA
 
             m_nbBoundaryFaces = 0;
 
-            for (typename mapFace::iterator it = m_faces.begin(); it != m_faces.end(); it++)
+            for (Integer i = 0; i < nbFaces; ++i)
             {
 
-                if (!it->second.hasPair())
+                if (!m_faces[i].hasPair())
                     m_nbBoundaryFaces++;
 
             }
@@ -401,7 +545,7 @@ namespace ENigMA
 
                 Integer aFaceId = m_faceIds[i];
 
-                CMshFace<Real> aFace = m_faces[aFaceId];
+                CMshFace<Real> aFace = this->face(aFaceId);
 
                 if (!aFace.hasPair())
                 {
@@ -432,7 +576,7 @@ namespace ENigMA
 
                 Integer aNodeId = m_nodeIds[i];
 
-                CMshNode<Real> aNode = m_nodes[aNodeId];
+                CMshNode<Real> aNode = this->node(aNodeId);
 
                 aBoundaryMesh.addNode(aNodeId, aNode);
 
@@ -510,7 +654,7 @@ namespace ENigMA
                 for (Integer j = 0; j < aFace.nbNodeIds(); ++j)
                 {
 
-                    aCentroid += m_nodes[aFace.nodeId(j)];
+                    aCentroid += this->node(aFace.nodeId(j));
 
                 }
 
@@ -534,7 +678,7 @@ namespace ENigMA
 
                 Integer anElementId = m_elementIds[i];
 
-                CMshElement<Real>& anElement = m_elements[anElementId];
+                CMshElement<Real>& anElement = this->element(anElementId);
 
                 CGeoCoordinate<Real> aCentroid;
 
@@ -543,7 +687,7 @@ namespace ENigMA
                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                 {
 
-                    aCentroid += m_nodes[anElement.nodeId(j)];
+                    aCentroid += this->node(anElement.nodeId(j));
 
                 }
 
@@ -576,10 +720,8 @@ namespace ENigMA
         void CMshMesh<Real>::scale(const Real aFactor)
         {
             
-            for (typename mapNode::iterator it = m_nodes.begin(); it != m_nodes.end(); it++)
-            {
-                it->second *= aFactor;
-            }
+            for (Integer i = 0; i < static_cast<Integer> (m_nodeIds.size()); ++i)
+                this->node(m_nodeIds[i]) *= aFactor;
 
         }
 
@@ -587,10 +729,7 @@ namespace ENigMA
         Integer CMshMesh<Real>::nextNodeId()
         {
 
-            if (m_nodes.size() > 0)
-                return m_nodes.rbegin()->first + 1;
-            else
-                return 0;
+            return static_cast<Integer> (m_nodeIndices.size());
 
         }
 
@@ -598,10 +737,7 @@ namespace ENigMA
         Integer CMshMesh<Real>::nextFaceId()
         {
 
-            if (m_faces.size() > 0)
-                return m_faces.rbegin()->first + 1;
-            else
-                return 0;
+            return static_cast<Integer> (m_faceIndices.size());
 
         }
 
@@ -609,10 +745,7 @@ namespace ENigMA
         Integer CMshMesh<Real>::nextElementId()
         {
 
-            if (m_elements.size() > 0)
-                return m_elements.rbegin()->first + 1;
-            else
-                return 0;
+            return static_cast<Integer> (m_elementIndices.size());
 
         }
 
@@ -622,19 +755,29 @@ namespace ENigMA
 
             CGeoHashGrid<Real> aHashGrid;
 
+            std::vector<CGeoCoordinate<Real> > sCoordinates(m_nodeIds.size());
+
             for (Integer i = 0; i < static_cast<Integer> (m_nodeIds.size()); ++i)
             {
 
                 Integer aNodeId = m_nodeIds[i];
 
-                CMshNode<Real>& aNode = m_nodes[aNodeId];
+                CMshNode<Real>& aNode = this->node(aNodeId);
 
                 aHashGrid.addGeometricObject(aNodeId, aNode);
 
+                sCoordinates[i] = aNode;
+
             }
 
             aHashGrid.build();
 
+            // Query all the nodes at once
+            std::vector<Integer> sOffsets;
+            std::vector<Integer> sNodes;
+
+            aHashGrid.find(sCoordinates, sOffsets, sNodes, aTolerance);
+
             std::map<Integer, bool> bDeleteNode;
             std::map<Integer, Integer> sNewNodeIds;
 
@@ -655,16 +798,10 @@ namespace ENigMA
                 if (bDeleteNode[aNodeId])
                     continue;
 
-                CMshNode<Real>& aNode = m_nodes[aNodeId];
-
-                std::vector<Integer> sNodes;
-
-                aHashGrid.find(sNodes, aNode, aTolerance);
-
-                if (sNodes.size() > 1)
+                if (sOffsets[i + 1] - sOffsets[i] > 1)
                 {
 
-                    for (Integer k = 0; k < static_cast<Integer> (sNodes.size()); ++k)
+                    for (Integer k = sOffsets[i]; k < sOffsets[i + 1]; ++k)
                     {
 
                         if (sNodes[k] > aNodeId)
@@ -688,7 +825,7 @@ namespace ENigMA
 
                 Integer anElementId = m_elementIds[i];
 
-                CMshElement<Real>& anElement = m_elements[anElementId];
+                CMshElement<Real>& anElement = this->element(anElementId);
 
                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                 {
@@ -708,7 +845,7 @@ namespace ENigMA
 
                 Integer aFaceId = m_faceIds[i];
 
-                CMshFace<Real>& aFace = m_faces[aFaceId];
+                CMshFace<Real>& aFace = this->face(aFaceId);
 
                 for (Integer j = 0; j < aFace.nbNodeIds(); ++j)
                 {
@@ -752,7 +889,7 @@ namespace ENigMA
 
                 bDeleteElement[anElementId] = false;
 
-                CMshElement<Real>& anElement = m_elements[anElementId];
+                CMshElement<Real>& anElement = this->element(anElementId);
 
                 std::vector<Integer> sNodeIds;
 
@@ -784,42 +921,57 @@ namespace ENigMA
         void CMshMesh<Real>::rebuildIndices()
         {
 
-            // Rebuild node indices
-            m_nodeIndices.clear();
+            // Rebuild node indices and compact the node storage
+            std::vector<CMshNode<Real> > sNodes;
+            sNodes.reserve(m_nodeIds.size());
 
             for (Integer i = 0; i < static_cast<Integer> (m_nodeIds.size()); ++i)
             {
 
                 Integer aNodeId = m_nodeIds[i];
 
+                sNodes.push_back(m_nodes[m_nodeIndices[aNodeId]]);
                 m_nodeIndices[aNodeId] = i;
 
             }
 
-            // Rebuild face indices
-            m_faceIndices.clear();
+            m_nodes.swap(sNodes);
+            m_nodeIndex = static_cast<Integer> (m_nodes.size());
+
+            // Rebuild face indices and compact the face storage
+            std::vector<CMshFace<Real> > sFaces;
+            sFaces.reserve(m_faceIds.size());
 
             for (Integer i = 0; i < static_cast<Integer> (m_faceIds.size()); ++i)
             {
 
                 Integer aFaceId = m_faceIds[i];
 
+                sFaces.push_back(m_faces[m_faceIndices[aFaceId]]);
                 m_faceIndices[aFaceId] = i;
 
             }
 
-            // Rebuild element indices
-            m_elementIndices.clear();
+            m_faces.swap(sFaces);
+            m_faceIndex = static_cast<Integer> (m_faces.size());
+
+            // Rebuild element indices and compact the element storage
+            std::vector<CMshElement<Real> > sElements;
+            sElements.reserve(m_elementIds.size());
 
             for (Integer i = 0; i < static_cast<Integer> (m_elementIds.size()); ++i)
             {
 
                 Integer anElementId = m_elementIds[i];
 
+                sElements.push_back(m_elements[m_elementIndices[anElementId]]);
                 m_elementIndices[anElementId] = i;
 
             }
 
+            m_elements.swap(sElements);
+            m_elementIndex = static_cast<Integer> (m_elements.size());
+
         }
 
         template <typename Real>
@@ -840,7 +992,7 @@ namespace ENigMA
 
                 Integer aFaceId = m_faceIds[i];
 
-                CMshFace<Real>& aFace = m_faces[aFaceId];
+                CMshFace<Real>& aFace = this->face(aFaceId);
 
                 for (Integer k = 0; k < aFace.nbNodeIds(); ++k)
                 {
@@ -854,7 +1006,7 @@ namespace ENigMA
 
                 Integer anElementId = m_elementIds[i];
 
-                CMshElement<Real>& anElement = m_elements[anElementId];
+                CMshElement<Real>& anElement = this->element(anElementId);
 
                 for (Integer k = 0; k < anElement.nbNodeIds(); ++k)
                 {
@@ -889,7 +1041,7 @@ namespace ENigMA
             {
                 Integer aFaceId = m_faceIds[i];
 
-                CMshFace<Real>& aFace = m_faces[aFaceId];
+                CMshFace<Real>& aFace = this->face(aFaceId);
 
                 if (aFace.faceType() != FT_LINE)
                     continue;
@@ -901,8 +1053,8 @@ namespace ENigMA
                     Integer aNodeId1 = aFace.nodeId(0);
                     Integer aNodeId2 = aFace.nodeId(1);
 
-                    CMshNode<Real>& aNode1 = m_nodes[aNodeId1];
-                    CMshNode<Real>& aNode2 = m_nodes[aNodeId2];
+                    CMshNode<Real>& aNode1 = this->node(aNodeId1);
+                    CMshNode<Real>& aNode2 = this->node(aNodeId2);
 
                     Real aDistance = (aNode2 - aNode1).norm();
 
@@ -919,13 +1071,13 @@ namespace ENigMA
 
                 Integer aFaceId = sFaces[i];
 
-                CMshFace<Real>& aFace = m_faces[aFaceId];
+                CMshFace<Real>& aFace = this->face(aFaceId);
 
                 Integer aNodeId1 = aFace.nodeId(0);
                 Integer aNodeId2 = aFace.nodeId(1);
 
-                CMshNode<Real>& aNode1 = m_nodes[aNodeId1];
-                CMshNode<Real>& aNode2 = m_nodes[aNodeId2];
+                CMshNode<Real>& aNode1 = this->node(aNodeId1);
+                CMshNode<Real>& aNode2 = this->node(aNodeId2);
 
                 Real aDistance = (aNode2 - aNode1).norm();
 
@@ -942,83 +1094,58 @@ namespace ENigMA
         void CMshMesh<Real>::renumber()
         {
 
-            mapNodeIndex sNewNodeIds;
-            mapNode sNewNodes;
-
-            for (Integer i = 0; i < static_cast<Integer> (m_nodeIds.size()); ++i)
-            {
-
-                Integer anOldNodeId = m_nodeIds[i];
-                Integer aNewNodeId = i;
-
-                sNewNodeIds[anOldNodeId] = aNewNodeId;
-
-                CMshNode<Real> aNode = m_nodes[anOldNodeId];
-
-                sNewNodes[aNewNodeId] = aNode;
-
-            }
-
-            mapNodeIndex sNewFaceIds;
-            mapFace sNewFaces;
+            // After compaction the new id of each entity is its index
+            this->rebuildIndices();
 
-            for (Integer i = 0; i < static_cast<Integer> (m_faceIds.size()); ++i)
+            for (Integer i = 0; i < static_cast<Integer> (m_faces.size()); ++i)
             {
 
-                Integer anOldFaceId = m_faceIds[i];
-                Integer aNewFaceId = i;
-
-                sNewFaceIds[anOldFaceId] = aNewFaceId;
-
-                CMshFace<Real> aFace = m_faces[anOldFaceId];
+                CMshFace<Real>& aFace = m_faces[i];
 
                 for (Integer j = 0; j < aFace.nbNodeIds(); ++j)
-                    aFace.setNodeId(j, sNewFaceIds[aFace.nodeId(j)]);
-
-                sNewFaces[aNewFaceId] = aFace;
+                    aFace.setNodeId(j, m_nodeIndices[aFace.nodeId(j)]);
 
             }
 
-            mapElement sNewElements;
-
-            for (Integer i = 0; i < static_cast<Integer> (m_elementIds.size()); ++i)
+            for (Integer i = 0; i < static_cast<Integer> (m_elements.size()); ++i)
             {
 
-                Integer anOldElementId = m_elementIds[i];
-                Integer aNewElementId = i;
-
-                CMshElement<Real>& anElement = m_elements[anOldElementId];
+                CMshElement<Real>& anElement = m_elements[i];
 
                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
-                    anElement.setNodeId(j, sNewNodeIds[anElement.nodeId(j)]);
+                    anElement.setNodeId(j, m_nodeIndices[anElement.nodeId(j)]);
 
                 for (Integer j = 0; j < anElement.nbFaceIds(); ++j)
-                    anElement.setFaceId(j, sNewFaceIds[anElement.faceId(j)]);
-
-                sNewElements[aNewElementId] = anElement;
+                    anElement.setFaceId(j, m_faceIndices[anElement.faceId(j)]);
 
             }
 
             Integer n = static_cast<Integer>(m_nodeIds.size());
             m_nodeIds.clear();
+            m_nodeIndices.clear();
             for (Integer i = 0; i < n; ++i)
+            {
                 m_nodeIds.push_back(i);
+                m_nodeIndices.push_back(i);
+            }
 
             Integer f = static_cast<Integer>(m_faceIds.size());
             m_faceIds.clear();
+            m_faceIndices.clear();
             for (Integer i = 0; i < f; ++i)
+            {
                 m_faceIds.push_back(i);
+                m_faceIndices.push_back(i);
+            }
 
             Integer e = static_cast<Integer>(m_elementIds.size());
             m_elementIds.clear();
+            m_elementIndices.clear();
             for (Integer i = 0; i < e; ++i)
+            {
                 m_elementIds.push_back(i);
-
-            m_nodes = sNewNodes;
-            m_faces = sNewFaces;
-            m_elements = sNewElements;
-
-            this->rebuildIndices();
+                m_elementIndices.push_back(i);
+            }
 
         }
 
@@ -1031,7 +1158,7 @@ namespace ENigMA
 
                 Integer anElementId = m_elementIds[i];
 
-                m_elements[anElementId].invert();
+                this->element(anElementId).invert();
 
             }
 
@@ -1123,11 +1250,11 @@ namespace ENigMA
 
             CGeoBoundingBox<Real> aBoundingBox;
 
-            for (Integer j = 0; j < m_elements[anElementId].nbNodeIds(); ++j)
+            for (Integer j = 0; j < this->element(anElementId).nbNodeIds(); ++j)
             {
 
-                Integer aNodeId = m_elements[anElementId].nodeId(j);
-                CMshNode<Real>& aNode = m_nodes[aNodeId];
+                Integer aNodeId = this->element(anElementId).nodeId(j);
+                CMshNode<Real>& aNode = this->node(aNodeId);
 
                 aBoundingBox.addCoordinate(aNode);
 
@@ -1143,11 +1270,11 @@ namespace ENigMA
 
             CGeoBoundingBox<Real> aBoundingBox;
 
-            for (Integer i = 0; i < static_cast<Integer>(m_nodes.size()); ++i)
+            for (Integer i = 0; i < static_cast<Integer>(m_nodeIds.size()); ++i)
             {
 
                 Integer aNodeId = m_nodeIds[i];
-                CMshNode<Real>& aNode = m_nodes[aNodeId];
+                CMshNode<Real>& aNode = this->node(aNodeId);
 
                 aBoundingBox.addCoordinate(aNode);
 
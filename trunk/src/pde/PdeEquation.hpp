@@ -42,6 +42,8 @@ namespace ENigMA
 
             ENigMA::sle::CSleSystem<Real>& system();
 
+            void setSolver(ENigMA::sle::CSleSolver<Real>& aSolver);
+
             void setPenaltyFactor(ENigMA::pde::CPdeField<Real>& aField, Real aPenaltyFactor);
             void setElimination(ENigMA::pde::CPdeField<Real>& aField);
 
@@ -44,6 +44,14 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        void CPdeEquation<Real>::setSolver(ENigMA::sle::CSleSolver<Real>& aSolver)
+        {
+
+            m_system.setSolver(aSolver);
+
+        }
+
         template <typename Real>
         void CPdeEquation<Real>::setPenaltyFactor(ENigMA::pde::CPdeField<Real>& aField, Real aPenaltyFactor)
         {
@@ -108,6 +116,9 @@ namespace ENigMA
 
                 aNewSystem.matrixType = m_system.matrixType;
 
+                if (m_system.solver())
+                    aNewSystem.setSolver(*m_system.solver());
+
                 aNewSystem.matrixA.resize(newIndex, newIndex);
                 aNewSystem.matrixA.reserve(newIndex);
                 aNewSystem.vectorB.resize(newIndex);
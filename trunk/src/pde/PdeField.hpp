@@ -12,6 +12,7 @@
 #include "MshMesh.hpp"
 #include "MatMaterial.hpp"
 #include "PdeBoundaryCondition.hpp"
+#include "SlePattern.hpp"
 
 namespace ENigMA
 {
@@ -51,6 +52,13 @@ namespace ENigMA
             ST_STRUCTURAL
         };
 
+        enum EOperatorType
+        {
+            OT_DDT = 0,
+            OT_LAPLACIAN,
+            OT_DIVERGENCE
+        };
+
         template <typename Real>
         class CPdeField
         {
@@ -72,6 +80,9 @@ namespace ENigMA
             EDiscretLocation m_discretLocation;
             ESimulationType m_simulationType;
 
+            // Sparsity patterns of the assembled operators. Only valid for the current mesh.
+            std::map<EOperatorType, ENigMA::sle::CSlePattern<Real> > m_patterns;
+
         public:
 
             CPdeField();
@@ -100,9 +111,13 @@ namespace ENigMA
             void setSimulationType(ESimulationType aSimulationType);
             ESimulationType simulationType();
 
+            ENigMA::sle::CSlePattern<Real>& pattern(const EOperatorType anOperatorType);
+            void resetPatterns();
+
             void setSize(const Integer aSize);
 
             void setValue(const Integer anIndex, Real aValue);
+            void setValues(ENigMA::analytical::CAnaFunction<Real>& aFunction, const Integer nbThreads = 0);
             Real value(const Integer anIndex);
 
             void setFixedValue(const Integer anIndex, Real aValue);
@@ -16,7 +16,7 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CPdeField<Real>::CPdeField() : m_nbDofs(0)
+        CPdeField<Real>::CPdeField() : m_nbDofs(0), m_discretMethod(DM_NONE), m_discretOrder(DO_LINEAR), m_discretLocation(DL_NODE), m_simulationType(ST_GENERIC)
         {
 
         }
@@ -33,6 +33,8 @@ namespace ENigMA
 
             m_mesh = aMesh;
 
+            this->resetPatterns();
+
         }
 
         template <typename Real>
@@ -65,6 +67,8 @@ namespace ENigMA
 
             m_nbDofs = nbDofs;
 
+            this->resetPatterns();
+
         }
 
         template <typename Real>
@@ -129,6 +133,8 @@ namespace ENigMA
 
             m_simulationType = aSimulationType;
 
+            this->resetPatterns();
+
         }
 
         template <typename Real>
@@ -139,6 +145,22 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        ENigMA::sle::CSlePattern<Real>& CPdeField<Real>::pattern(const EOperatorType anOperatorType)
+        {
+
+            return m_patterns[anOperatorType];
+
+        }
+
+        template <typename Real>
+        void CPdeField<Real>::resetPatterns()
+        {
+
+            m_patterns.clear();
+
+        }
+
         template <typename Real>
         void CPdeField<Real>::setSize(const Integer aSize)
         {
@@ -155,6 +177,70 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        void CPdeField<Real>::setValues(ENigMA::analytical::CAnaFunction<Real>& aFunction, const Integer nbThreads)
+        {
+
+            // Evaluates the function at every node or element centre in one batch
+            std::vector<std::string> sVariables;
+
+            sVariables.push_back("x");
+            sVariables.push_back("y");
+            sVariables.push_back("z");
+
+            std::vector<std::vector<Real> > sColumns(3);
+
+            if (m_discretLocation == DL_ELEMENT_CENTER)
+            {
+
+                const Integer nbElements = m_mesh.nbElements();
+
+                m_mesh.calculateElementCentroid();
+
+                for (Integer k = 0; k < 3; ++k)
+                    sColumns[k].resize(nbElements);
+
+                for (Integer i = 0; i < nbElements; ++i)
+                {
+
+                    ENigMA::geometry::CGeoCoordinate<Real>& aCentroid = m_mesh.elementCentroid(m_mesh.elementId(i));
+
+                    sColumns[0][i] = aCentroid.x();
+                    sColumns[1][i] = aCentroid.y();
+                    sColumns[2][i] = aCentroid.z();
+
+                }
+
+            }
+            else
+            {
+
+                const Integer nbNodes = m_mesh.nbNodes();
+
+                for (Integer k = 0; k < 3; ++k)
+                    sColumns[k].resize(nbNodes);
+
+                for (Integer i = 0; i < nbNodes; ++i)
+                {
+
+                    ENigMA::mesh::CMshNode<Real>& aNode = m_mesh.node(m_mesh.nodeId(i));
+
+                    sColumns[0][i] = aNode.x();
+                    sColumns[1][i] = aNode.y();
+                    sColumns[2][i] = aNode.z();
+
+                }
+
+            }
+
+            std::vector<Real> sValues;
+
+            aFunction.evaluate(sVariables, sColumns, sValues, nbThreads);
+
+            u = Eigen::Map<Eigen::Matrix<Real, Eigen::Dynamic, 1> >(sValues.data(), sValues.size());
+
+        }
+
         template <typename Real>
         Real CPdeField<Real>::value(const Integer anIndex)
         {
@@ -11,6 +11,7 @@
 
 #include "PdeField.hpp"
 #include "SleSystem.hpp"
+#include "SleAssembler.hpp"
 
 using namespace ENigMA::pde;
 using namespace ENigMA::sle;
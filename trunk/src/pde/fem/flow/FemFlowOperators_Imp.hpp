@@ -33,17 +33,17 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE_SYMMETRIC;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.setZero();
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_DDT), aField.mesh().nbElements());
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
-                        CMshElement<Real> anElement = aField.mesh().element(el);
+                        anAssembler.setElement(el);
+
+                        Integer anElementId = aField.mesh().elementId(el);
+
+                        CMshElement<Real> anElement = aField.mesh().element(anElementId);
 
                         if (anElement.elementType() == ET_BEAM && anElement.nbNodeIds() == 2)
                         {
@@ -72,13 +72,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aTriangle.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aTriangle.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aTriangle.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aTriangle.source(i));
 
                             }
 
@@ -108,13 +108,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aTetrahedron.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aTetrahedron.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aTetrahedron.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aTetrahedron.source(i));
 
                             }
 
@@ -127,7 +127,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                     aSystem.vectorB += aSystem.matrixA * aField.u;
 
@@ -139,16 +139,17 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE_SYMMETRIC;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_LAPLACIAN), aField.mesh().nbElements());
 
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    const Real aDensity = aField.material().propertyValue(ENigMA::material::PT_DENSITY);
+                    const Real aViscosity = aField.material().propertyValue(ENigMA::material::PT_VISCOSITY);
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
+                        anAssembler.setElement(el);
+
                         Integer anElementId = aField.mesh().elementId(el);
 
                         CMshElement<Real> anElement = aField.mesh().element(anElementId);
@@ -163,12 +164,10 @@ namespace ENigMA
 
                             CFemFlowTriangle<Real, 3, 1, 1> aTriangle;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField.material();
-
                             aTriangle.setThickness(anElement.thickness());
 
-                            aTriangle.setDensity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
-                            aTriangle.setViscosity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
+                            aTriangle.setDensity(aDensity);
+                            aTriangle.setViscosity(aViscosity);
 
                             for (Integer i = 0; i < anElement.nbNodeIds(); ++i)
                             {
@@ -191,16 +190,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTriangle.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTriangle.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTriangle.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTriangle.source(i));
 
                             }
 
@@ -214,10 +213,8 @@ namespace ENigMA
 
                             CFemFlowTetrahedron<Real, 4, 1, 1> aTetrahedron;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField.material();
-
-                            aTetrahedron.setDensity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
-                            aTetrahedron.setViscosity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
+                            aTetrahedron.setDensity(aDensity);
+                            aTetrahedron.setViscosity(aViscosity);
 
                             for (Integer i = 0; i < anElement.nbNodeIds(); ++i)
                             {
@@ -240,16 +237,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTetrahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTetrahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTetrahedron.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTetrahedron.source(i));
 
                             }
 
@@ -269,7 +266,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
@@ -279,16 +276,14 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_DIVERGENCE), aField.mesh().nbElements());
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
+                        anAssembler.setElement(el);
+
                         Integer anElementId = aField.mesh().elementId(el);
 
                         CMshElement<Real> anElement = aField.mesh().element(anElementId);
@@ -329,7 +324,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
@@ -339,13 +334,12 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE;
 
-                    aSystem.matrixA.resize(aField1.mesh().nbNodes(), aField1.mesh().nbNodes());
+                    CSleAssembler<Real> anAssembler(aField1.mesh().nbNodes(), aField1.mesh().nbNodes());
 
-                    aSystem.matrixA.reserve(aField1.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField1.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    const Real aDensity = aField1.material().propertyValue(ENigMA::material::PT_DENSITY);
+                    const Real aViscosity = aField1.material().propertyValue(ENigMA::material::PT_VISCOSITY);
 
+                    #pragma omp parallel for if (aField1.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField1.mesh().nbElements(); el++)
                     {
 
@@ -363,14 +357,12 @@ namespace ENigMA
 
                             CFemFlowTriangle<Real, 3, 1, 1> aTriangle;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField1.material();
-
                             aTriangle.setThickness(anElement.thickness());
 
                             aTriangle.setDt(dt);
 
-                            aTriangle.setDensity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
-                            aTriangle.setViscosity(aMaterial.propertyValue(ENigMA::material::PT_VISCOSITY));
+                            aTriangle.setDensity(aDensity);
+                            aTriangle.setViscosity(aViscosity);
 
                             double ue[3], ve[3];
 
@@ -402,16 +394,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField1.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField1.mesh().nodeIndex(anElement.nodeId(i)) * aField1.nbDofs() + k, 
-                                                aField1.mesh().nodeIndex(anElement.nodeId(j)) * aField1.nbDofs() + l) += aTriangle.divergence(i * aField1.nbDofs() + k, j * aField1.nbDofs() + l);
+                                                aField1.mesh().nodeIndex(anElement.nodeId(j)) * aField1.nbDofs() + l, aTriangle.divergence(i * aField1.nbDofs() + k, j * aField1.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField1.mesh().nodeIndex(anElement.nodeId(i))) += aTriangle.source(i);
+                                anAssembler.addVector(aField1.mesh().nodeIndex(anElement.nodeId(i)), aTriangle.source(i));
 
                             }
 
@@ -441,7 +433,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
@@ -451,13 +443,12 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE;
 
-                    aSystem.matrixA.resize(aField1.mesh().nbNodes(), aField1.mesh().nbNodes());
+                    CSleAssembler<Real> anAssembler(aField1.mesh().nbNodes(), aField1.mesh().nbNodes());
 
-                    aSystem.matrixA.reserve(aField1.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField1.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    const Real aDensity = aField1.material().propertyValue(ENigMA::material::PT_DENSITY);
+                    const Real aViscosity = aField1.material().propertyValue(ENigMA::material::PT_VISCOSITY);
 
+                    #pragma omp parallel for if (aField1.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField1.mesh().nbElements(); el++)
                     {
 
@@ -485,12 +476,10 @@ namespace ENigMA
 
                             CFemFlowTetrahedron<Real, 4, 1, 1> aTetrahedron;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField1.material();
-
                             aTetrahedron.setDt(dt);
 
-                            aTetrahedron.setDensity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
-                            aTetrahedron.setViscosity(aMaterial.propertyValue(ENigMA::material::PT_VISCOSITY));
+                            aTetrahedron.setDensity(aDensity);
+                            aTetrahedron.setViscosity(aViscosity);
 
                             double ue[4], ve[4], we[4];
 
@@ -523,16 +512,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField1.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField1.mesh().nodeIndex(anElement.nodeId(i)) * aField1.nbDofs() + k, 
-                                                aField1.mesh().nodeIndex(anElement.nodeId(j)) * aField1.nbDofs() + l) += aTetrahedron.divergence(i * aField1.nbDofs() + k, j * aField1.nbDofs() + l);
+                                                aField1.mesh().nodeIndex(anElement.nodeId(j)) * aField1.nbDofs() + l, aTetrahedron.divergence(i * aField1.nbDofs() + k, j * aField1.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField1.mesh().nodeIndex(anElement.nodeId(i))) += aTetrahedron.source(i);
+                                anAssembler.addVector(aField1.mesh().nodeIndex(anElement.nodeId(i)), aTetrahedron.source(i));
 
                             }
 
@@ -552,7 +541,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
@@ -562,13 +551,12 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes());
 
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    const Real aDensity = aField.material().propertyValue(ENigMA::material::PT_DENSITY);
+                    const Real aViscosity = aField.material().propertyValue(ENigMA::material::PT_VISCOSITY);
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
@@ -586,12 +574,10 @@ namespace ENigMA
 
                             CFemFlowTriangle<Real, 3, 1, 1> aTriangle;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField.material();
-
                             aTriangle.setThickness(anElement.thickness());
 
-                            aTriangle.setDensity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
-                            aTriangle.setViscosity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
+                            aTriangle.setDensity(aDensity);
+                            aTriangle.setViscosity(aViscosity);
 
                             for (Integer i = 0; i < anElement.nbNodeIds(); ++i)
                             {
@@ -614,16 +600,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTriangle.gradient(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTriangle.gradient(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTriangle.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTriangle.source(i));
 
                             }
 
@@ -637,10 +623,8 @@ namespace ENigMA
 
                             CFemFlowTetrahedron<Real, 4, 1, 1> aTetrahedron;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField.material();
-
-                            aTetrahedron.setDensity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
-                            aTetrahedron.setViscosity(aMaterial.propertyValue(ENigMA::material::PT_DENSITY));
+                            aTetrahedron.setDensity(aDensity);
+                            aTetrahedron.setViscosity(aViscosity);
 
                             for (Integer i = 0; i < anElement.nbNodeIds(); ++i)
                             {
@@ -663,16 +647,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTetrahedron.gradient(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTetrahedron.gradient(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTetrahedron.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTetrahedron.source(i));
 
                             }
 
@@ -692,7 +676,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
@@ -36,17 +36,17 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE_SYMMETRIC;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.setZero();
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_DDT), aField.mesh().nbElements());
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
-                        CMshElement<Real> anElement = aField.mesh().element(el);
+                        anAssembler.setElement(el);
+
+                        Integer anElementId = aField.mesh().elementId(el);
+
+                        CMshElement<Real> anElement = aField.mesh().element(anElementId);
 
                         if (anElement.elementType() == ET_BEAM && anElement.nbNodeIds() == 2)
                         {
@@ -70,13 +70,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aBeam.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aBeam.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aBeam.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aBeam.source(i));
 
                             }
 
@@ -104,13 +104,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aTriangle.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aTriangle.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aTriangle.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aTriangle.source(i));
 
                             }
 
@@ -138,13 +138,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aQuadrilateral.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aQuadrilateral.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aQuadrilateral.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aQuadrilateral.source(i));
 
                             }
 
@@ -172,13 +172,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aTetrahedron.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aTetrahedron.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aTetrahedron.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aTetrahedron.source(i));
 
                             }
 
@@ -206,13 +206,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aHexahedron.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aHexahedron.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aHexahedron.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aHexahedron.source(i));
 
                             }
 
@@ -220,7 +220,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                     aSystem.vectorB += aSystem.matrixA * aField.u;
 
@@ -232,16 +232,14 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE_SYMMETRIC;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_LAPLACIAN), aField.mesh().nbElements());
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
+                        anAssembler.setElement(el);
+
                         Integer anElementId = aField.mesh().elementId(el);
 
                         CMshElement<Real> anElement = aField.mesh().element(anElementId);
@@ -272,16 +270,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aBeam.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aBeam.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aBeam.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aBeam.source(i));
 
                             }
 
@@ -313,16 +311,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTriangle.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTriangle.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTriangle.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTriangle.source(i));
 
                             }
 
@@ -354,16 +352,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aQuadrilateral.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aQuadrilateral.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aQuadrilateral.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aQuadrilateral.source(i));
 
                             }
 
@@ -395,16 +393,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTetrahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTetrahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTetrahedron.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTetrahedron.source(i));
 
                             }
 
@@ -437,16 +435,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTriangularPrism.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTriangularPrism.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTriangularPrism.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTriangularPrism.source(i));
 
                             }
 
@@ -479,16 +477,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aHexahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aHexahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aHexahedron.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aHexahedron.source(i));
 
                             }
 
@@ -496,7 +494,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
@@ -506,16 +504,14 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_DIVERGENCE), aField.mesh().nbElements());
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
+                        anAssembler.setElement(el);
+
                         Integer anElementId = aField.mesh().elementId(el);
 
                         CMshElement<Real> anElement = aField.mesh().element(anElementId);
@@ -546,16 +542,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aBeam.divergence(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aBeam.divergence(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aBeam.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aBeam.source(i));
 
                             }
 
@@ -590,7 +586,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
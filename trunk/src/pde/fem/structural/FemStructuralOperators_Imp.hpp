@@ -41,16 +41,17 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE_SYMMETRIC;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes() * aField.nbDofs(), aField.mesh().nbNodes() * aField.nbDofs());
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes() * aField.nbDofs(), aField.mesh().nbNodes() * aField.nbDofs(), aField.pattern(OT_LAPLACIAN), aField.mesh().nbElements());
 
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes() * aField.nbDofs());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes() * aField.nbDofs());
-                    aSystem.vectorB.setZero();
+                    const Real anElasticModulus = aField.material().propertyValue(ENigMA::material::PT_ELASTIC_MODULUS);
+                    const Real aCoeffPoisson = aField.material().propertyValue(ENigMA::material::PT_POISSON_COEFFICIENT);
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
+                        anAssembler.setElement(el);
+
                         Integer anElementId = aField.mesh().elementId(el);
 
                         CMshElement<Real> anElement = aField.mesh().element(anElementId);
@@ -65,12 +66,10 @@ namespace ENigMA
 
                             CFemConstantStrainTriangle<Real, 3, 2, 1> aTriangle;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField.material();
-
                             aTriangle.setThickness(anElement.thickness());
 
-                            aTriangle.setElasticModulus(aMaterial.propertyValue(ENigMA::material::PT_ELASTIC_MODULUS));
-                            aTriangle.setCoeffPoisson(aMaterial.propertyValue(ENigMA::material::PT_POISSON_COEFFICIENT));
+                            aTriangle.setElasticModulus(anElasticModulus);
+                            aTriangle.setCoeffPoisson(aCoeffPoisson);
 
                             for (Integer i = 0; i < anElement.nbNodeIds(); ++i)
                             {
@@ -95,16 +94,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTriangle.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTriangle.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTriangle.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTriangle.source(i));
 
                             }
 
@@ -118,10 +117,8 @@ namespace ENigMA
 
                             CFemConstantStrainTetrahedron<Real, 4, 3, 1> aTetrahedron;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField.material();
-
-                            aTetrahedron.setElasticModulus(aMaterial.propertyValue(ENigMA::material::PT_ELASTIC_MODULUS));
-                            aTetrahedron.setCoeffPoisson(aMaterial.propertyValue(ENigMA::material::PT_POISSON_COEFFICIENT));
+                            aTetrahedron.setElasticModulus(anElasticModulus);
+                            aTetrahedron.setCoeffPoisson(aCoeffPoisson);
 
                             for (Integer i = 0; i < anElement.nbNodeIds(); ++i)
                             {
@@ -146,16 +143,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTetrahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTetrahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTetrahedron.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTetrahedron.source(i));
 
                             }
 
@@ -168,7 +165,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
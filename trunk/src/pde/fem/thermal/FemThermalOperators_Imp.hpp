@@ -37,17 +37,17 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE_SYMMETRIC;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.setZero();
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_DDT), aField.mesh().nbElements());
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
-                        CMshElement<Real> anElement = aField.mesh().element(el);
+                        anAssembler.setElement(el);
+
+                        Integer anElementId = aField.mesh().elementId(el);
+
+                        CMshElement<Real> anElement = aField.mesh().element(anElementId);
 
                         if (anElement.elementType() == ET_BEAM && anElement.nbNodeIds() == 2)
                         {
@@ -71,13 +71,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aBeam.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aBeam.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aBeam.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aBeam.source(i));
 
                             }
 
@@ -105,13 +105,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aTriangle.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aTriangle.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aTriangle.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aTriangle.source(i));
 
                             }
 
@@ -139,13 +139,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aQuadrilateral.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aQuadrilateral.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aQuadrilateral.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aQuadrilateral.source(i));
 
                             }
 
@@ -173,13 +173,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aTetrahedron.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aTetrahedron.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aTetrahedron.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aTetrahedron.source(i));
 
                             }
 
@@ -207,13 +207,13 @@ namespace ENigMA
                                 for (Integer j = 0; j < anElement.nbNodeIds(); ++j)
                                 {
 
-                                    aSystem.matrixA.coeffRef(
+                                    anAssembler.addMatrix(
                                         aField.mesh().nodeIndex(anElement.nodeId(i)), 
-                                        aField.mesh().nodeIndex(anElement.nodeId(j))) += aHexahedron.ddt(i, j);
+                                        aField.mesh().nodeIndex(anElement.nodeId(j)), aHexahedron.ddt(i, j));
 
                                 }
 
-                                aSystem.vectorB(anElement.nodeId(i)) += aHexahedron.source(i);
+                                anAssembler.addVector(anElement.nodeId(i), aHexahedron.source(i));
 
                             }
 
@@ -221,7 +221,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                     aSystem.vectorB += aSystem.matrixA * aField.u;
 
@@ -233,16 +233,14 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE_SYMMETRIC;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_LAPLACIAN), aField.mesh().nbElements());
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
+                        anAssembler.setElement(el);
+
                         Integer anElementId = aField.mesh().elementId(el);
 
                         CMshElement<Real> anElement = aField.mesh().element(anElementId);
@@ -267,7 +265,7 @@ namespace ENigMA
                             if (aField.elementHasBC(anElementId, 0))
                             {
                                 
-                                CPdeBoundaryCondition<Real> aCondition = aField.elementBC(anElementId, 0);
+                                CPdeBoundaryCondition<Real>& aCondition = aField.elementBC(anElementId, 0);
 
                                 if (aCondition.boundaryConditionType() == BT_HEAT_CONVECTIVE)
                                 {
@@ -290,16 +288,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aBeam.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aBeam.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aBeam.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aBeam.source(i));
 
                             }
 
@@ -308,8 +306,6 @@ namespace ENigMA
 
                             CFemLinearTemperatureTriangle<Real, 3, 1, 1> aTriangle;
 
-                            ENigMA::material::CMatMaterial<Real> aMaterial = aField.material();
-
                             for (Integer i = 0; i < anElement.nbNodeIds(); ++i)
                             {
 
@@ -330,7 +326,7 @@ namespace ENigMA
                                 if (aField.elementHasBC(anElementId, i))
                                 {
                                 
-                                    CPdeBoundaryCondition<Real> aCondition = aField.elementBC(anElementId, i);
+                                    CPdeBoundaryCondition<Real>& aCondition = aField.elementBC(anElementId, i);
 
                                     if (aCondition.boundaryConditionType() == BT_HEAT_CONVECTIVE)
                                     {
@@ -355,16 +351,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTriangle.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTriangle.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTriangle.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTriangle.source(i));
 
                             }
 
@@ -396,16 +392,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aQuadrilateral.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);                                        
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aQuadrilateral.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));                                        
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aQuadrilateral.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aQuadrilateral.source(i));
 
                             }
 
@@ -437,16 +433,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTetrahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTetrahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTetrahedron.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTetrahedron.source(i));
 
                             }
 
@@ -479,16 +475,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aTriangularPrism.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aTriangularPrism.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aTriangularPrism.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aTriangularPrism.source(i));
 
                             }
 
@@ -521,16 +517,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aHexahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aHexahedron.laplacian(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aHexahedron.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aHexahedron.source(i));
 
                             }
 
@@ -538,7 +534,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
@@ -548,16 +544,14 @@ namespace ENigMA
 
                     aSystem.matrixType = MT_SPARSE;
 
-                    aSystem.matrixA.resize(aField.mesh().nbNodes(), aField.mesh().nbNodes());
-
-                    aSystem.matrixA.reserve(aField.mesh().nbNodes());
-
-                    aSystem.vectorB.resize(aField.mesh().nbNodes());
-                    aSystem.vectorB.setZero();
+                    CSleAssembler<Real> anAssembler(aField.mesh().nbNodes(), aField.mesh().nbNodes(), aField.pattern(OT_DIVERGENCE), aField.mesh().nbElements());
 
+                    #pragma omp parallel for if (aField.mesh().nbElements() > 1000)
                     for (Integer el = 0; el < aField.mesh().nbElements(); el++)
                     {
 
+                        anAssembler.setElement(el);
+
                         Integer anElementId = aField.mesh().elementId(el);
 
                         CMshElement<Real> anElement = aField.mesh().element(anElementId);
@@ -588,16 +582,16 @@ namespace ENigMA
                                         for (Integer l = 0; l < aField.nbDofs(); l++)
                                         {
 
-                                            aSystem.matrixA.coeffRef(
+                                            anAssembler.addMatrix(
                                                 aField.mesh().nodeIndex(anElement.nodeId(i)) * aField.nbDofs() + k, 
-                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l) += aBeam.divergence(i * aField.nbDofs() + k, j * aField.nbDofs() + l);
+                                                aField.mesh().nodeIndex(anElement.nodeId(j)) * aField.nbDofs() + l, aBeam.divergence(i * aField.nbDofs() + k, j * aField.nbDofs() + l));
                                         }
 
                                     }
 
                                 }
 
-                                aSystem.vectorB(aField.mesh().nodeIndex(anElement.nodeId(i))) += aBeam.source(i);
+                                anAssembler.addVector(aField.mesh().nodeIndex(anElement.nodeId(i)), aBeam.source(i));
 
                             }
 
@@ -632,7 +626,7 @@ namespace ENigMA
 
                     }
 
-                    aSystem.matrixA.finalize();
+                    anAssembler.assemble(aSystem.matrixA, aSystem.vectorB);
 
                 }
 
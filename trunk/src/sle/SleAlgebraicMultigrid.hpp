@@ -0,0 +1,113 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include "CmnTypes.hpp"
+
+namespace ENigMA
+{
+
+    namespace sle
+    {
+
+        // Smoothed aggregation algebraic multigrid. Follows the Eigen preconditioner interface
+        // so it can be used inside Eigen::ConjugateGradient and Eigen::BiCGSTAB.
+        template <typename Real>
+        class CSleAlgebraicMultigrid
+        {
+        private:
+
+            typedef Eigen::SparseMatrix<Real> SparseMatrix;
+            typedef Eigen::Matrix<Real, Eigen::Dynamic, 1> Vector;
+
+            struct CSleLevel
+            {
+                SparseMatrix A;
+                SparseMatrix P;
+                SparseMatrix R;
+                Vector invDiag;
+                mutable Vector x, b, r;
+            };
+
+            std::vector<CSleLevel> m_levels;
+
+            // Aggregates of every level. Only rebuilt by analyzePattern.
+            std::vector<std::vector<Integer> > m_aggregates;
+            std::vector<Integer> m_nbAggregates;
+
+            // Aggregates given by the caller (e.g. a mesh agglomeration), used for the levels they fit
+            std::vector<std::vector<Integer> > m_givenAggregates;
+            std::vector<Integer> m_nbGivenAggregates;
+
+            Eigen::CompleteOrthogonalDecomposition<Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> > m_coarseSolver;
+
+            Integer m_coarseSize;
+            Integer m_maxLevels;
+            Integer m_nbSmoothingSteps;
+            Real m_strengthThreshold;
+            Real m_relaxation;
+
+            bool m_isInitialized;
+
+            void aggregate(const SparseMatrix& A, const Real aThreshold, std::vector<Integer>& sAggregates, Integer& nbAggregates);
+            void setup(const SparseMatrix& A, const bool bAggregate);
+
+            void smooth(const CSleLevel& aLevel) const;
+            void cycle(const Integer aLevel) const;
+
+        public:
+
+            typedef Real Scalar;
+            typedef typename SparseMatrix::StorageIndex StorageIndex;
+
+            enum {
+                ColsAtCompileTime = Eigen::Dynamic,
+                MaxColsAtCompileTime = Eigen::Dynamic
+            };
+
+            CSleAlgebraicMultigrid();
+            ~CSleAlgebraicMultigrid();
+
+            void setCoarseSize(const Integer aCoarseSize);
+            void setMaxLevels(const Integer aMaxLevels);
+            void setSmoothingSteps(const Integer nbSmoothingSteps);
+            void setStrengthThreshold(const Real aThreshold);
+            void setAggregates(const std::vector<std::vector<Integer> >& sAggregates);
+
+            Integer nbLevels() const;
+            Integer levelSize(const Integer aLevel) const;
+
+            template <typename MatType>
+            CSleAlgebraicMultigrid<Real>& analyzePattern(const MatType& aMatrix);
+
+            template <typename MatType>
+            CSleAlgebraicMultigrid<Real>& factorize(const MatType& aMatrix);
+
+            template <typename MatType>
+            CSleAlgebraicMultigrid<Real>& compute(const MatType& aMatrix);
+
+            // Applies one V-cycle starting from a zero guess
+            template <typename Rhs>
+            Vector solve(const Eigen::MatrixBase<Rhs>& b) const;
+
+            Eigen::ComputationInfo info() const;
+
+        };
+
+    }
+
+}
+
+#include "SleAlgebraicMultigrid_Imp.hpp"
@@ -0,0 +1,442 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace ENigMA
+{
+
+    namespace sle
+    {
+
+        template <typename Real>
+        CSleAlgebraicMultigrid<Real>::CSleAlgebraicMultigrid() :
+            m_coarseSize(200),
+            m_maxLevels(20),
+            m_nbSmoothingSteps(1),
+            m_strengthThreshold(0.08),
+            m_relaxation(2.0 / 3.0),
+            m_isInitialized(false)
+        {
+
+        }
+
+        template <typename Real>
+        CSleAlgebraicMultigrid<Real>::~CSleAlgebraicMultigrid()
+        {
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::setCoarseSize(const Integer aCoarseSize)
+        {
+
+            m_coarseSize = aCoarseSize;
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::setMaxLevels(const Integer aMaxLevels)
+        {
+
+            m_maxLevels = aMaxLevels;
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::setSmoothingSteps(const Integer nbSmoothingSteps)
+        {
+
+            m_nbSmoothingSteps = nbSmoothingSteps;
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::setStrengthThreshold(const Real aThreshold)
+        {
+
+            m_strengthThreshold = aThreshold;
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::setAggregates(const std::vector<std::vector<Integer> >& sAggregates)
+        {
+
+            m_givenAggregates = sAggregates;
+
+            m_nbGivenAggregates.resize(sAggregates.size());
+
+            for (Integer l = 0; l < static_cast<Integer>(sAggregates.size()); ++l)
+            {
+
+                Integer nbAggregates = 0;
+
+                for (Integer i = 0; i < static_cast<Integer>(sAggregates[l].size()); ++i)
+                    nbAggregates = std::max(nbAggregates, sAggregates[l][i] + 1);
+
+                m_nbGivenAggregates[l] = nbAggregates;
+
+            }
+
+        }
+
+        template <typename Real>
+        Integer CSleAlgebraicMultigrid<Real>::nbLevels() const
+        {
+
+            return static_cast<Integer>(m_levels.size());
+
+        }
+
+        template <typename Real>
+        Integer CSleAlgebraicMultigrid<Real>::levelSize(const Integer aLevel) const
+        {
+
+            return static_cast<Integer>(m_levels[aLevel].A.rows());
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::aggregate(const SparseMatrix& A, const Real aThreshold, std::vector<Integer>& sAggregates, Integer& nbAggregates)
+        {
+
+            const Integer n = static_cast<Integer>(A.cols());
+
+            Vector diag = A.diagonal();
+
+            // Strong connections: |a_ij| >= theta * sqrt(|a_ii * a_jj|)
+            std::vector<Integer> sStrongStart(n + 1, 0);
+            std::vector<Integer> sStrong;
+
+            sStrong.reserve(A.nonZeros());
+
+            for (Integer k = 0; k < n; ++k)
+            {
+
+                for (typename SparseMatrix::InnerIterator it(A, k); it; ++it)
+                {
+
+                    Integer i = static_cast<Integer>(it.row());
+
+                    if (i != k && it.value() * it.value() >= aThreshold * aThreshold * std::fabs(diag[i] * diag[k]))
+                        sStrong.push_back(i);
+
+                }
+
+                sStrongStart[k + 1] = static_cast<Integer>(sStrong.size());
+
+            }
+
+            sAggregates.assign(n, -1);
+            nbAggregates = 0;
+
+            // Pass 1: nodes whose whole strong neighbourhood is free become aggregate roots
+            for (Integer i = 0; i < n; ++i)
+            {
+
+                if (sAggregates[i] >= 0 || sStrongStart[i + 1] == sStrongStart[i])
+                    continue;
+
+                bool bFree = true;
+
+                for (Integer j = sStrongStart[i]; j < sStrongStart[i + 1]; ++j)
+                {
+                    if (sAggregates[sStrong[j]] >= 0)
+                    {
+                        bFree = false;
+                        break;
+                    }
+                }
+
+                if (!bFree)
+                    continue;
+
+                sAggregates[i] = nbAggregates;
+
+                for (Integer j = sStrongStart[i]; j < sStrongStart[i + 1]; ++j)
+                    sAggregates[sStrong[j]] = nbAggregates;
+
+                nbAggregates++;
+
+            }
+
+            // Pass 2: remaining nodes join a neighbouring aggregate from pass 1
+            std::vector<Integer> sRoots(sAggregates);
+
+            for (Integer i = 0; i < n; ++i)
+            {
+
+                if (sAggregates[i] >= 0)
+                    continue;
+
+                for (Integer j = sStrongStart[i]; j < sStrongStart[i + 1]; ++j)
+                {
+                    if (sRoots[sStrong[j]] >= 0)
+                    {
+                        sAggregates[i] = sRoots[sStrong[j]];
+                        break;
+                    }
+                }
+
+            }
+
+            // Pass 3: leftovers (including isolated nodes) form their own aggregates
+            for (Integer i = 0; i < n; ++i)
+            {
+
+                if (sAggregates[i] >= 0)
+                    continue;
+
+                sAggregates[i] = nbAggregates;
+
+                for (Integer j = sStrongStart[i]; j < sStrongStart[i + 1]; ++j)
+                {
+                    if (sAggregates[sStrong[j]] < 0)
+                        sAggregates[sStrong[j]] = nbAggregates;
+                }
+
+                nbAggregates++;
+
+            }
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::setup(const SparseMatrix& A, const bool bAggregate)
+        {
+
+            // Given aggregates are kept while their sizes match, the levels below are aggregated from the matrix
+            if (bAggregate)
+            {
+                m_aggregates = m_givenAggregates;
+                m_nbAggregates = m_nbGivenAggregates;
+            }
+
+            m_levels.clear();
+            m_levels.push_back(CSleLevel());
+
+            m_levels.back().A = A;
+            m_levels.back().A.makeCompressed();
+
+            Real aThreshold = m_strengthThreshold;
+
+            for (Integer l = 0; l + 1 < m_maxLevels; ++l)
+            {
+
+                CSleLevel& aLevel = m_levels[l];
+
+                const Integer n = static_cast<Integer>(aLevel.A.rows());
+
+                if (n <= m_coarseSize)
+                    break;
+
+                if (l >= static_cast<Integer>(m_aggregates.size()) || static_cast<Integer>(m_aggregates[l].size()) != n)
+                {
+
+                    std::vector<Integer> sAggregates;
+                    Integer nbAggregates;
+
+                    this->aggregate(aLevel.A, aThreshold, sAggregates, nbAggregates);
+
+                    m_aggregates.resize(l);
+                    m_nbAggregates.resize(l);
+
+                    m_aggregates.push_back(sAggregates);
+                    m_nbAggregates.push_back(nbAggregates);
+
+                }
+
+                const std::vector<Integer>& sAggregates = m_aggregates[l];
+                const Integer nbAggregates = m_nbAggregates[l];
+
+                if (nbAggregates == 0 || nbAggregates >= n)
+                    break;
+
+                // Tentative prolongator from the aggregates (constant near null space)
+                std::vector<Eigen::Triplet<Real> > sTriplets;
+
+                sTriplets.reserve(n);
+
+                for (Integer i = 0; i < n; ++i)
+                    sTriplets.push_back(Eigen::Triplet<Real>(i, sAggregates[i], 1.0));
+
+                SparseMatrix T(n, nbAggregates);
+                T.setFromTriplets(sTriplets.begin(), sTriplets.end());
+
+                aLevel.invDiag.resize(n);
+
+                Real rho = 0.0;
+
+                for (Integer k = 0; k < n; ++k)
+                {
+
+                    Real aDiag = 0.0;
+                    Real aSum = 0.0;
+
+                    for (typename SparseMatrix::InnerIterator it(aLevel.A, k); it; ++it)
+                    {
+                        if (it.row() == k)
+                            aDiag = it.value();
+
+                        aSum += std::fabs(it.value());
+                    }
+
+                    aLevel.invDiag[k] = (aDiag != 0.0) ? 1.0 / aDiag : 0.0;
+
+                    if (aDiag != 0.0)
+                        rho = std::max(rho, aSum / std::fabs(aDiag));
+
+                }
+
+                // Smoothed prolongator P = (I - omega D^-1 A) T with omega = 4/3 / rho(D^-1 A)
+                Real omega = (rho > 0.0) ? 4.0 / 3.0 / rho : 0.0;
+
+                SparseMatrix AT = aLevel.A * T;
+                SparseMatrix DAT = aLevel.invDiag.asDiagonal() * AT;
+
+                aLevel.P = T - omega * DAT;
+                aLevel.P.makeCompressed();
+
+                aLevel.R = aLevel.P.transpose();
+
+                CSleLevel aCoarseLevel;
+
+                aCoarseLevel.A = aLevel.R * (aLevel.A * aLevel.P);
+                aCoarseLevel.A.makeCompressed();
+
+                m_levels.push_back(aCoarseLevel);
+
+                aThreshold *= 0.5;
+
+            }
+
+            for (Integer l = 0; l < static_cast<Integer>(m_levels.size()); ++l)
+            {
+
+                CSleLevel& aLevel = m_levels[l];
+
+                const Integer n = static_cast<Integer>(aLevel.A.rows());
+
+                aLevel.x.resize(n);
+                aLevel.b.resize(n);
+                aLevel.r.resize(n);
+
+            }
+
+            // Coarsest level solved directly. The minimum norm solution keeps singular
+            // (pure Neumann) problems well behaved.
+            m_coarseSolver.compute(Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>(m_levels.back().A));
+
+            m_isInitialized = true;
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::smooth(const CSleLevel& aLevel) const
+        {
+
+            for (Integer s = 0; s < m_nbSmoothingSteps; ++s)
+            {
+
+                aLevel.r = aLevel.b - aLevel.A * aLevel.x;
+                aLevel.x.array() += m_relaxation * aLevel.invDiag.array() * aLevel.r.array();
+
+            }
+
+        }
+
+        template <typename Real>
+        void CSleAlgebraicMultigrid<Real>::cycle(const Integer l) const
+        {
+
+            const CSleLevel& aLevel = m_levels[l];
+
+            if (l + 1 == static_cast<Integer>(m_levels.size()))
+            {
+                aLevel.x = m_coarseSolver.solve(aLevel.b);
+                return;
+            }
+
+            const CSleLevel& aCoarseLevel = m_levels[l + 1];
+
+            aLevel.x.setZero();
+
+            this->smooth(aLevel);
+
+            aLevel.r = aLevel.b - aLevel.A * aLevel.x;
+            aCoarseLevel.b.noalias() = aLevel.R * aLevel.r;
+
+            this->cycle(l + 1);
+
+            aLevel.x.noalias() += aLevel.P * aCoarseLevel.x;
+
+            this->smooth(aLevel);
+
+        }
+
+        template <typename Real>
+        template <typename MatType>
+        CSleAlgebraicMultigrid<Real>& CSleAlgebraicMultigrid<Real>::analyzePattern(const MatType& aMatrix)
+        {
+
+            this->setup(SparseMatrix(aMatrix), true);
+
+            return *this;
+
+        }
+
+        template <typename Real>
+        template <typename MatType>
+        CSleAlgebraicMultigrid<Real>& CSleAlgebraicMultigrid<Real>::factorize(const MatType& aMatrix)
+        {
+
+            // Reuses the aggregates and only recomputes the Galerkin operators
+            this->setup(SparseMatrix(aMatrix), false);
+
+            return *this;
+
+        }
+
+        template <typename Real>
+        template <typename MatType>
+        CSleAlgebraicMultigrid<Real>& CSleAlgebraicMultigrid<Real>::compute(const MatType& aMatrix)
+        {
+
+            return this->analyzePattern(aMatrix);
+
+        }
+
+        template <typename Real>
+        template <typename Rhs>
+        typename CSleAlgebraicMultigrid<Real>::Vector CSleAlgebraicMultigrid<Real>::solve(const Eigen::MatrixBase<Rhs>& b) const
+        {
+
+            m_levels[0].b = b;
+
+            this->cycle(0);
+
+            return m_levels[0].x;
+
+        }
+
+        template <typename Real>
+        Eigen::ComputationInfo CSleAlgebraicMultigrid<Real>::info() const
+        {
+
+            return m_isInitialized ? Eigen::Success : Eigen::InvalidInput;
+
+        }
+
+    }
+
+}
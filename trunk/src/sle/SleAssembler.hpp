@@ -0,0 +1,76 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include "CmnTypes.hpp"
+#include "SlePattern.hpp"
+
+namespace ENigMA
+{
+
+    namespace sle
+    {
+
+        // Collects element contributions into one triplet buffer and one vector per thread so
+        // that elements can be computed inside an OpenMP parallel loop. Duplicated entries are
+        // summed when the buffers are merged into the final matrix.
+        // When a pattern is given the triplets are only needed for the first assembly. Later
+        // assemblies scatter every entry straight into its slot of the cached pattern.
+        template <typename Real>
+        class CSleAssembler
+        {
+        private:
+
+            Integer m_nbRows;
+            Integer m_nbCols;
+
+            std::vector<std::vector<Eigen::Triplet<Real> > > m_triplets;
+            std::vector<Eigen::Matrix<Real, Eigen::Dynamic, 1> > m_vectors;
+
+            CSlePattern<Real>* m_pattern;
+            Integer m_nbElements;
+            bool m_scatter;
+
+            // Current element (recording) or next scatter slot (scattering) of each thread
+            std::vector<Integer> m_cursor;
+            std::vector<std::vector<Integer> > m_entryElements;
+
+            Integer threadId();
+
+            void initThreads();
+            void record(const Eigen::SparseMatrix<Real>& aMatrix);
+
+        public:
+
+            CSleAssembler(const Integer nbRows, const Integer nbCols);
+            CSleAssembler(const Integer nbRows, const Integer nbCols, CSlePattern<Real>& aPattern, const Integer nbElements);
+            ~CSleAssembler();
+
+            void reserve(const Integer nbEntries);
+
+            void setElement(const Integer anElementIndex);
+
+            void addMatrix(const Integer aRow, const Integer aCol, const Real aValue);
+            void addVector(const Integer aRow, const Real aValue);
+
+            void assemble(Eigen::SparseMatrix<Real>& aMatrix, Eigen::Matrix<Real, Eigen::Dynamic, 1>& aVector);
+
+        };
+
+    }
+
+}
+
+#include "SleAssembler_Imp.hpp"
@@ -0,0 +1,270 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ENigMA
+{
+
+    namespace sle
+    {
+
+        template <typename Real>
+        CSleAssembler<Real>::CSleAssembler(const Integer nbRows, const Integer nbCols) :
+            m_nbRows(nbRows),
+            m_nbCols(nbCols),
+            m_pattern(NULL),
+            m_nbElements(0),
+            m_scatter(false)
+        {
+
+            this->initThreads();
+
+        }
+
+        template <typename Real>
+        CSleAssembler<Real>::CSleAssembler(const Integer nbRows, const Integer nbCols, CSlePattern<Real>& aPattern, const Integer nbElements) :
+            m_nbRows(nbRows),
+            m_nbCols(nbCols),
+            m_pattern(&aPattern),
+            m_nbElements(nbElements),
+            m_scatter(false)
+        {
+
+            this->initThreads();
+
+            if (aPattern.isValid() && aPattern.m_matrix.rows() == nbRows && aPattern.m_matrix.cols() == nbCols && aPattern.nbElements() == nbElements)
+            {
+
+                m_scatter = true;
+
+                aPattern.m_matrix.coeffs().setZero();
+
+            }
+            else
+            {
+
+                aPattern.reset();
+
+                m_entryElements.resize(m_triplets.size());
+
+            }
+
+        }
+
+        template <typename Real>
+        CSleAssembler<Real>::~CSleAssembler()
+        {
+
+        }
+
+        template <typename Real>
+        void CSleAssembler<Real>::initThreads()
+        {
+
+            Integer nbThreads = 1;
+
+#ifdef _OPENMP
+            nbThreads = omp_get_max_threads();
+#endif
+
+            m_triplets.resize(nbThreads);
+            m_vectors.resize(nbThreads);
+            m_cursor.assign(nbThreads, -1);
+
+            for (Integer i = 0; i < nbThreads; ++i)
+                m_vectors[i].setZero(m_nbRows);
+
+        }
+
+        template <typename Real>
+        Integer CSleAssembler<Real>::threadId()
+        {
+
+#ifdef _OPENMP
+            return omp_get_thread_num();
+#else
+            return 0;
+#endif
+
+        }
+
+        template <typename Real>
+        void CSleAssembler<Real>::reserve(const Integer nbEntries)
+        {
+
+            if (m_scatter)
+                return;
+
+            const Integer nbThreads = static_cast<Integer>(m_triplets.size());
+
+            for (Integer i = 0; i < nbThreads; ++i)
+            {
+
+                m_triplets[i].reserve(nbEntries / nbThreads + 1);
+
+                if (m_pattern)
+                    m_entryElements[i].reserve(nbEntries / nbThreads + 1);
+
+            }
+
+        }
+
+        template <typename Real>
+        void CSleAssembler<Real>::setElement(const Integer anElementIndex)
+        {
+
+            if (!m_pattern)
+                return;
+
+            if (m_scatter)
+                m_cursor[this->threadId()] = m_pattern->m_elementStart[anElementIndex];
+            else
+                m_cursor[this->threadId()] = anElementIndex;
+
+        }
+
+        template <typename Real>
+        void CSleAssembler<Real>::addMatrix(const Integer aRow, const Integer aCol, const Real aValue)
+        {
+
+            const Integer t = this->threadId();
+
+            if (m_scatter)
+            {
+
+                Real* aSlot = m_pattern->m_matrix.valuePtr() + m_pattern->m_scatter[m_cursor[t]++];
+
+                // Elements of different threads may share nodes
+                #pragma omp atomic
+                *aSlot += aValue;
+
+                return;
+
+            }
+
+            m_triplets[t].push_back(Eigen::Triplet<Real>(aRow, aCol, aValue));
+
+            if (m_pattern)
+                m_entryElements[t].push_back(m_cursor[t]);
+
+        }
+
+        template <typename Real>
+        void CSleAssembler<Real>::addVector(const Integer aRow, const Real aValue)
+        {
+
+            m_vectors[this->threadId()](aRow) += aValue;
+
+        }
+
+        template <typename Real>
+        void CSleAssembler<Real>::record(const Eigen::SparseMatrix<Real>& aMatrix)
+        {
+
+            CSlePattern<Real>& aPattern = *m_pattern;
+
+            // Entries of an element were added by one thread in a fixed order so their
+            // position inside the element is given by the order in the thread buffer
+            aPattern.m_elementStart.assign(m_nbElements + 1, 0);
+
+            for (std::size_t i = 0; i < m_entryElements.size(); ++i)
+            {
+                for (std::size_t j = 0; j < m_entryElements[i].size(); ++j)
+                    aPattern.m_elementStart[m_entryElements[i][j] + 1]++;
+            }
+
+            for (Integer el = 0; el < m_nbElements; ++el)
+                aPattern.m_elementStart[el + 1] += aPattern.m_elementStart[el];
+
+            std::vector<Integer> sNext(aPattern.m_elementStart.begin(), aPattern.m_elementStart.end() - 1);
+
+            aPattern.m_scatter.resize(aPattern.m_elementStart.back());
+
+            const Integer* anOuter = aMatrix.outerIndexPtr();
+            const Integer* anInner = aMatrix.innerIndexPtr();
+
+            for (std::size_t i = 0; i < m_triplets.size(); ++i)
+            {
+
+                for (std::size_t j = 0; j < m_triplets[i].size(); ++j)
+                {
+
+                    const Eigen::Triplet<Real>& aTriplet = m_triplets[i][j];
+
+                    const Integer* aSlot = std::lower_bound(anInner + anOuter[aTriplet.col()], anInner + anOuter[aTriplet.col() + 1], aTriplet.row());
+
+                    aPattern.m_scatter[sNext[m_entryElements[i][j]]++] = static_cast<Integer>(aSlot - anInner);
+
+                }
+
+                std::vector<Integer>().swap(m_entryElements[i]);
+
+            }
+
+            aPattern.m_matrix = aMatrix;
+            aPattern.m_valid = true;
+
+        }
+
+        template <typename Real>
+        void CSleAssembler<Real>::assemble(Eigen::SparseMatrix<Real>& aMatrix, Eigen::Matrix<Real, Eigen::Dynamic, 1>& aVector)
+        {
+
+            if (m_scatter)
+            {
+
+                aMatrix = m_pattern->m_matrix;
+
+            }
+            else
+            {
+
+                std::size_t nbEntries = 0;
+
+                for (std::size_t i = 0; i < m_triplets.size(); ++i)
+                    nbEntries += m_triplets[i].size();
+
+                std::vector<Eigen::Triplet<Real> > sTriplets;
+
+                sTriplets.reserve(nbEntries);
+
+                for (std::size_t i = 0; i < m_triplets.size(); ++i)
+                    sTriplets.insert(sTriplets.end(), m_triplets[i].begin(), m_triplets[i].end());
+
+                aMatrix.resize(m_nbRows, m_nbCols);
+                aMatrix.setFromTriplets(sTriplets.begin(), sTriplets.end());
+
+                if (m_pattern)
+                    this->record(aMatrix);
+
+                for (std::size_t i = 0; i < m_triplets.size(); ++i)
+                    std::vector<Eigen::Triplet<Real> >().swap(m_triplets[i]);
+
+            }
+
+            aVector = m_vectors[0];
+
+            for (std::size_t i = 1; i < m_vectors.size(); ++i)
+                aVector += m_vectors[i];
+
+            for (std::size_t i = 0; i < m_vectors.size(); ++i)
+                m_vectors[i].setZero();
+
+        }
+
+    }
+
+}
@@ -0,0 +1,63 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Sparse>
+
+#include "CmnTypes.hpp"
+
+namespace ENigMA
+{
+
+    namespace sle
+    {
+
+        template <typename Real>
+        class CSleAssembler;
+
+        // Sparsity pattern recorded by the first assembly of an operator. The entries of every
+        // element are mapped to their slots in the values array so that the next assemblies
+        // accumulate directly into the compressed matrix.
+        template <typename Real>
+        class CSlePattern
+        {
+        private:
+
+            Eigen::SparseMatrix<Real> m_matrix;
+
+            std::vector<Integer> m_elementStart;
+            std::vector<Integer> m_scatter;
+
+            bool m_valid;
+
+            friend class CSleAssembler<Real>;
+
+        public:
+
+            CSlePattern();
+            ~CSlePattern();
+
+            void reset();
+
+            bool isValid() const;
+
+            Integer nbElements() const;
+            Integer nbEntries() const;
+            Integer nbNonZeros() const;
+
+        };
+
+    }
+
+}
+
+#include "SlePattern_Imp.hpp"
@@ -0,0 +1,78 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+namespace ENigMA
+{
+
+    namespace sle
+    {
+
+        template <typename Real>
+        CSlePattern<Real>::CSlePattern() : m_valid(false)
+        {
+
+        }
+
+        template <typename Real>
+        CSlePattern<Real>::~CSlePattern()
+        {
+
+        }
+
+        template <typename Real>
+        void CSlePattern<Real>::reset()
+        {
+
+            m_matrix.resize(0, 0);
+            m_matrix.data().squeeze();
+
+            m_elementStart.clear();
+            m_scatter.clear();
+
+            m_valid = false;
+
+        }
+
+        template <typename Real>
+        bool CSlePattern<Real>::isValid() const
+        {
+
+            return m_valid;
+
+        }
+
+        template <typename Real>
+        Integer CSlePattern<Real>::nbElements() const
+        {
+
+            return m_elementStart.empty() ? 0 : static_cast<Integer>(m_elementStart.size()) - 1;
+
+        }
+
+        template <typename Real>
+        Integer CSlePattern<Real>::nbEntries() const
+        {
+
+            return static_cast<Integer>(m_scatter.size());
+
+        }
+
+        template <typename Real>
+        Integer CSlePattern<Real>::nbNonZeros() const
+        {
+
+            return static_cast<Integer>(m_matrix.nonZeros());
+
+        }
+
+    }
+
+}
@@ -0,0 +1,118 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Sparse>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseLU>
+
+#include "CmnTypes.hpp"
+#include "SleSystem.hpp"
+#include "SleAlgebraicMultigrid.hpp"
+
+namespace ENigMA
+{
+
+    namespace sle
+    {
+
+        enum EPreconditionerType
+        {
+            PT_JACOBI = 0,
+            PT_INCOMPLETE_CHOLESKY,
+            PT_INCOMPLETE_LUT,
+            PT_ALGEBRAIC_MULTIGRID
+        };
+
+        template <typename Real>
+        class CSleSolver
+        {
+        private:
+
+            EPreconditionerType m_preconditionerType;
+            Real m_tolerance;
+            Integer m_maxIterations;
+
+            EMatrixType m_matrixType;
+
+            // Private copy of the last matrix. The cached solvers reference it so it must outlive them.
+            Eigen::SparseMatrix<Real> m_matrix;
+            bool m_analysed;
+
+            Integer m_nbAnalyses;
+            Integer m_nbFactorizations;
+
+            Integer m_iterations;
+            Real m_error;
+
+            Eigen::ConjugateGradient<Eigen::SparseMatrix<Real>, Eigen::Lower, Eigen::DiagonalPreconditioner<Real> > m_cgJacobi;
+            Eigen::ConjugateGradient<Eigen::SparseMatrix<Real>, Eigen::Lower, Eigen::IncompleteCholesky<Real> > m_cgCholesky;
+            Eigen::BiCGSTAB<Eigen::SparseMatrix<Real>, Eigen::DiagonalPreconditioner<Real> > m_bicgJacobi;
+            Eigen::BiCGSTAB<Eigen::SparseMatrix<Real>, Eigen::IncompleteLUT<Real> > m_bicgIncompleteLUT;
+            Eigen::ConjugateGradient<Eigen::SparseMatrix<Real>, Eigen::Lower | Eigen::Upper, CSleAlgebraicMultigrid<Real> > m_cgMultigrid;
+            Eigen::BiCGSTAB<Eigen::SparseMatrix<Real>, CSleAlgebraicMultigrid<Real> > m_bicgMultigrid;
+            Eigen::SparseLU<Eigen::SparseMatrix<Real, Eigen::ColMajor>, Eigen::COLAMDOrdering<Integer> > m_sparseLU;
+
+            bool samePattern(const Eigen::SparseMatrix<Real>& aMatrix);
+            bool sameValues(const Eigen::SparseMatrix<Real>& aMatrix);
+
+            void analyzePattern();
+            void factorize();
+
+            void update(const EMatrixType aMatrixType, Eigen::SparseMatrix<Real>& aMatrix);
+
+            template <typename Solver>
+            Eigen::Matrix<Real, Eigen::Dynamic, 1> iterativeSolve(Solver& aSolver, const Eigen::Matrix<Real, Eigen::Dynamic, 1>& aVector);
+
+            template <typename Preconditioner>
+            void precondition(const Preconditioner& aPreconditioner, const Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& aBlock, Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& aResult, const std::vector<bool>& sActive);
+
+            template <typename Preconditioner>
+            Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> blockSolve(const Preconditioner& aPreconditioner, const Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& aBlock);
+
+        public:
+
+            CSleSolver();
+            ~CSleSolver();
+
+            void setPreconditioner(const EPreconditionerType aPreconditionerType);
+            EPreconditionerType preconditioner();
+
+            void setAggregates(const std::vector<std::vector<Integer> >& sAggregates);
+
+            void setTolerance(const Real aTolerance);
+            Real tolerance();
+
+            void setMaxIterations(const Integer aMaxIterations);
+            Integer maxIterations();
+
+            void reset();
+
+            Eigen::Matrix<Real, Eigen::Dynamic, 1> solve(const EMatrixType aMatrixType, Eigen::SparseMatrix<Real>& aMatrix, const Eigen::Matrix<Real, Eigen::Dynamic, 1>& aVector);
+
+            // Solves one system per column of aBlock. Non-symmetric sparse systems are iterated
+            // together so each matrix-vector product traverses the matrix only once.
+            Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> solve(const EMatrixType aMatrixType, Eigen::SparseMatrix<Real>& aMatrix, const Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& aBlock);
+
+            Integer iterations();
+            Real error();
+
+            Integer nbAnalyses();
+            Integer nbFactorizations();
+
+        };
+
+    }
+
+}
+
+#include "SleSolver_Imp.hpp"
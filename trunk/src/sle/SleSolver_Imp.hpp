@@ -0,0 +1,565 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ENigMA
+{
+
+    namespace sle
+    {
+
+        template <typename Real>
+        CSleSolver<Real>::CSleSolver() :
+            m_preconditionerType(PT_JACOBI),
+            m_tolerance(std::numeric_limits<Real>::epsilon()),
+            m_maxIterations(-1),
+            m_matrixType(MT_UNKNOWN),
+            m_analysed(false),
+            m_nbAnalyses(0),
+            m_nbFactorizations(0),
+            m_iterations(0),
+            m_error(0.0)
+        {
+
+        }
+
+        template <typename Real>
+        CSleSolver<Real>::~CSleSolver()
+        {
+
+        }
+
+        template <typename Real>
+        void CSleSolver<Real>::setPreconditioner(const EPreconditionerType aPreconditionerType)
+        {
+
+            if (aPreconditionerType != m_preconditionerType)
+                this->reset();
+
+            m_preconditionerType = aPreconditionerType;
+
+        }
+
+        template <typename Real>
+        EPreconditionerType CSleSolver<Real>::preconditioner()
+        {
+
+            return m_preconditionerType;
+
+        }
+
+        template <typename Real>
+        void CSleSolver<Real>::setAggregates(const std::vector<std::vector<Integer> >& sAggregates)
+        {
+
+            // Only used by the multigrid preconditioner, the next solve rebuilds its hierarchy
+            m_cgMultigrid.preconditioner().setAggregates(sAggregates);
+            m_bicgMultigrid.preconditioner().setAggregates(sAggregates);
+
+            this->reset();
+
+        }
+
+        template <typename Real>
+        void CSleSolver<Real>::setTolerance(const Real aTolerance)
+        {
+
+            m_tolerance = aTolerance;
+
+        }
+
+        template <typename Real>
+        Real CSleSolver<Real>::tolerance()
+        {
+
+            return m_tolerance;
+
+        }
+
+        template <typename Real>
+        void CSleSolver<Real>::setMaxIterations(const Integer aMaxIterations)
+        {
+
+            m_maxIterations = aMaxIterations;
+
+        }
+
+        template <typename Real>
+        Integer CSleSolver<Real>::maxIterations()
+        {
+
+            return m_maxIterations;
+
+        }
+
+        template <typename Real>
+        void CSleSolver<Real>::reset()
+        {
+
+            m_analysed = false;
+
+            m_matrix.resize(0, 0);
+            m_matrix.data().squeeze();
+
+        }
+
+        template <typename Real>
+        bool CSleSolver<Real>::samePattern(const Eigen::SparseMatrix<Real>& aMatrix)
+        {
+
+            if (!m_analysed)
+                return false;
+
+            return ENigMA::sle::samePattern(aMatrix, m_matrix);
+
+        }
+
+        template <typename Real>
+        bool CSleSolver<Real>::sameValues(const Eigen::SparseMatrix<Real>& aMatrix)
+        {
+
+            return std::equal(aMatrix.valuePtr(), aMatrix.valuePtr() + aMatrix.nonZeros(), m_matrix.valuePtr());
+
+        }
+
+        template <typename Real>
+        void CSleSolver<Real>::analyzePattern()
+        {
+
+            if (m_matrixType == MT_SPARSE_SYMMETRIC)
+            {
+
+                if (m_preconditionerType == PT_JACOBI)
+                    m_cgJacobi.analyzePattern(m_matrix);
+                else if (m_preconditionerType == PT_ALGEBRAIC_MULTIGRID)
+                    m_cgMultigrid.analyzePattern(m_matrix);
+                else
+                    m_cgCholesky.analyzePattern(m_matrix);
+
+            }
+            else if (m_matrixType == MT_SPARSE)
+            {
+
+                if (m_preconditionerType == PT_JACOBI)
+                    m_bicgJacobi.analyzePattern(m_matrix);
+                else if (m_preconditionerType == PT_ALGEBRAIC_MULTIGRID)
+                    m_bicgMultigrid.analyzePattern(m_matrix);
+                else
+                    m_bicgIncompleteLUT.analyzePattern(m_matrix);
+
+            }
+            else if (m_matrixType == MT_DENSE)
+            {
+
+                m_sparseLU.analyzePattern(m_matrix);
+
+            }
+
+            m_nbAnalyses++;
+
+        }
+
+        template <typename Real>
+        void CSleSolver<Real>::factorize()
+        {
+
+            // Incomplete Cholesky is only valid for symmetric matrices and incomplete LU is
+            // used for the non-symmetric ones, so each matrix type picks its own variant.
+            // The multigrid keeps its aggregates and only rebuilds the Galerkin operators.
+            if (m_matrixType == MT_SPARSE_SYMMETRIC)
+            {
+
+                if (m_preconditionerType == PT_JACOBI)
+                    m_cgJacobi.factorize(m_matrix);
+                else if (m_preconditionerType == PT_ALGEBRAIC_MULTIGRID)
+                    m_cgMultigrid.factorize(m_matrix);
+                else
+                    m_cgCholesky.factorize(m_matrix);
+
+            }
+            else if (m_matrixType == MT_SPARSE)
+            {
+
+                if (m_preconditionerType == PT_JACOBI)
+                    m_bicgJacobi.factorize(m_matrix);
+                else if (m_preconditionerType == PT_ALGEBRAIC_MULTIGRID)
+                    m_bicgMultigrid.factorize(m_matrix);
+                else
+                    m_bicgIncompleteLUT.factorize(m_matrix);
+
+            }
+            else if (m_matrixType == MT_DENSE)
+            {
+
+                m_sparseLU.factorize(m_matrix);
+
+            }
+
+            m_nbFactorizations++;
+
+        }
+
+        template <typename Real>
+        void CSleSolver<Real>::update(const EMatrixType aMatrixType, Eigen::SparseMatrix<Real>& aMatrix)
+        {
+
+            aMatrix.makeCompressed();
+
+            if (aMatrixType != m_matrixType)
+            {
+                this->reset();
+                m_matrixType = aMatrixType;
+            }
+
+            if (!this->samePattern(aMatrix))
+            {
+
+                m_matrix = aMatrix;
+
+                this->analyzePattern();
+                this->factorize();
+
+                m_analysed = true;
+
+            }
+            else if (!this->sameValues(aMatrix))
+            {
+
+                std::copy(aMatrix.valuePtr(), aMatrix.valuePtr() + aMatrix.nonZeros(), m_matrix.valuePtr());
+
+                this->factorize();
+
+            }
+
+        }
+
+        template <typename Real>
+        template <typename Solver>
+        Eigen::Matrix<Real, Eigen::Dynamic, 1> CSleSolver<Real>::iterativeSolve(Solver& aSolver, const Eigen::Matrix<Real, Eigen::Dynamic, 1>& aVector)
+        {
+
+            aSolver.setTolerance(m_tolerance);
+            aSolver.setMaxIterations(m_maxIterations);
+
+            Eigen::Matrix<Real, Eigen::Dynamic, 1> x = aSolver.solve(aVector);
+
+            m_iterations = static_cast<Integer>(aSolver.iterations());
+            m_error = aSolver.error();
+
+            return x;
+
+        }
+
+        template <typename Real>
+        template <typename Preconditioner>
+        void CSleSolver<Real>::precondition(const Preconditioner& aPreconditioner, const Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& aBlock, Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& aResult, const std::vector<bool>& sActive)
+        {
+
+            for (Integer j = 0; j < static_cast<Integer>(aBlock.cols()); ++j)
+            {
+
+                if (sActive[j])
+                    aResult.col(j) = aPreconditioner.solve(aBlock.col(j));
+                else
+                    aResult.col(j).setZero();
+
+            }
+
+        }
+
+        template <typename Real>
+        template <typename Preconditioner>
+        Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> CSleSolver<Real>::blockSolve(const Preconditioner& aPreconditioner, const Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& aBlock)
+        {
+
+            // Preconditioned BiCGSTAB run on all columns at once. Every column keeps its own
+            // scalars and stops independently. Row major storage for both the matrix and the
+            // block lets Eigen compute A * X in a single (multithreaded) pass over the matrix.
+            typedef Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> CBlock;
+
+            const Integer n = static_cast<Integer>(aBlock.rows());
+            const Integer m = static_cast<Integer>(aBlock.cols());
+
+            Eigen::SparseMatrix<Real, Eigen::RowMajor> A = m_matrix;
+
+            CBlock X = CBlock::Zero(n, m);
+            CBlock R = aBlock;
+            CBlock R0 = aBlock;
+            CBlock P = CBlock::Zero(n, m);
+            CBlock V = CBlock::Zero(n, m);
+            CBlock S = CBlock::Zero(n, m);
+            CBlock T(n, m), Y(n, m), Z(n, m);
+
+            std::vector<Real> rho(m, 1.0), alpha(m, 1.0), omega(m, 1.0);
+            std::vector<Real> sRhsNorm2(m), sR0Norm2(m);
+            std::vector<bool> sActive(m);
+
+            const Real eps2 = std::numeric_limits<Real>::epsilon() * std::numeric_limits<Real>::epsilon();
+            const Integer nbMaxIterations = (m_maxIterations < 0) ? 2 * n : m_maxIterations;
+
+            for (Integer j = 0; j < m; ++j)
+            {
+
+                sRhsNorm2[j] = aBlock.col(j).squaredNorm();
+                sR0Norm2[j] = sRhsNorm2[j];
+                sActive[j] = sRhsNorm2[j] > 0.0;
+
+            }
+
+            Integer i = 0;
+
+            while (i < nbMaxIterations)
+            {
+
+                bool bActive = false;
+
+                for (Integer j = 0; j < m; ++j)
+                {
+
+                    if (sActive[j] && R.col(j).squaredNorm() <= m_tolerance * m_tolerance * sRhsNorm2[j])
+                        sActive[j] = false;
+
+                    bActive = bActive || sActive[j];
+
+                }
+
+                if (!bActive)
+                    break;
+
+                for (Integer j = 0; j < m; ++j)
+                {
+
+                    if (!sActive[j])
+                        continue;
+
+                    Real rhoOld = rho[j];
+
+                    rho[j] = R0.col(j).dot(R.col(j));
+
+                    // Restart when the residual became orthogonal to the shadow residual
+                    if (std::fabs(rho[j]) < eps2 * sR0Norm2[j])
+                    {
+
+                        R0.col(j) = R.col(j);
+                        rho[j] = sR0Norm2[j] = R.col(j).squaredNorm();
+
+                    }
+
+                    Real beta = (rho[j] / rhoOld) * (alpha[j] / omega[j]);
+
+                    P.col(j) = R.col(j) + beta * (P.col(j) - omega[j] * V.col(j));
+
+                }
+
+                this->precondition(aPreconditioner, P, Y, sActive);
+
+                V.noalias() = A * Y;
+
+                for (Integer j = 0; j < m; ++j)
+                {
+
+                    if (!sActive[j])
+                        continue;
+
+                    Real r0v = R0.col(j).dot(V.col(j));
+
+                    if (r0v == 0.0)
+                    {
+                        sActive[j] = false;
+                        continue;
+                    }
+
+                    alpha[j] = rho[j] / r0v;
+
+                    S.col(j) = R.col(j) - alpha[j] * V.col(j);
+
+                }
+
+                this->precondition(aPreconditioner, S, Z, sActive);
+
+                T.noalias() = A * Z;
+
+                for (Integer j = 0; j < m; ++j)
+                {
+
+                    if (!sActive[j])
+                        continue;
+
+                    Real tt = T.col(j).squaredNorm();
+
+                    omega[j] = (tt > 0.0) ? T.col(j).dot(S.col(j)) / tt : 0.0;
+
+                    X.col(j) += alpha[j] * Y.col(j) + omega[j] * Z.col(j);
+                    R.col(j) = S.col(j) - omega[j] * T.col(j);
+
+                }
+
+                i++;
+
+            }
+
+            m_iterations = i;
+            m_error = 0.0;
+
+            for (Integer j = 0; j < m; ++j)
+            {
+                if (sRhsNorm2[j] > 0.0)
+                    m_error = std::max(m_error, std::sqrt(R.col(j).squaredNorm() / sRhsNorm2[j]));
+            }
+
+            return X;
+
+        }
+
+        template <typename Real>
+        Eigen::Matrix<Real, Eigen::Dynamic, 1> CSleSolver<Real>::solve(const EMatrixType aMatrixType, Eigen::SparseMatrix<Real>& aMatrix, const Eigen::Matrix<Real, Eigen::Dynamic, 1>& aVector)
+        {
+
+            Eigen::Matrix<Real, Eigen::Dynamic, 1> x;
+
+            this->update(aMatrixType, aMatrix);
+
+            m_iterations = 0;
+            m_error = 0.0;
+
+            if (m_matrixType == MT_SPARSE_SYMMETRIC)
+            {
+
+                if (m_preconditionerType == PT_JACOBI)
+                    x = this->iterativeSolve(m_cgJacobi, aVector);
+                else if (m_preconditionerType == PT_ALGEBRAIC_MULTIGRID)
+                    x = this->iterativeSolve(m_cgMultigrid, aVector);
+                else
+                    x = this->iterativeSolve(m_cgCholesky, aVector);
+
+            }
+            else if (m_matrixType == MT_SPARSE)
+            {
+
+                if (m_preconditionerType == PT_JACOBI)
+                    x = this->iterativeSolve(m_bicgJacobi, aVector);
+                else if (m_preconditionerType == PT_ALGEBRAIC_MULTIGRID)
+                    x = this->iterativeSolve(m_bicgMultigrid, aVector);
+                else
+                    x = this->iterativeSolve(m_bicgIncompleteLUT, aVector);
+
+            }
+            else if (m_matrixType == MT_DENSE)
+            {
+
+                x = m_sparseLU.solve(aVector);
+
+            }
+
+            return x;
+
+        }
+
+        template <typename Real>
+        Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> CSleSolver<Real>::solve(const EMatrixType aMatrixType, Eigen::SparseMatrix<Real>& aMatrix, const Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic>& aBlock)
+        {
+
+            Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> X;
+
+            this->update(aMatrixType, aMatrix);
+
+            m_iterations = 0;
+            m_error = 0.0;
+
+            if (m_matrixType == MT_SPARSE_SYMMETRIC)
+            {
+
+                X.resize(aBlock.rows(), aBlock.cols());
+
+                Integer nbIterations = 0;
+                Real anError = 0.0;
+
+                for (Integer j = 0; j < static_cast<Integer>(aBlock.cols()); ++j)
+                {
+
+                    Eigen::Matrix<Real, Eigen::Dynamic, 1> b = aBlock.col(j);
+
+                    if (m_preconditionerType == PT_JACOBI)
+                        X.col(j) = this->iterativeSolve(m_cgJacobi, b);
+                    else if (m_preconditionerType == PT_ALGEBRAIC_MULTIGRID)
+                        X.col(j) = this->iterativeSolve(m_cgMultigrid, b);
+                    else
+                        X.col(j) = this->iterativeSolve(m_cgCholesky, b);
+
+                    nbIterations = std::max(nbIterations, m_iterations);
+                    anError = std::max(anError, m_error);
+
+                }
+
+                m_iterations = nbIterations;
+                m_error = anError;
+
+            }
+            else if (m_matrixType == MT_SPARSE)
+            {
+
+                if (m_preconditionerType == PT_JACOBI)
+                    X = this->blockSolve(m_bicgJacobi.preconditioner(), aBlock);
+                else if (m_preconditionerType == PT_ALGEBRAIC_MULTIGRID)
+                    X = this->blockSolve(m_bicgMultigrid.preconditioner(), aBlock);
+                else
+                    X = this->blockSolve(m_bicgIncompleteLUT.preconditioner(), aBlock);
+
+            }
+            else if (m_matrixType == MT_DENSE)
+            {
+
+                X = m_sparseLU.solve(aBlock);
+
+            }
+
+            return X;
+
+        }
+
+        template <typename Real>
+        Integer CSleSolver<Real>::iterations()
+        {
+
+            return m_iterations;
+
+        }
+
+        template <typename Real>
+        Real CSleSolver<Real>::error()
+        {
+
+            return m_error;
+
+        }
+
+        template <typename Real>
+        Integer CSleSolver<Real>::nbAnalyses()
+        {
+
+            return m_nbAnalyses;
+
+        }
+
+        template <typename Real>
+        Integer CSleSolver<Real>::nbFactorizations()
+        {
+
+            return m_nbFactorizations;
+
+        }
+
+    }
+
+}
@@ -11,6 +11,8 @@
 
 #include <Eigen/Sparse>
 
+#include "CmnTypes.hpp"
+
 namespace ENigMA
 {
 
@@ -26,11 +28,42 @@ namespace ENigMA
         };
 
         template <typename Real>
-        class CSleSystem
+        class CSleSolver;
+
+        template <typename Real>
+        class CSleSystem;
+
+        // Base of the lazy operator algebra. Operands are referenced, so an expression
+        // must be evaluated into a CSleSystem within the statement that builds it.
+        template <typename Real, typename Derived>
+        class CSleExpression
         {
+        public:
+
+            const Derived& derived() const;
+
+            CSleSystem<Real> operator= (const Real right) const;
+            CSleSystem<Real> operator= (Eigen::Matrix<Real, Eigen::Dynamic, 1> right) const;
+
+        };
+
+        template <typename Real>
+        class CSleSystem : public CSleExpression<Real, CSleSystem<Real> >
+        {
+        private:
+
+            CSleSolver<Real>* m_solver;
+
+            template <typename Derived>
+            void evaluate(const Derived& anExpression);
+
         public:
 
             CSleSystem();
+
+            template <typename Derived>
+            CSleSystem(const CSleExpression<Real, Derived>& anExpression);
+
             ~CSleSystem();
 
             EMatrixType matrixType;
@@ -38,34 +71,198 @@ namespace ENigMA
             Eigen::SparseMatrix<Real> matrixA;
             Eigen::Matrix<Real, Eigen::Dynamic, 1> vectorB;
 
+            void setSolver(CSleSolver<Real>& aSolver);
+            CSleSolver<Real>* solver() const;
+
             Eigen::Matrix<Real, Eigen::Dynamic, 1> solve();
 
+            template <typename Derived>
+            CSleSystem<Real>& operator= (const CSleExpression<Real, Derived>& anExpression);
+
             CSleSystem<Real>& operator= (const Real right);
             CSleSystem<Real>& operator= (Eigen::Matrix<Real, Eigen::Dynamic, 1> right);
 
         };
 
+        // Expression leaf referencing an assembled system
         template <typename Real>
-        CSleSystem<Real> operator- (const CSleSystem<Real>& left, const Real right);
+        class CSleTerminal
+        {
+        private:
 
-        template <typename Real>
-        CSleSystem<Real> operator+ (const CSleSystem<Real>& left, const Real right);
+            const CSleSystem<Real>& m_system;
 
-        template <typename Real>
-        CSleSystem<Real> operator+ (const CSleSystem<Real>& left, const CSleSystem<Real>& right); 
+        public:
+
+            CSleTerminal(const CSleSystem<Real>& aSystem);
+
+            const Eigen::SparseMatrix<Real>& pattern() const;
+            bool fusable(const Eigen::SparseMatrix<Real>& aPattern) const;
+
+            Real coeff(const Integer p, const Integer aRow, const Integer aCol) const;
+            Real rhs(const Integer i) const;
+
+            const Eigen::SparseMatrix<Real>& matrix() const;
+
+            EMatrixType type() const;
+            CSleSolver<Real>* solver() const;
+
+        };
+
+        // Systems are nested by reference through a terminal, inner nodes by value
+        template <typename Derived>
+        struct CSleNested
+        {
+            typedef Derived type;
+        };
 
         template <typename Real>
-        CSleSystem<Real> operator- (const CSleSystem<Real>& left, const CSleSystem<Real>& right); 
+        struct CSleNested<CSleSystem<Real> >
+        {
+            typedef CSleTerminal<Real> type;
+        };
+
+        template <typename Real, typename Left, typename Right>
+        class CSleSum : public CSleExpression<Real, CSleSum<Real, Left, Right> >
+        {
+        private:
+
+            typename CSleNested<Left>::type m_left;
+            typename CSleNested<Right>::type m_right;
+
+            Real m_sign;
+
+        public:
+
+            CSleSum(const Left& aLeft, const Right& aRight, const Real aSign);
+
+            using CSleExpression<Real, CSleSum<Real, Left, Right> >::operator=;
+
+            const Eigen::SparseMatrix<Real>& pattern() const;
+            bool fusable(const Eigen::SparseMatrix<Real>& aPattern) const;
+
+            Real coeff(const Integer p, const Integer aRow, const Integer aCol) const;
+            Real rhs(const Integer i) const;
+
+            Eigen::SparseMatrix<Real> matrix() const;
+
+            EMatrixType type() const;
+            CSleSolver<Real>* solver() const;
+
+        };
+
+        template <typename Real, typename Derived>
+        class CSleScale : public CSleExpression<Real, CSleScale<Real, Derived> >
+        {
+        private:
+
+            typename CSleNested<Derived>::type m_expression;
+
+            Real m_scale;
+
+        public:
+
+            CSleScale(const Derived& anExpression, const Real aScale);
+
+            using CSleExpression<Real, CSleScale<Real, Derived> >::operator=;
+
+            const Eigen::SparseMatrix<Real>& pattern() const;
+            bool fusable(const Eigen::SparseMatrix<Real>& aPattern) const;
+
+            Real coeff(const Integer p, const Integer aRow, const Integer aCol) const;
+            Real rhs(const Integer i) const;
+
+            Eigen::SparseMatrix<Real> matrix() const;
+
+            EMatrixType type() const;
+            CSleSolver<Real>* solver() const;
+
+        };
+
+        // Adds a constant to the diagonal and to the right hand side
+        template <typename Real, typename Derived>
+        class CSleShift : public CSleExpression<Real, CSleShift<Real, Derived> >
+        {
+        private:
+
+            typename CSleNested<Derived>::type m_expression;
+
+            Real m_shift;
+
+        public:
+
+            CSleShift(const Derived& anExpression, const Real aShift);
+
+            using CSleExpression<Real, CSleShift<Real, Derived> >::operator=;
+
+            const Eigen::SparseMatrix<Real>& pattern() const;
+            bool fusable(const Eigen::SparseMatrix<Real>& aPattern) const;
+
+            Real coeff(const Integer p, const Integer aRow, const Integer aCol) const;
+            Real rhs(const Integer i) const;
+
+            Eigen::SparseMatrix<Real> matrix() const;
+
+            EMatrixType type() const;
+            CSleSolver<Real>* solver() const;
+
+        };
+
+        // Scales each row of the matrix and the right hand side
+        template <typename Real, typename Derived>
+        class CSleRowScale : public CSleExpression<Real, CSleRowScale<Real, Derived> >
+        {
+        private:
+
+            typename CSleNested<Derived>::type m_expression;
+
+            const Eigen::Matrix<Real, Eigen::Dynamic, 1>& m_scale;
+
+        public:
+
+            CSleRowScale(const Derived& anExpression, const Eigen::Matrix<Real, Eigen::Dynamic, 1>& aScale);
+
+            using CSleExpression<Real, CSleRowScale<Real, Derived> >::operator=;
+
+            const Eigen::SparseMatrix<Real>& pattern() const;
+            bool fusable(const Eigen::SparseMatrix<Real>& aPattern) const;
+
+            Real coeff(const Integer p, const Integer aRow, const Integer aCol) const;
+            Real rhs(const Integer i) const;
+
+            Eigen::SparseMatrix<Real> matrix() const;
+
+            EMatrixType type() const;
+            CSleSolver<Real>* solver() const;
+
+        };
 
         template <typename Real>
-        CSleSystem<Real> operator* (const Real left, const CSleSystem<Real>& right); 
+        bool samePattern(const Eigen::SparseMatrix<Real>& left, const Eigen::SparseMatrix<Real>& right);
 
         template <typename Real>
-        CSleSystem<Real> operator* (const Eigen::Matrix<Real, Eigen::Dynamic, 1>& left, const CSleSystem<Real>& right);
+        bool hasDiagonal(const Eigen::SparseMatrix<Real>& aMatrix);
+
+        template <typename Real, typename Derived>
+        CSleShift<Real, Derived> operator- (const CSleExpression<Real, Derived>& left, const Real right);
+
+        template <typename Real, typename Derived>
+        CSleShift<Real, Derived> operator+ (const CSleExpression<Real, Derived>& left, const Real right);
+
+        template <typename Real, typename Left, typename Right>
+        CSleSum<Real, Left, Right> operator+ (const CSleExpression<Real, Left>& left, const CSleExpression<Real, Right>& right);
+
+        template <typename Real, typename Left, typename Right>
+        CSleSum<Real, Left, Right> operator- (const CSleExpression<Real, Left>& left, const CSleExpression<Real, Right>& right);
+
+        template <typename Real, typename Derived>
+        CSleScale<Real, Derived> operator* (const Real left, const CSleExpression<Real, Derived>& right);
+
+        template <typename Real, typename Derived>
+        CSleRowScale<Real, Derived> operator* (const Eigen::Matrix<Real, Eigen::Dynamic, 1>& left, const CSleExpression<Real, Derived>& right);
 
     }
 
 }
 
 #include "SleSystem_Imp.hpp"
-
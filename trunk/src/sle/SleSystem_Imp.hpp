@@ -9,9 +9,13 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <Eigen/IterativeLinearSolvers>
 #include <Eigen/SparseLU>
 
+#include "SleSolver.hpp"
+
 #ifdef USE_VIENNACL
 
 #define VIENNACL_HAVE_EIGEN 1
@@ -31,11 +35,22 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CSleSystem<Real>::CSleSystem()
+        CSleSystem<Real>::CSleSystem() : m_solver(NULL)
+        {
+
+            matrixType = MT_UNKNOWN;
+
+        }
+
+        template <typename Real>
+        template <typename Derived>
+        CSleSystem<Real>::CSleSystem(const CSleExpression<Real, Derived>& anExpression) : m_solver(NULL)
         {
 
             matrixType = MT_UNKNOWN;
 
+            this->evaluate(anExpression.derived());
+
         }
 
         template <typename Real>
@@ -44,12 +59,32 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        void CSleSystem<Real>::setSolver(CSleSolver<Real>& aSolver)
+        {
+
+            m_solver = &aSolver;
+
+        }
+
+        template <typename Real>
+        CSleSolver<Real>* CSleSystem<Real>::solver() const
+        {
+
+            return m_solver;
+
+        }
+
         template <typename Real>
         Eigen::Matrix<Real, Eigen::Dynamic, 1> CSleSystem<Real>::solve()
         {
 
             Eigen::Matrix<Real, Eigen::Dynamic, 1> x;
 
+            // A configured solver keeps its analysis and factorization between calls
+            if (m_solver)
+                return m_solver->solve(matrixType, matrixA, vectorB);
+
             if (matrixType == MT_SPARSE_SYMMETRIC)
             {
 
@@ -97,6 +132,68 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        template <typename Derived>
+        void CSleSystem<Real>::evaluate(const Derived& anExpression)
+        {
+
+            const Eigen::SparseMatrix<Real>& aPattern = anExpression.pattern();
+
+            matrixType = anExpression.type();
+            m_solver = anExpression.solver();
+
+            // Operators sharing the pattern of the first term are combined entry by entry in one pass
+            if (aPattern.isCompressed() && anExpression.fusable(aPattern))
+            {
+
+                matrixA.resize(aPattern.rows(), aPattern.cols());
+                matrixA.resizeNonZeros(aPattern.nonZeros());
+
+                std::copy(aPattern.outerIndexPtr(), aPattern.outerIndexPtr() + aPattern.outerSize() + 1, matrixA.outerIndexPtr());
+                std::copy(aPattern.innerIndexPtr(), aPattern.innerIndexPtr() + aPattern.nonZeros(), matrixA.innerIndexPtr());
+
+                const Integer* outer = aPattern.outerIndexPtr();
+                const Integer* inner = aPattern.innerIndexPtr();
+
+                Real* values = matrixA.valuePtr();
+
+                for (Integer k = 0; k < aPattern.outerSize(); ++k)
+                {
+
+                    for (Integer p = outer[k]; p < outer[k + 1]; ++p)
+                        values[p] = anExpression.coeff(p, inner[p], k);
+
+                }
+
+            }
+            else
+                matrixA = anExpression.matrix();
+
+            vectorB.resize(aPattern.rows());
+
+            for (Integer i = 0; i < vectorB.size(); ++i)
+                vectorB[i] = anExpression.rhs(i);
+
+        }
+
+        template <typename Real>
+        template <typename Derived>
+        CSleSystem<Real>& CSleSystem<Real>::operator= (const CSleExpression<Real, Derived>& anExpression)
+        {
+
+            // Evaluate aside first since the expression may reference this system
+            CSleSystem<Real> aSystem(anExpression);
+
+            matrixType = aSystem.matrixType;
+            m_solver = aSystem.m_solver;
+
+            matrixA.swap(aSystem.matrixA);
+            vectorB.swap(aSystem.vectorB);
+
+            return *this;
+
+        }
+
         template <typename Real>
         CSleSystem<Real>& CSleSystem<Real>::operator= (const Real right)
         {
@@ -115,119 +212,446 @@ namespace ENigMA
 
         }
 
-        template <typename Real>
-        CSleSystem<Real> operator- (const CSleSystem<Real>& left, const Real right)
+        template <typename Real, typename Derived>
+        const Derived& CSleExpression<Real, Derived>::derived() const
         {
 
-            CSleSystem<Real> aSystem;
+            return static_cast<const Derived&>(*this);
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleSystem<Real> CSleExpression<Real, Derived>::operator= (const Real right) const
+        {
+
+            CSleSystem<Real> aSystem(*this);
+
+            aSystem = right;
 
-            aSystem.matrixType = left.matrixType;
+            return aSystem;
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleSystem<Real> CSleExpression<Real, Derived>::operator= (Eigen::Matrix<Real, Eigen::Dynamic, 1> right) const
+        {
 
-            aSystem.matrixA = left.matrixA;
-            for (int k = 0; k < aSystem.matrixA.outerSize(); ++k)
-                aSystem.matrixA.coeffRef(k, k) -= right;
+            CSleSystem<Real> aSystem(*this);
 
-            aSystem.vectorB = left.vectorB;
-            for (int k = 0; k < aSystem.vectorB.size(); ++k)
-                aSystem.vectorB[k] -= right;
+            aSystem = right;
 
             return aSystem;
 
         }
 
         template <typename Real>
-        CSleSystem<Real> operator+ (const CSleSystem<Real>& left, const Real right)
+        CSleTerminal<Real>::CSleTerminal(const CSleSystem<Real>& aSystem) : m_system(aSystem)
         {
 
-            CSleSystem<Real> aSystem;
+        }
 
-            aSystem.matrixType = left.matrixType;
+        template <typename Real>
+        const Eigen::SparseMatrix<Real>& CSleTerminal<Real>::pattern() const
+        {
 
-            aSystem.matrixA = left.matrixA;
-            for (int k = 0; k < aSystem.matrixA.outerSize(); ++k)
-                aSystem.matrixA.coeffRef(k, k) += right;
+            return m_system.matrixA;
 
-            aSystem.vectorB = left.vectorB;
-            for (int k = 0; k < aSystem.vectorB.size(); ++k)
-                aSystem.vectorB[k] += right;
+        }
 
-            return aSystem;
+        template <typename Real>
+        bool CSleTerminal<Real>::fusable(const Eigen::SparseMatrix<Real>& aPattern) const
+        {
+
+            return &m_system.matrixA == &aPattern || samePattern(m_system.matrixA, aPattern);
 
         }
 
         template <typename Real>
-        CSleSystem<Real> operator+ (const CSleSystem<Real>& left, const CSleSystem<Real>& right)
+        Real CSleTerminal<Real>::coeff(const Integer p, const Integer aRow, const Integer aCol) const
         {
 
-            CSleSystem<Real> aSystem;
+            return m_system.matrixA.valuePtr()[p];
 
-            if (left.matrixType > right.matrixType)
-                aSystem.matrixType = left.matrixType;
-            else
-                aSystem.matrixType = right.matrixType;
+        }
 
-            aSystem.matrixA = left.matrixA + right.matrixA;
-            aSystem.vectorB = left.vectorB + right.vectorB;
+        template <typename Real>
+        Real CSleTerminal<Real>::rhs(const Integer i) const
+        {
 
-            return aSystem;
+            return m_system.vectorB[i];
+
+        }
+
+        template <typename Real>
+        const Eigen::SparseMatrix<Real>& CSleTerminal<Real>::matrix() const
+        {
+
+            return m_system.matrixA;
+
+        }
+
+        template <typename Real>
+        EMatrixType CSleTerminal<Real>::type() const
+        {
+
+            return m_system.matrixType;
 
         }
 
         template <typename Real>
-        CSleSystem<Real> operator- (const CSleSystem<Real>& left, const CSleSystem<Real>& right)
+        CSleSolver<Real>* CSleTerminal<Real>::solver() const
+        {
+
+            return m_system.solver();
+
+        }
+
+        template <typename Real, typename Left, typename Right>
+        CSleSum<Real, Left, Right>::CSleSum(const Left& aLeft, const Right& aRight, const Real aSign) : m_left(aLeft), m_right(aRight), m_sign(aSign)
+        {
+
+        }
+
+        template <typename Real, typename Left, typename Right>
+        const Eigen::SparseMatrix<Real>& CSleSum<Real, Left, Right>::pattern() const
         {
 
-            CSleSystem<Real> aSystem;
+            return m_left.pattern();
+
+        }
 
-            if (left.matrixType > right.matrixType)
-                aSystem.matrixType = left.matrixType;
+        template <typename Real, typename Left, typename Right>
+        bool CSleSum<Real, Left, Right>::fusable(const Eigen::SparseMatrix<Real>& aPattern) const
+        {
+
+            return m_left.fusable(aPattern) && m_right.fusable(aPattern);
+
+        }
+
+        template <typename Real, typename Left, typename Right>
+        Real CSleSum<Real, Left, Right>::coeff(const Integer p, const Integer aRow, const Integer aCol) const
+        {
+
+            return m_left.coeff(p, aRow, aCol) + m_sign * m_right.coeff(p, aRow, aCol);
+
+        }
+
+        template <typename Real, typename Left, typename Right>
+        Real CSleSum<Real, Left, Right>::rhs(const Integer i) const
+        {
+
+            return m_left.rhs(i) + m_sign * m_right.rhs(i);
+
+        }
+
+        template <typename Real, typename Left, typename Right>
+        Eigen::SparseMatrix<Real> CSleSum<Real, Left, Right>::matrix() const
+        {
+
+            if (m_sign > 0)
+                return m_left.matrix() + m_right.matrix();
             else
-                aSystem.matrixType = right.matrixType;
+                return m_left.matrix() - m_right.matrix();
 
-            aSystem.matrixA = left.matrixA - right.matrixA;
-            aSystem.vectorB = left.vectorB - right.vectorB;
+        }
 
-            return aSystem;
+        template <typename Real, typename Left, typename Right>
+        EMatrixType CSleSum<Real, Left, Right>::type() const
+        {
+
+            return std::max(m_left.type(), m_right.type());
+
+        }
+
+        template <typename Real, typename Left, typename Right>
+        CSleSolver<Real>* CSleSum<Real, Left, Right>::solver() const
+        {
+
+            if (m_left.solver())
+                return m_left.solver();
+            else
+                return m_right.solver();
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleScale<Real, Derived>::CSleScale(const Derived& anExpression, const Real aScale) : m_expression(anExpression), m_scale(aScale)
+        {
+
+        }
+
+        template <typename Real, typename Derived>
+        const Eigen::SparseMatrix<Real>& CSleScale<Real, Derived>::pattern() const
+        {
+
+            return m_expression.pattern();
+
+        }
+
+        template <typename Real, typename Derived>
+        bool CSleScale<Real, Derived>::fusable(const Eigen::SparseMatrix<Real>& aPattern) const
+        {
+
+            return m_expression.fusable(aPattern);
+
+        }
+
+        template <typename Real, typename Derived>
+        Real CSleScale<Real, Derived>::coeff(const Integer p, const Integer aRow, const Integer aCol) const
+        {
+
+            return m_scale * m_expression.coeff(p, aRow, aCol);
+
+        }
+
+        template <typename Real, typename Derived>
+        Real CSleScale<Real, Derived>::rhs(const Integer i) const
+        {
+
+            return m_scale * m_expression.rhs(i);
+
+        }
+
+        template <typename Real, typename Derived>
+        Eigen::SparseMatrix<Real> CSleScale<Real, Derived>::matrix() const
+        {
+
+            return m_scale * m_expression.matrix();
+
+        }
+
+        template <typename Real, typename Derived>
+        EMatrixType CSleScale<Real, Derived>::type() const
+        {
+
+            return m_expression.type();
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleSolver<Real>* CSleScale<Real, Derived>::solver() const
+        {
+
+            return m_expression.solver();
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleShift<Real, Derived>::CSleShift(const Derived& anExpression, const Real aShift) : m_expression(anExpression), m_shift(aShift)
+        {
+
+        }
+
+        template <typename Real, typename Derived>
+        const Eigen::SparseMatrix<Real>& CSleShift<Real, Derived>::pattern() const
+        {
+
+            return m_expression.pattern();
+
+        }
+
+        template <typename Real, typename Derived>
+        bool CSleShift<Real, Derived>::fusable(const Eigen::SparseMatrix<Real>& aPattern) const
+        {
+
+            return m_expression.fusable(aPattern) && hasDiagonal(aPattern);
+
+        }
+
+        template <typename Real, typename Derived>
+        Real CSleShift<Real, Derived>::coeff(const Integer p, const Integer aRow, const Integer aCol) const
+        {
+
+            if (aRow == aCol)
+                return m_expression.coeff(p, aRow, aCol) + m_shift;
+            else
+                return m_expression.coeff(p, aRow, aCol);
+
+        }
+
+        template <typename Real, typename Derived>
+        Real CSleShift<Real, Derived>::rhs(const Integer i) const
+        {
+
+            return m_expression.rhs(i) + m_shift;
+
+        }
+
+        template <typename Real, typename Derived>
+        Eigen::SparseMatrix<Real> CSleShift<Real, Derived>::matrix() const
+        {
+
+            Eigen::SparseMatrix<Real> aMatrix = m_expression.matrix();
+
+            for (Integer k = 0; k < aMatrix.outerSize(); ++k)
+                aMatrix.coeffRef(k, k) += m_shift;
+
+            return aMatrix;
+
+        }
+
+        template <typename Real, typename Derived>
+        EMatrixType CSleShift<Real, Derived>::type() const
+        {
+
+            return m_expression.type();
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleSolver<Real>* CSleShift<Real, Derived>::solver() const
+        {
+
+            return m_expression.solver();
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleRowScale<Real, Derived>::CSleRowScale(const Derived& anExpression, const Eigen::Matrix<Real, Eigen::Dynamic, 1>& aScale) : m_expression(anExpression), m_scale(aScale)
+        {
+
+        }
+
+        template <typename Real, typename Derived>
+        const Eigen::SparseMatrix<Real>& CSleRowScale<Real, Derived>::pattern() const
+        {
+
+            return m_expression.pattern();
+
+        }
+
+        template <typename Real, typename Derived>
+        bool CSleRowScale<Real, Derived>::fusable(const Eigen::SparseMatrix<Real>& aPattern) const
+        {
+
+            return m_expression.fusable(aPattern);
+
+        }
+
+        template <typename Real, typename Derived>
+        Real CSleRowScale<Real, Derived>::coeff(const Integer p, const Integer aRow, const Integer aCol) const
+        {
+
+            return m_scale[aRow] * m_expression.coeff(p, aRow, aCol);
+
+        }
+
+        template <typename Real, typename Derived>
+        Real CSleRowScale<Real, Derived>::rhs(const Integer i) const
+        {
+
+            return m_scale[i] * m_expression.rhs(i);
+
+        }
+
+        template <typename Real, typename Derived>
+        Eigen::SparseMatrix<Real> CSleRowScale<Real, Derived>::matrix() const
+        {
+
+            return m_scale.asDiagonal() * m_expression.matrix();
+
+        }
+
+        template <typename Real, typename Derived>
+        EMatrixType CSleRowScale<Real, Derived>::type() const
+        {
+
+            return m_expression.type();
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleSolver<Real>* CSleRowScale<Real, Derived>::solver() const
+        {
+
+            return m_expression.solver();
 
         }
 
         template <typename Real>
-        CSleSystem<Real> operator* (const Real left, const CSleSystem<Real>& right)
+        bool samePattern(const Eigen::SparseMatrix<Real>& left, const Eigen::SparseMatrix<Real>& right)
         {
 
-            CSleSystem<Real> aSystem;
+            if (!left.isCompressed() || !right.isCompressed())
+                return false;
 
-            aSystem.matrixType = right.matrixType;
+            if (left.rows() != right.rows() || left.cols() != right.cols() || left.nonZeros() != right.nonZeros())
+                return false;
 
-            aSystem.matrixA = left * right.matrixA;
-            aSystem.vectorB = left * right.vectorB;
+            if (!std::equal(left.outerIndexPtr(), left.outerIndexPtr() + left.outerSize() + 1, right.outerIndexPtr()))
+                return false;
 
-            return aSystem;
+            return std::equal(left.innerIndexPtr(), left.innerIndexPtr() + left.nonZeros(), right.innerIndexPtr());
 
         }
 
         template <typename Real>
-        CSleSystem<Real> operator* (const Eigen::Matrix<Real, Eigen::Dynamic, 1>& left, const CSleSystem<Real>& right)
+        bool hasDiagonal(const Eigen::SparseMatrix<Real>& aMatrix)
         {
 
-            CSleSystem<Real> aSystem;
+            if (aMatrix.rows() != aMatrix.cols())
+                return false;
 
-            aSystem.matrixType = right.matrixType;
+            const Integer* outer = aMatrix.outerIndexPtr();
+            const Integer* inner = aMatrix.innerIndexPtr();
 
-            aSystem.matrixA = right.matrixA;
-            for (int k = 0; k < aSystem.matrixA.outerSize(); ++k)
+            for (Integer k = 0; k < aMatrix.outerSize(); ++k)
             {
-                for (Eigen::SparseMatrix<double>::InnerIterator it(aSystem.matrixA, k); it; ++it)
-                {
-                    aSystem.matrixA.coeffRef(it.row(), k) *= left[it.row()];
-                }
+
+                if (!std::binary_search(inner + outer[k], inner + outer[k + 1], k))
+                    return false;
+
             }
 
-            aSystem.vectorB = right.vectorB;
-            for (int k = 0; k < aSystem.vectorB.size(); ++k)
-                aSystem.vectorB[k] *= left[k];
+            return true;
 
-            return aSystem;
+        }
+
+        template <typename Real, typename Derived>
+        CSleShift<Real, Derived> operator- (const CSleExpression<Real, Derived>& left, const Real right)
+        {
+
+            return CSleShift<Real, Derived>(left.derived(), -right);
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleShift<Real, Derived> operator+ (const CSleExpression<Real, Derived>& left, const Real right)
+        {
+
+            return CSleShift<Real, Derived>(left.derived(), right);
+
+        }
+
+        template <typename Real, typename Left, typename Right>
+        CSleSum<Real, Left, Right> operator+ (const CSleExpression<Real, Left>& left, const CSleExpression<Real, Right>& right)
+        {
+
+            return CSleSum<Real, Left, Right>(left.derived(), right.derived(), 1);
+
+        }
+
+        template <typename Real, typename Left, typename Right>
+        CSleSum<Real, Left, Right> operator- (const CSleExpression<Real, Left>& left, const CSleExpression<Real, Right>& right)
+        {
+
+            return CSleSum<Real, Left, Right>(left.derived(), right.derived(), -1);
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleScale<Real, Derived> operator* (const Real left, const CSleExpression<Real, Derived>& right)
+        {
+
+            return CSleScale<Real, Derived>(right.derived(), left);
+
+        }
+
+        template <typename Real, typename Derived>
+        CSleRowScale<Real, Derived> operator* (const Eigen::Matrix<Real, Eigen::Dynamic, 1>& left, const CSleExpression<Real, Derived>& right)
+        {
+
+            return CSleRowScale<Real, Derived>(right.derived(), left);
 
         }
 
@@ -27,6 +27,12 @@ namespace ENigMA
 
             void setDimension(const Integer nDimension);
 
+            Real support();
+
+            Real radialW(const Real q);
+            Real radialGradientW(const Real q);
+            Real radialLaplacianW(const Real q);
+
             Real W(const ENigMA::geometry::CGeoVector<Real> r, const Real h);
             ENigMA::geometry::CGeoVector<Real> gradientW(const ENigMA::geometry::CGeoVector<Real> r, const Real h, const Real aTolerance = 0.0);
             Real laplacianW(const ENigMA::geometry::CGeoVector<Real> r, const Real h);
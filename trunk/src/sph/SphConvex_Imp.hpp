@@ -23,12 +23,16 @@ namespace ENigMA
         CSphConvex<Real>::CSphConvex(const Integer nDimension) : CSphKernel<Real>(nDimension)
         {
 
+            this->setDimension(nDimension);
+
         }
 
         template <typename Real>
         CSphConvex<Real>::CSphConvex() : CSphKernel<Real>()
         {
 
+            this->setDimension(1);
+
         }
 
         template <typename Real>
@@ -43,71 +47,88 @@ namespace ENigMA
 
             CSphKernel<Real>::m_dim = nDimension;
 
+            if (nDimension == 1)
+                CSphKernel<Real>::m_factor = 5.0 / 24.0;
+            else if (nDimension == 2)
+                CSphKernel<Real>::m_factor = 15.0 / (64.0 * CSphKernel<Real>::m_pi);
+            else if (nDimension == 3)
+                CSphKernel<Real>::m_factor = 21.0 / (128.0 * CSphKernel<Real>::m_pi);
+
         }
 
         template <typename Real>
-        Real CSphConvex<Real>::W(const CGeoVector<Real> r, const Real h)
+        Real CSphConvex<Real>::support()
         {
 
-            Real q = r.norm() / h;
+            return 2.0;
+
+        }
+
+        template <typename Real>
+        Real CSphConvex<Real>::radialW(const Real q)
+        {
 
             if (q > 2.0)
                 return 0.0;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 5.0 / (24.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 15.0 / (64.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 21.0 / (128.0 * CSphKernel<Real>::m_pi * h * h * h);
-
-            return CSphKernel<Real>::m_C * pow(2 - q, 3) * (0.5 * q + 1);
+            return CSphKernel<Real>::m_factor * (2 - q) * (2 - q) * (2 - q) * (0.5 * q + 1);
 
         }
 
         template <typename Real>
-        CGeoVector<Real> CSphConvex<Real>::gradientW(const CGeoVector<Real> r, const Real h, const Real aTolerance)
+        Real CSphConvex<Real>::radialGradientW(const Real q)
         {
 
-            Real q = r.norm() / h;
+            if (q > 2.0)
+                return 0.0;
 
-            if (q < aTolerance)
-                q = aTolerance;
+            return -CSphKernel<Real>::m_factor * (pow(2 - q, 1.5) - 3 * (2 - q) * (2 - q) * (0.5 * q + 1));
+
+        }
+
+        template <typename Real>
+        Real CSphConvex<Real>::radialLaplacianW(const Real q)
+        {
 
             if (q > 2.0)
-                return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
+                return 0.0;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 5.0 / (24.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 15.0 / (64.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 21.0 / (128.0 * CSphKernel<Real>::m_pi * h * h * h);
+            Real w = (2 - q) * (2 - q) * (2 - q) * (0.5 * q + 1);
+            Real dw = pow(2 - q, 1.5) - 3 * (2 - q) * (2 - q) * (0.5 * q + 1);
 
-            return -CSphKernel<Real>::m_C * (pow(2 - q, 1.5) - 3 * (2 - q) * (2 - q) * (0.5 * q + 1)) / q * r;
+            return CSphKernel<Real>::m_factor * (dw * q + w * CSphKernel<Real>::m_dim);
 
         }
 
         template <typename Real>
-        Real CSphConvex<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
+        Real CSphConvex<Real>::W(const CGeoVector<Real> r, const Real h)
+        {
+
+            return this->radialW(r.norm() / h) / this->powh(h);
+
+        }
+
+        template <typename Real>
+        CGeoVector<Real> CSphConvex<Real>::gradientW(const CGeoVector<Real> r, const Real h, const Real aTolerance)
         {
 
             Real q = r.norm() / h;
 
-            if (q > 2.0)
-                return 0.0;
+            if (q < aTolerance)
+                q = aTolerance;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 5.0 / (24.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 15.0 / (64.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 21.0 / (128.0 * CSphKernel<Real>::m_pi * h * h * h);
+            if (q <= 0.0 || q > 2.0)
+                return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
 
-            Real w = pow(2 - q, 3) * (0.5 * q + 1);
-            Real dw = pow(2 - q, 1.5) - 3 * (2 - q) * (2 - q) * (0.5 * q + 1);
+            return this->radialGradientW(q) / (q * this->powh(h)) * r;
+
+        }
+
+        template <typename Real>
+        Real CSphConvex<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
+        {
 
-            return CSphKernel<Real>::m_C * h * (dw * q + w * CSphKernel<Real>::m_dim);
+            return this->radialLaplacianW(r.norm() / h) * h / this->powh(h);
 
         }
 
@@ -23,12 +23,16 @@ namespace ENigMA
         CSphCubicSpline<Real>::CSphCubicSpline(const Integer nDimension) : CSphKernel<Real>(nDimension)
         {
 
+            this->setDimension(nDimension);
+
         }
 
         template <typename Real>
         CSphCubicSpline<Real>::CSphCubicSpline() : CSphKernel<Real>()
         {
 
+            this->setDimension(1);
+
         }
 
         template <typename Real>
@@ -43,76 +47,61 @@ namespace ENigMA
 
             CSphKernel<Real>::m_dim = nDimension;
 
+            if (nDimension == 1)
+                CSphKernel<Real>::m_factor = 2.0 / 3.0;
+            else if (nDimension == 2)
+                CSphKernel<Real>::m_factor = 10.0 / (7.0 * CSphKernel<Real>::m_pi);
+            else if (nDimension == 3)
+                CSphKernel<Real>::m_factor = 1.0 / CSphKernel<Real>::m_pi;
+
         }
 
         template <typename Real>
-        Real CSphCubicSpline<Real>::W(const CGeoVector<Real> r, const Real h)
+        Real CSphCubicSpline<Real>::support()
         {
 
-            Real q = r.norm() / h;
+            return 2.0;
+
+        }
+
+        template <typename Real>
+        Real CSphCubicSpline<Real>::radialW(const Real q)
+        {
 
             if (q > 2.0)
                 return 0.0;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 2.0 / (3.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 10.0 / (7.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * h * h * h);
-
-            if (q >= 0 && q < 1.0)
-                return CSphKernel<Real>::m_C * ((2 - q) * (2 - q) * (2 - q) - 4 * (1 - q) * (1 - q) * (1 - q));
+            if (q < 1.0)
+                return CSphKernel<Real>::m_factor * ((2 - q) * (2 - q) * (2 - q) - 4 * (1 - q) * (1 - q) * (1 - q));
             else
-                return CSphKernel<Real>::m_C * (2 - q) * (2 - q) * (2 - q);
+                return CSphKernel<Real>::m_factor * (2 - q) * (2 - q) * (2 - q);
 
         }
 
         template <typename Real>
-        CGeoVector<Real> CSphCubicSpline<Real>::gradientW(const CGeoVector<Real> r, const Real h, const Real aTolerance)
+        Real CSphCubicSpline<Real>::radialGradientW(const Real q)
         {
 
-            Real q = r.norm() / h;
-
-            if (q < aTolerance)
-                q = aTolerance;
-
             if (q > 2.0)
-                return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
-
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 2.0 / (3.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 10.0 / (7.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * h * h * h);
+                return 0.0;
 
-            if (q >= aTolerance && q < 1.0)
-                return CSphKernel<Real>::m_C * (3.0 * q * (1 - 0.75 * q)) / q * r;
+            if (q < 1.0)
+                return CSphKernel<Real>::m_factor * 3.0 * q * (1 - 0.75 * q);
             else
-                return CSphKernel<Real>::m_C * 0.75 * (2 - q) * (2 - q) / q * r;
+                return CSphKernel<Real>::m_factor * 0.75 * (2 - q) * (2 - q);
 
         }
 
         template <typename Real>
-        Real CSphCubicSpline<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
+        Real CSphCubicSpline<Real>::radialLaplacianW(const Real q)
         {
 
-            Real q = r.norm() / h;
-
             if (q > 2.0)
                 return 0.0;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 2.0 / (3.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 10.0 / (7.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * h * h * h);
-
             Real w, dw;
 
-            if (q >= 0 && q < 1.0)
+            if (q < 1.0)
             {
                 w = 1.0 - 1.5 * q * q * (1.0 - 0.5 * q);
                 dw = -3.0 * q * (1.0 - 0.75 * q);
@@ -123,7 +112,39 @@ namespace ENigMA
                 dw = -0.75 * (2 - q) * (2 - q);
             }
 
-            return CSphKernel<Real>::m_C * h * (dw * q + w * CSphKernel<Real>::m_dim);
+            return CSphKernel<Real>::m_factor * (dw * q + w * CSphKernel<Real>::m_dim);
+
+        }
+
+        template <typename Real>
+        Real CSphCubicSpline<Real>::W(const CGeoVector<Real> r, const Real h)
+        {
+
+            return this->radialW(r.norm() / h) / this->powh(h);
+
+        }
+
+        template <typename Real>
+        CGeoVector<Real> CSphCubicSpline<Real>::gradientW(const CGeoVector<Real> r, const Real h, const Real aTolerance)
+        {
+
+            Real q = r.norm() / h;
+
+            if (q < aTolerance)
+                q = aTolerance;
+
+            if (q <= 0.0 || q > 2.0)
+                return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
+
+            return this->radialGradientW(q) / (q * this->powh(h)) * r;
+
+        }
+
+        template <typename Real>
+        Real CSphCubicSpline<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
+        {
+
+            return this->radialLaplacianW(r.norm() / h) * h / this->powh(h);
 
         }
 
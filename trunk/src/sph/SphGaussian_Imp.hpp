@@ -23,12 +23,16 @@ namespace ENigMA
         CSphGaussian<Real>::CSphGaussian(const Integer nDimension) : CSphKernel<Real>(nDimension)
         {
 
+            this->setDimension(nDimension);
+
         }
 
         template <typename Real>
         CSphGaussian<Real>::CSphGaussian() : CSphKernel<Real>()
         {
-            
+
+            this->setDimension(1);
+
         }
 
         template <typename Real>
@@ -42,27 +46,66 @@ namespace ENigMA
         {
 
             CSphKernel<Real>::m_dim = nDimension;
-            
+
+            if (nDimension == 1)
+                CSphKernel<Real>::m_factor = 1.0 / sqrt(CSphKernel<Real>::m_pi);
+            else if (nDimension == 2)
+                CSphKernel<Real>::m_factor = 1.0 / CSphKernel<Real>::m_pi;
+            else if (nDimension == 3)
+                CSphKernel<Real>::m_factor = 1.0 / (CSphKernel<Real>::m_pi * CSphKernel<Real>::m_pi * CSphKernel<Real>::m_pi);
+
         }
 
         template <typename Real>
-        Real CSphGaussian<Real>::W(const CGeoVector<Real> r, const Real h)
+        Real CSphGaussian<Real>::support()
         {
 
-            Real q = r.norm() / h;
+            return 3.0;
+
+        }
+
+        template <typename Real>
+        Real CSphGaussian<Real>::radialW(const Real q)
+        {
 
             if (q > 3.0)
                 return 0.0;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 1.0 / (sqrt(CSphKernel<Real>::m_pi) * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * CSphKernel<Real>::m_pi * CSphKernel<Real>::m_pi * h * h * h);
-                
-            return CSphKernel<Real>::m_C * exp(-q * q);
-            
+            return CSphKernel<Real>::m_factor * exp(-q * q);
+
+        }
+
+        template <typename Real>
+        Real CSphGaussian<Real>::radialGradientW(const Real q)
+        {
+
+            if (q > 3.0)
+                return 0.0;
+
+            return CSphKernel<Real>::m_factor * 2 * exp(-q * q) * q;
+
+        }
+
+        template <typename Real>
+        Real CSphGaussian<Real>::radialLaplacianW(const Real q)
+        {
+
+            if (q > 3.0)
+                return 0.0;
+
+            Real w = exp(-q * q);
+            Real dw = -2.0 * q * w;
+
+            return CSphKernel<Real>::m_factor * (dw * q + w * CSphKernel<Real>::m_dim);
+
+        }
+
+        template <typename Real>
+        Real CSphGaussian<Real>::W(const CGeoVector<Real> r, const Real h)
+        {
+
+            return this->radialW(r.norm() / h) / this->powh(h);
+
         }
 
         template <typename Real>
@@ -70,21 +113,14 @@ namespace ENigMA
         {
 
             Real q = r.norm() / h;
-                
+
             if (q < aTolerance)
                 q = aTolerance;
 
-            if (q > 3.0)
+            if (q <= 0.0 || q > 3.0)
                 return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
-            
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 1.0 / (sqrt(CSphKernel<Real>::m_pi) * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * CSphKernel<Real>::m_pi * CSphKernel<Real>::m_pi * h * h * h);
 
-            return CSphKernel<Real>::m_C * 2 * exp(-q * q) * r;
+            return this->radialGradientW(q) / (q * this->powh(h)) * r;
 
         }
 
@@ -92,25 +128,8 @@ namespace ENigMA
         Real CSphGaussian<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
         {
 
-            Real q = r.norm() / h;
-
-            if (q > 3.0)
-                return 0.0;
-
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 1.0 / (sqrt(CSphKernel<Real>::m_pi) * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 1.0 / (CSphKernel<Real>::m_pi * CSphKernel<Real>::m_pi * CSphKernel<Real>::m_pi * h * h * h);
-
-            Real w, dw;
-            
-            w = exp(-q * q);
-            dw = -2.0 * q * w;
+            return this->radialLaplacianW(r.norm() / h) * h / this->powh(h);
 
-            return CSphKernel<Real>::m_C * h * (dw * q + w * CSphKernel<Real>::m_dim);
-            
         }
 
     }
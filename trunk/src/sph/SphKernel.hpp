@@ -18,13 +18,17 @@ namespace ENigMA
     namespace sph
     {
 
+        // Kernels are radial. Besides the virtual interface each kernel has non-virtual radialW, radialGradientW and
+        // radialLaplacianW of q = r / h for h = 1, so that loops templated on the kernel type can inline them.
         template <typename Real>
         class CSphKernel
         {
         protected:
             Integer m_dim;
             Real m_pi;
-            Real m_C;
+            Real m_factor;      // Normalization constant for h = 1
+
+            Real powh(const Real h);
 
         public:
             CSphKernel();
@@ -32,6 +36,9 @@ namespace ENigMA
             ~CSphKernel();
 
             virtual void setDimension(const Integer nDimension);
+            Integer dimension();
+
+            virtual Real support() = 0;
 
             virtual Real W(const ENigMA::geometry::CGeoVector<Real> r, const Real h) = 0;
             virtual ENigMA::geometry::CGeoVector<Real> gradientW(const ENigMA::geometry::CGeoVector<Real> r, const Real h, const Real aTolerance = 0.0) = 0;
@@ -0,0 +1,61 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include "SphKernel.hpp"
+
+namespace ENigMA
+{
+
+    namespace sph
+    {
+
+        // Radial profiles of a kernel sampled uniformly over q = r / h and interpolated linearly. Same
+        // radialW, radialGradientW and radialLaplacianW interface as the kernels for templated loops.
+        template <typename Real>
+        class CSphKernelTable
+        {
+        private:
+
+            Integer m_nbSamples;
+            Real m_support;
+            Real m_rdq;
+
+            std::vector<Real> m_W;
+            std::vector<Real> m_gradientW;
+            std::vector<Real> m_laplacianW;
+
+            Real interpolate(const std::vector<Real>& sValues, const Real q);
+
+        public:
+
+            CSphKernelTable();
+            CSphKernelTable(CSphKernel<Real>& aKernel, const Integer nbSamples = 4096);
+            ~CSphKernelTable();
+
+            void build(CSphKernel<Real>& aKernel, const Integer nbSamples = 4096);
+
+            Integer nbSamples();
+
+            Real support();
+
+            Real radialW(const Real q);
+            Real radialGradientW(const Real q);
+            Real radialLaplacianW(const Real q);
+
+        };
+
+    }
+
+}
+
+#include "SphKernelTable_Imp.hpp"
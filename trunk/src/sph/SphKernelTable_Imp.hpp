@@ -0,0 +1,140 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+
+using namespace ENigMA::geometry;
+
+namespace ENigMA
+{
+
+    namespace sph
+    {
+
+        template <typename Real>
+        CSphKernelTable<Real>::CSphKernelTable() :
+            m_nbSamples(0),
+            m_support(0.0),
+            m_rdq(0.0)
+        {
+
+        }
+
+        template <typename Real>
+        CSphKernelTable<Real>::CSphKernelTable(CSphKernel<Real>& aKernel, const Integer nbSamples)
+        {
+
+            this->build(aKernel, nbSamples);
+
+        }
+
+        template <typename Real>
+        CSphKernelTable<Real>::~CSphKernelTable()
+        {
+
+        }
+
+        template <typename Real>
+        void CSphKernelTable<Real>::build(CSphKernel<Real>& aKernel, const Integer nbSamples)
+        {
+
+            m_nbSamples = nbSamples;
+            m_support = aKernel.support();
+
+            const Real dq = m_support / m_nbSamples;
+
+            m_rdq = 1.0 / dq;
+
+            // One extra sample past the support keeps the interpolation branch free at the end
+            m_W.resize(m_nbSamples + 2);
+            m_gradientW.resize(m_nbSamples + 2);
+            m_laplacianW.resize(m_nbSamples + 2);
+
+            for (Integer k = 0; k <= m_nbSamples; ++k)
+            {
+
+                // The gradient direction is undefined at the origin, take its limit
+                Real q = std::max(k * dq, static_cast<Real>(1E-6 * dq));
+
+                CGeoVector<Real> r(q, 0, 0);
+
+                m_W[k] = aKernel.W(r, 1.0);
+                m_gradientW[k] = aKernel.gradientW(r, 1.0).x();
+                m_laplacianW[k] = aKernel.laplacianW(r, 1.0);
+
+            }
+
+            m_W[m_nbSamples + 1] = 0.0;
+            m_gradientW[m_nbSamples + 1] = 0.0;
+            m_laplacianW[m_nbSamples + 1] = 0.0;
+
+        }
+
+        template <typename Real>
+        Integer CSphKernelTable<Real>::nbSamples()
+        {
+
+            return m_nbSamples;
+
+        }
+
+        template <typename Real>
+        Real CSphKernelTable<Real>::support()
+        {
+
+            return m_support;
+
+        }
+
+        template <typename Real>
+        Real CSphKernelTable<Real>::interpolate(const std::vector<Real>& sValues, const Real q)
+        {
+
+            if (q > m_support)
+                return 0.0;
+
+            Real s = q * m_rdq;
+
+            Integer k = static_cast<Integer>(s);
+
+            Real t = s - k;
+
+            return sValues[k] + t * (sValues[k + 1] - sValues[k]);
+
+        }
+
+        template <typename Real>
+        Real CSphKernelTable<Real>::radialW(const Real q)
+        {
+
+            return this->interpolate(m_W, q);
+
+        }
+
+        template <typename Real>
+        Real CSphKernelTable<Real>::radialGradientW(const Real q)
+        {
+
+            return this->interpolate(m_gradientW, q);
+
+        }
+
+        template <typename Real>
+        Real CSphKernelTable<Real>::radialLaplacianW(const Real q)
+        {
+
+            return this->interpolate(m_laplacianW, q);
+
+        }
+
+    }
+
+}
@@ -22,6 +22,7 @@ namespace ENigMA
         {
 
             m_pi = std::acos(-1.0);
+            m_factor = 1.0;
             this->setDimension(nDimension);
 
         }
@@ -31,6 +32,7 @@ namespace ENigMA
         {
 
             m_pi = std::acos(-1.0);
+            m_factor = 1.0;
             this->setDimension(1);
 
         }
@@ -49,6 +51,27 @@ namespace ENigMA
 
         }
 
+        template <typename Real>
+        Integer CSphKernel<Real>::dimension()
+        {
+
+            return m_dim;
+
+        }
+
+        template <typename Real>
+        Real CSphKernel<Real>::powh(const Real h)
+        {
+
+            if (m_dim == 1)
+                return h;
+            else if (m_dim == 2)
+                return h * h;
+            else
+                return h * h * h;
+
+        }
+
     }
 
 }
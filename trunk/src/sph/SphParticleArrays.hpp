@@ -0,0 +1,100 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include "CmnTypes.hpp"
+
+namespace ENigMA
+{
+
+    namespace sph
+    {
+
+        // Particle state as one contiguous array per quantity, with a uniform cell list for neighbour
+        // queries. Slots can be reordered along a Morton curve so that particles close in space are close
+        // in memory; index() keeps the particle number given when each particle was added. The Verlet list holds
+        // each pair once so that symmetric interactions are evaluated once for both particles.
+        template <typename Real>
+        class CSphParticleArrays
+        {
+        private:
+
+            typedef std::vector<Real> varField;
+
+            varField m_x, m_y, m_z;
+            varField m_vx, m_vy, m_vz;
+            varField m_density;
+            varField m_mass;
+            varField m_temperature;
+
+            std::vector<Integer> m_index;       // Particle number of each slot
+            std::vector<Integer> m_slots;       // Slot of each particle number
+            std::vector<Integer> m_order;       // Previous slot of each slot after the last reorder
+
+            // Uniform cell list (CSR)
+            Real m_cellSize;
+            Real m_xMin, m_yMin, m_zMin;
+            Integer m_nx, m_ny, m_nz;
+            std::vector<Integer> m_cellOffsets;
+            std::vector<Integer> m_cellParticles;
+
+            // Verlet list of the pairs i < j closer than radius plus skin (CSR by the first particle)
+            Real m_listRadius;
+            bool m_bListValid;
+            varField m_x0, m_y0, m_z0;          // Positions when the list was built
+            std::vector<Integer> m_neighborOffsets;
+            std::vector<Integer> m_neighborList;
+
+            unsigned long long mortonCode(const Integer i);
+
+        public:
+
+            CSphParticleArrays();
+            ~CSphParticleArrays();
+
+            void clear();
+
+            Integer addParticle(const Real x, const Real y, const Real z, const Real aMass, const Real aDensity);
+
+            Integer size();
+
+            varField& x();
+            varField& y();
+            varField& z();
+            varField& vx();
+            varField& vy();
+            varField& vz();
+            varField& density();
+            varField& mass();
+            varField& temperature();
+
+            Integer index(const Integer aSlot);
+            Integer slot(const Integer aParticleIndex);
+
+            void buildCells(const Real aCellSize);
+            void neighbors(const Integer i, const Real aRadius, std::vector<Integer>& sNeighbors);
+
+            void buildNeighborList(const Real aRadius, const Real aSkin);
+            bool isNeighborListValid(const Real aRadius, const Real aSkin);
+            std::vector<Integer>& neighborOffsets();
+            std::vector<Integer>& neighborList();
+
+            void sortMorton(const Real aCellSize);
+            template <typename T> void permute(std::vector<T>& sValues);
+
+        };
+
+    }
+
+}
+
+#include "SphParticleArrays_Imp.hpp"
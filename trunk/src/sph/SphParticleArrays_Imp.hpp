@@ -0,0 +1,510 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+namespace ENigMA
+{
+
+    namespace sph
+    {
+
+        template <typename Real>
+        CSphParticleArrays<Real>::CSphParticleArrays() :
+            m_cellSize(1.0),
+            m_xMin(0.0), m_yMin(0.0), m_zMin(0.0),
+            m_nx(0), m_ny(0), m_nz(0),
+            m_listRadius(0.0),
+            m_bListValid(false)
+        {
+
+        }
+
+        template <typename Real>
+        CSphParticleArrays<Real>::~CSphParticleArrays()
+        {
+
+        }
+
+        template <typename Real>
+        void CSphParticleArrays<Real>::clear()
+        {
+
+            m_x.clear();
+            m_y.clear();
+            m_z.clear();
+
+            m_vx.clear();
+            m_vy.clear();
+            m_vz.clear();
+
+            m_density.clear();
+            m_mass.clear();
+            m_temperature.clear();
+
+            m_index.clear();
+            m_slots.clear();
+            m_order.clear();
+
+            m_cellOffsets.clear();
+            m_cellParticles.clear();
+
+            m_neighborOffsets.clear();
+            m_neighborList.clear();
+
+            m_bListValid = false;
+
+        }
+
+        template <typename Real>
+        Integer CSphParticleArrays<Real>::addParticle(const Real x, const Real y, const Real z, const Real aMass, const Real aDensity)
+        {
+
+            const Integer aParticleIndex = static_cast<Integer>(m_x.size());
+
+            m_x.push_back(x);
+            m_y.push_back(y);
+            m_z.push_back(z);
+
+            m_vx.push_back(0.0);
+            m_vy.push_back(0.0);
+            m_vz.push_back(0.0);
+
+            m_density.push_back(aDensity);
+            m_mass.push_back(aMass);
+            m_temperature.push_back(0.0);
+
+            m_index.push_back(aParticleIndex);
+            m_slots.push_back(aParticleIndex);
+
+            m_bListValid = false;
+
+            return aParticleIndex;
+
+        }
+
+        template <typename Real>
+        Integer CSphParticleArrays<Real>::size()
+        {
+
+            return static_cast<Integer>(m_x.size());
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::x()
+        {
+
+            return m_x;
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::y()
+        {
+
+            return m_y;
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::z()
+        {
+
+            return m_z;
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::vx()
+        {
+
+            return m_vx;
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::vy()
+        {
+
+            return m_vy;
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::vz()
+        {
+
+            return m_vz;
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::density()
+        {
+
+            return m_density;
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::mass()
+        {
+
+            return m_mass;
+
+        }
+
+        template <typename Real>
+        std::vector<Real>& CSphParticleArrays<Real>::temperature()
+        {
+
+            return m_temperature;
+
+        }
+
+        template <typename Real>
+        Integer CSphParticleArrays<Real>::index(const Integer aSlot)
+        {
+
+            return m_index[aSlot];
+
+        }
+
+        template <typename Real>
+        Integer CSphParticleArrays<Real>::slot(const Integer aParticleIndex)
+        {
+
+            return m_slots[aParticleIndex];
+
+        }
+
+        template <typename Real>
+        void CSphParticleArrays<Real>::buildCells(const Real aCellSize)
+        {
+
+            const Integer nbParticles = this->size();
+
+            m_cellSize = aCellSize;
+
+            if (nbParticles == 0)
+            {
+                m_nx = m_ny = m_nz = 0;
+                m_cellOffsets.assign(1, 0);
+                m_cellParticles.clear();
+                return;
+            }
+
+            m_xMin = *std::min_element(m_x.begin(), m_x.end());
+            m_yMin = *std::min_element(m_y.begin(), m_y.end());
+            m_zMin = *std::min_element(m_z.begin(), m_z.end());
+
+            m_nx = static_cast<Integer>((*std::max_element(m_x.begin(), m_x.end()) - m_xMin) / m_cellSize) + 1;
+            m_ny = static_cast<Integer>((*std::max_element(m_y.begin(), m_y.end()) - m_yMin) / m_cellSize) + 1;
+            m_nz = static_cast<Integer>((*std::max_element(m_z.begin(), m_z.end()) - m_zMin) / m_cellSize) + 1;
+
+            const Integer nbCells = m_nx * m_ny * m_nz;
+
+            // Counting sort of the slots by cell, slots stay in ascending order inside each cell
+            std::vector<Integer> sCells(nbParticles);
+
+            m_cellOffsets.assign(nbCells + 1, 0);
+
+            for (Integer i = 0; i < nbParticles; ++i)
+            {
+
+                Integer ix = static_cast<Integer>((m_x[i] - m_xMin) / m_cellSize);
+                Integer iy = static_cast<Integer>((m_y[i] - m_yMin) / m_cellSize);
+                Integer iz = static_cast<Integer>((m_z[i] - m_zMin) / m_cellSize);
+
+                sCells[i] = ix + m_nx * (iy + m_ny * iz);
+
+                m_cellOffsets[sCells[i] + 1]++;
+
+            }
+
+            for (Integer c = 0; c < nbCells; ++c)
+                m_cellOffsets[c + 1] += m_cellOffsets[c];
+
+            std::vector<Integer> sPositions(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+
+            m_cellParticles.resize(nbParticles);
+
+            for (Integer i = 0; i < nbParticles; ++i)
+                m_cellParticles[sPositions[sCells[i]]++] = i;
+
+        }
+
+        template <typename Real>
+        void CSphParticleArrays<Real>::neighbors(const Integer i, const Real aRadius, std::vector<Integer>& sNeighbors)
+        {
+
+            sNeighbors.clear();
+
+            const Real r2max = aRadius * aRadius;
+
+            const Real xi = m_x[i];
+            const Real yi = m_y[i];
+            const Real zi = m_z[i];
+
+            // Cells overlapping the box around the particle
+            const Integer ixMin = std::max(static_cast<Integer>((xi - aRadius - m_xMin) / m_cellSize), 0);
+            const Integer iyMin = std::max(static_cast<Integer>((yi - aRadius - m_yMin) / m_cellSize), 0);
+            const Integer izMin = std::max(static_cast<Integer>((zi - aRadius - m_zMin) / m_cellSize), 0);
+
+            const Integer ixMax = std::min(static_cast<Integer>((xi + aRadius - m_xMin) / m_cellSize), m_nx - 1);
+            const Integer iyMax = std::min(static_cast<Integer>((yi + aRadius - m_yMin) / m_cellSize), m_ny - 1);
+            const Integer izMax = std::min(static_cast<Integer>((zi + aRadius - m_zMin) / m_cellSize), m_nz - 1);
+
+            for (Integer kz = izMin; kz <= izMax; ++kz)
+            {
+
+                for (Integer ky = iyMin; ky <= iyMax; ++ky)
+                {
+
+                    for (Integer kx = ixMin; kx <= ixMax; ++kx)
+                    {
+
+                        Integer c = kx + m_nx * (ky + m_ny * kz);
+
+                        for (Integer k = m_cellOffsets[c]; k < m_cellOffsets[c + 1]; ++k)
+                        {
+
+                            Integer j = m_cellParticles[k];
+
+                            Real dx = m_x[j] - xi;
+                            Real dy = m_y[j] - yi;
+                            Real dz = m_z[j] - zi;
+
+                            if (dx * dx + dy * dy + dz * dz < r2max)
+                                sNeighbors.push_back(j);
+
+                        }
+
+                    }
+
+                }
+
+            }
+
+        }
+
+        template <typename Real>
+        void CSphParticleArrays<Real>::buildNeighborList(const Real aRadius, const Real aSkin)
+        {
+
+            const Integer nbParticles = this->size();
+
+            m_listRadius = aRadius + aSkin;
+
+            this->buildCells(m_listRadius);
+
+            m_neighborOffsets.assign(nbParticles + 1, 0);
+
+            // Count, then fill, the partners with a higher slot
+            #pragma omp parallel
+            {
+
+                std::vector<Integer> sNeighbors;
+
+                #pragma omp for schedule(dynamic, 256)
+                for (Integer i = 0; i < nbParticles; ++i)
+                {
+
+                    this->neighbors(i, m_listRadius, sNeighbors);
+
+                    Integer nbPairs = 0;
+
+                    for (Integer n = 0; n < static_cast<Integer>(sNeighbors.size()); ++n)
+                    {
+                        if (sNeighbors[n] > i)
+                            nbPairs++;
+                    }
+
+                    m_neighborOffsets[i + 1] = nbPairs;
+
+                }
+
+            }
+
+            for (Integer i = 0; i < nbParticles; ++i)
+                m_neighborOffsets[i + 1] += m_neighborOffsets[i];
+
+            m_neighborList.resize(m_neighborOffsets[nbParticles]);
+
+            #pragma omp parallel
+            {
+
+                std::vector<Integer> sNeighbors;
+
+                #pragma omp for schedule(dynamic, 256)
+                for (Integer i = 0; i < nbParticles; ++i)
+                {
+
+                    this->neighbors(i, m_listRadius, sNeighbors);
+
+                    Integer k = m_neighborOffsets[i];
+
+                    for (Integer n = 0; n < static_cast<Integer>(sNeighbors.size()); ++n)
+                    {
+                        if (sNeighbors[n] > i)
+                            m_neighborList[k++] = sNeighbors[n];
+                    }
+
+                }
+
+            }
+
+            m_x0 = m_x;
+            m_y0 = m_y;
+            m_z0 = m_z;
+
+            m_bListValid = true;
+
+        }
+
+        template <typename Real>
+        bool CSphParticleArrays<Real>::isNeighborListValid(const Real aRadius, const Real aSkin)
+        {
+
+            if (!m_bListValid || aRadius + aSkin != m_listRadius)
+                return false;
+
+            const Integer nbParticles = this->size();
+
+            // A pair can only come within the radius once one of its particles has moved half the skin
+            const Real d2max = 0.25 * aSkin * aSkin;
+
+            for (Integer i = 0; i < nbParticles; ++i)
+            {
+
+                Real dx = m_x[i] - m_x0[i];
+                Real dy = m_y[i] - m_y0[i];
+                Real dz = m_z[i] - m_z0[i];
+
+                if (dx * dx + dy * dy + dz * dz > d2max)
+                    return false;
+
+            }
+
+            return true;
+
+        }
+
+        template <typename Real>
+        std::vector<Integer>& CSphParticleArrays<Real>::neighborOffsets()
+        {
+
+            return m_neighborOffsets;
+
+        }
+
+        template <typename Real>
+        std::vector<Integer>& CSphParticleArrays<Real>::neighborList()
+        {
+
+            return m_neighborList;
+
+        }
+
+        template <typename Real>
+        unsigned long long CSphParticleArrays<Real>::mortonCode(const Integer i)
+        {
+
+            unsigned long long sCoordinates[3];
+
+            sCoordinates[0] = static_cast<unsigned long long>((m_x[i] - m_xMin) / m_cellSize);
+            sCoordinates[1] = static_cast<unsigned long long>((m_y[i] - m_yMin) / m_cellSize);
+            sCoordinates[2] = static_cast<unsigned long long>((m_z[i] - m_zMin) / m_cellSize);
+
+            // Spread the 21 low bits of each cell coordinate three bits apart and interleave them
+            for (Integer k = 0; k < 3; ++k)
+            {
+
+                unsigned long long v = sCoordinates[k] & 0x1fffffULL;
+
+                v = (v | v << 32) & 0x1f00000000ffffULL;
+                v = (v | v << 16) & 0x1f0000ff0000ffULL;
+                v = (v | v << 8) & 0x100f00f00f00f00fULL;
+                v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+                v = (v | v << 2) & 0x1249249249249249ULL;
+
+                sCoordinates[k] = v;
+
+            }
+
+            return sCoordinates[0] | (sCoordinates[1] << 1) | (sCoordinates[2] << 2);
+
+        }
+
+        template <typename Real>
+        void CSphParticleArrays<Real>::sortMorton(const Real aCellSize)
+        {
+
+            const Integer nbParticles = this->size();
+
+            // Cell origin and size for the codes
+            this->buildCells(aCellSize);
+
+            std::vector<std::pair<unsigned long long, Integer> > sKeys(nbParticles);
+
+            for (Integer i = 0; i < nbParticles; ++i)
+                sKeys[i] = std::make_pair(this->mortonCode(i), i);
+
+            std::sort(sKeys.begin(), sKeys.end());
+
+            m_order.resize(nbParticles);
+
+            for (Integer i = 0; i < nbParticles; ++i)
+                m_order[i] = sKeys[i].second;
+
+            this->permute(m_x);
+            this->permute(m_y);
+            this->permute(m_z);
+
+            this->permute(m_vx);
+            this->permute(m_vy);
+            this->permute(m_vz);
+
+            this->permute(m_density);
+            this->permute(m_mass);
+            this->permute(m_temperature);
+
+            this->permute(m_index);
+
+            for (Integer i = 0; i < nbParticles; ++i)
+                m_slots[m_index[i]] = i;
+
+            m_bListValid = false;
+
+            this->buildCells(aCellSize);
+
+        }
+
+        template <typename Real>
+        template <typename T>
+        void CSphParticleArrays<Real>::permute(std::vector<T>& sValues)
+        {
+
+            // Applies the last Morton reorder to a quantity kept outside the container
+            std::vector<T> sPermuted(sValues.size());
+
+            for (Integer i = 0; i < static_cast<Integer>(m_order.size()); ++i)
+                sPermuted[i] = sValues[m_order[i]];
+
+            sValues.swap(sPermuted);
+
+        }
+
+    }
+
+}
@@ -13,12 +13,12 @@
 
 #include "GeoVector.hpp"
 #include "GeoBoundingBox.hpp"
-#include "GeoHashGrid.hpp"
 #include "SphConvex.hpp"
 #include "SphGaussian.hpp"
 #include "SphSpiky.hpp"
 #include "SphCubicSpline.hpp"
 #include "SphQuintic.hpp"
+#include "SphParticleArrays.hpp"
 
 namespace ENigMA
 {
@@ -26,35 +26,29 @@ namespace ENigMA
     namespace sph
     {
 
-        template <typename Real>
-        struct CSphParticle
-        {
-
-            ENigMA::geometry::CGeoVector<Real> velocity;
-            Real conductivity;
-            Real mass;
-            Real density;
-
-        };
-
         template <typename Real>
         class CSphParticles
         {
         private:
             CSphKernel<Real>* m_kernel;
 
-            std::vector<CSphParticle<Real> > m_particles;
+            // One particle per mesh node, the arrays keep the node index of each slot
+            CSphParticleArrays<Real> m_particles;
+            std::vector<Real> m_conductivity;
             ENigMA::geometry::CGeoBoundingBox<Real> m_boundary;
 
             bool m_bCyclic;
 
             Real m_h;
             Real m_dt;
+            Real m_skin;
 
-            void buildHashGrid(CPdeField<Real>& aField, ENigMA::geometry::CGeoHashGrid<Real>& aHashGrid);
+            Integer m_step;
+            Integer m_sortStep;
+            Integer m_sortInterval;
 
             void advectParticles(CPdeField<Real>& aField);
-            void addDiffusion(CPdeField<Real>& aField, ENigMA::geometry::CGeoHashGrid<Real>& aHashGrid);
+            void addDiffusion(CPdeField<Real>& aField);
 
         public:
             CSphParticles(CSphKernel<Real>& kernel);
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 using namespace ENigMA::geometry;
 
 namespace ENigMA
@@ -18,7 +20,14 @@ namespace ENigMA
     {
 
         template <typename Real>
-        CSphParticles<Real>::CSphParticles(CSphKernel<Real>& kernel)
+        CSphParticles<Real>::CSphParticles(CSphKernel<Real>& kernel) :
+            m_bCyclic(false),
+            m_h(1.0),
+            m_dt(1.0),
+            m_skin(0.1),
+            m_step(0),
+            m_sortStep(0),
+            m_sortInterval(20)
         {
 
             m_kernel = &kernel;
@@ -35,15 +44,18 @@ namespace ENigMA
         void CSphParticles<Real>::init(CPdeField<Real>& aField, Real mass, Real rho, Real diff, Real h, Real dt, bool bCyclic)
         {
 
-            m_particles.resize(aField.mesh().nbNodes());
+            m_particles.clear();
+            m_conductivity.clear();
 
             for (Integer i = 0; i < aField.mesh().nbNodes(); ++i)
             {
-                m_particles[i].mass = mass;
-                m_particles[i].density = rho;
-                m_particles[i].conductivity = diff;
 
-                m_particles[i].velocity = typename CGeoVector<Real>::CGeoVector(0, 0, 0);
+                Integer aNodeId = aField.mesh().nodeId(i);
+                CMshNode<Real>& aNode = aField.mesh().node(aNodeId);
+
+                m_particles.addParticle(aNode.x(), aNode.y(), aNode.z(), mass, rho);
+                m_conductivity.push_back(diff);
+
             }
 
             m_bCyclic = bCyclic;
@@ -51,6 +63,9 @@ namespace ENigMA
             m_h = h;
             m_dt = dt;
 
+            m_step = 0;
+            m_sortStep = 0;
+
         }
 
         template <typename Real>
@@ -65,106 +80,131 @@ namespace ENigMA
         void CSphParticles<Real>::setInitialVelocity(CPdeField<Real>& aField, const CGeoVector<Real>& aVelocity)
         {
 
-            for (Integer i = 0; i < aField.mesh().nbNodes(); ++i)
-            {
-                m_particles[i].velocity = aVelocity;
-            }
+            std::fill(m_particles.vx().begin(), m_particles.vx().end(), aVelocity.x());
+            std::fill(m_particles.vy().begin(), m_particles.vy().end(), aVelocity.y());
+            std::fill(m_particles.vz().begin(), m_particles.vz().end(), aVelocity.z());
 
         }
 
         template <typename Real>
-        void CSphParticles<Real>::buildHashGrid(CPdeField<Real>& aField, CGeoHashGrid<Real>& aHashGrid)
+        void CSphParticles<Real>::advectParticles(CPdeField<Real>& aField)
         {
 
-            // Build node hash grid
-            for (Integer i = 0; i < aField.mesh().nbNodes(); ++i)
-            {
-                Integer aNodeId = aField.mesh().nodeId(i);
-                CMshNode<Real>& aNode = aField.mesh().node(aNodeId);
-
-                aHashGrid.addGeometricObject(aNodeId, aNode);
-            }
-
-            aHashGrid.build();
+            const Integer nbParticles = m_particles.size();
 
-        }
+            Real* x = m_particles.x().data();
+            Real* y = m_particles.y().data();
+            Real* z = m_particles.z().data();
 
-        template <typename Real>
-        void CSphParticles<Real>::advectParticles(CPdeField<Real>& aField)
-        {
+            const Real* vx = m_particles.vx().data();
+            const Real* vy = m_particles.vy().data();
+            const Real* vz = m_particles.vz().data();
 
-            for (Integer i = 0; i < aField.mesh().nbNodes(); ++i)
+            for (Integer k = 0; k < nbParticles; ++k)
             {
 
-                Integer aNodeId1 = aField.mesh().nodeId(i);
-                CMshNode<Real>& aNode1 = aField.mesh().node(aNodeId1);
+                x[k] += vx[k] * m_dt;
+                y[k] += vy[k] * m_dt;
+                z[k] += vz[k] * m_dt;
+
+            }
 
-                aNode1.x() += m_particles[i].velocity.x() * m_dt;
-                aNode1.y() += m_particles[i].velocity.z() * m_dt;
-                aNode1.z() += m_particles[i].velocity.y() * m_dt;
+            if (m_bCyclic)
+            {
 
-                if (m_bCyclic)
+                for (Integer k = 0; k < nbParticles; ++k)
                 {
 
-                    if (aNode1.x() >= m_boundary.max().x())
-                        aNode1.x() = m_boundary.min().x();
-                    else if (aNode1.x() <= m_boundary.min().x())
-                        aNode1.x() = m_boundary.max().x();
+                    if (x[k] >= m_boundary.max().x())
+                        x[k] = m_boundary.min().x();
+                    else if (x[k] <= m_boundary.min().x())
+                        x[k] = m_boundary.max().x();
 
-                    if (aNode1.y() >= m_boundary.max().y())
-                        aNode1.y() = m_boundary.min().y();
-                    else if (aNode1.y() <= m_boundary.min().y())
-                        aNode1.y() = m_boundary.max().y();
+                    if (y[k] >= m_boundary.max().y())
+                        y[k] = m_boundary.min().y();
+                    else if (y[k] <= m_boundary.min().y())
+                        y[k] = m_boundary.max().y();
 
-                    if (aNode1.z() >= m_boundary.max().z())
-                        aNode1.z() = m_boundary.min().z();
-                    else if (aNode1.z() <= m_boundary.min().z())
-                        aNode1.z() = m_boundary.max().z();
+                    if (z[k] >= m_boundary.max().z())
+                        z[k] = m_boundary.min().z();
+                    else if (z[k] <= m_boundary.min().z())
+                        z[k] = m_boundary.max().z();
 
                 }
 
             }
 
+            // Mesh nodes follow their particles
+            for (Integer k = 0; k < nbParticles; ++k)
+            {
+
+                Integer aNodeId = aField.mesh().nodeId(m_particles.index(k));
+                CMshNode<Real>& aNode = aField.mesh().node(aNodeId);
+
+                aNode.x() = x[k];
+                aNode.y() = y[k];
+                aNode.z() = z[k];
+
+            }
+
         }
 
         template <typename Real>
-        void CSphParticles<Real>::addDiffusion(CPdeField<Real>& aField, CGeoHashGrid<Real>& aHashGrid)
+        void CSphParticles<Real>::addDiffusion(CPdeField<Real>& aField)
         {
 
-            for (Integer i = 0; i < aField.mesh().nbNodes(); ++i)
-            {
+            const Integer nbParticles = m_particles.size();
 
-                Integer aNodeId1 = aField.mesh().nodeId(i);
-                CMshNode<Real>& aNode1 = aField.mesh().node(aNodeId1);
+            std::vector<Real>& T = m_particles.temperature();
 
-                if (aField.uFixed.find(i) == aField.uFixed.end())
-                {
+            for (Integer k = 0; k < nbParticles; ++k)
+                T[k] = aField.u(m_particles.index(k));
+
+            const Real* x = m_particles.x().data();
+            const Real* y = m_particles.y().data();
+            const Real* z = m_particles.z().data();
 
-                    Real fd = 0.0;
+            const Integer* sOffsets = m_particles.neighborOffsets().data();
+            const Integer* sList = m_particles.neighborList().data();
 
-                    std::vector<Integer> sNodeIds;
-                    aHashGrid.find(sNodeIds, aNode1, m_h);
+            const Real r2max = m_h * m_h;
 
-                    for (Integer n = 0; n < static_cast<Integer>(sNodeIds.size()); ++n)
-                    {
+            std::vector<Real> sFlux(nbParticles, 0.0);
 
-                        Integer aNodeId2 = sNodeIds[n];
-                        CMshNode<Real>& aNode2 = aField.mesh().node(aNodeId2);
+            // Each pair exchanges heat once
+            for (Integer i = 0; i < nbParticles; ++i)
+            {
 
-                        Integer j = aField.mesh().nodeIndex(aNodeId2);
-                        Real Tj = aField.u(j);
+                for (Integer k = sOffsets[i]; k < sOffsets[i + 1]; ++k)
+                {
 
-                        CGeoVector<Real> r = aNode2 - aNode1;
+                    Integer j = sList[k];
 
-                        fd += (Tj - aField.u(i)) * m_kernel->laplacianW(r, m_h);
+                    CGeoVector<Real> r(x[j] - x[i], y[j] - y[i], z[j] - z[i]);
 
-                    }
+                    if (r.squaredNorm() >= r2max)
+                        continue;
 
-                    aField.u(i) += m_particles[i].conductivity * fd * m_dt;
+                    Real fd = (T[j] - T[i]) * m_kernel->laplacianW(r, m_h);
+
+                    sFlux[i] += fd;
+                    sFlux[j] -= fd;
 
                 }
+
+            }
+
+            for (Integer k = 0; k < nbParticles; ++k)
+            {
+
+                Integer i = m_particles.index(k);
+
+                if (aField.uFixed.find(i) == aField.uFixed.end())
+                    T[k] += m_conductivity[k] * sFlux[k] * m_dt;
                 else
-                    aField.u(i) = aField.uFixed[i];
+                    T[k] = aField.uFixed[i];
+
+                aField.u(i) = T[k];
 
             }
 
@@ -176,10 +216,24 @@ namespace ENigMA
 
             this->advectParticles(aField);
 
-            CGeoHashGrid<Real> aHashGrid;
-            this->buildHashGrid(aField, aHashGrid);
+            if (!m_particles.isNeighborListValid(m_h, m_skin * m_h))
+            {
+
+                // Reorder while the list has to be rebuilt anyway
+                if (m_sortInterval > 0 && m_step - m_sortStep >= m_sortInterval)
+                {
+                    m_particles.sortMorton(m_h);
+                    m_particles.permute(m_conductivity);
+                    m_sortStep = m_step;
+                }
+
+                m_particles.buildNeighborList(m_h, m_skin * m_h);
+
+            }
+
+            m_step++;
 
-            this->addDiffusion(aField, aHashGrid);
+            this->addDiffusion(aField);
 
         }
 
@@ -23,12 +23,16 @@ namespace ENigMA
         CSphQuintic<Real>::CSphQuintic(const Integer nDimension) : CSphKernel<Real>(nDimension)
         {
 
+            this->setDimension(nDimension);
+
         }
 
         template <typename Real>
         CSphQuintic<Real>::CSphQuintic() : CSphKernel<Real>()
         {
 
+            this->setDimension(1);
+
         }
 
         template <typename Real>
@@ -43,71 +47,94 @@ namespace ENigMA
 
             CSphKernel<Real>::m_dim = nDimension;
 
+            if (nDimension == 1)
+                CSphKernel<Real>::m_factor = 3.0 / 2.0;
+            else if (nDimension == 2)
+                CSphKernel<Real>::m_factor = 7.0 / (4.0 * CSphKernel<Real>::m_pi);
+            else if (nDimension == 3)
+                CSphKernel<Real>::m_factor = 21.0 / (16.0 * CSphKernel<Real>::m_pi);
+
         }
 
         template <typename Real>
-        Real CSphQuintic<Real>::W(const CGeoVector<Real> r, const Real h)
+        Real CSphQuintic<Real>::support()
         {
 
-            Real q = r.norm() / h;
+            return 2.0;
+
+        }
+
+        template <typename Real>
+        Real CSphQuintic<Real>::radialW(const Real q)
+        {
 
             if (q > 2.0)
                 return 0.0;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 3.0 / (2.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 7.0 / (4.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 21.0 / (16.0 * CSphKernel<Real>::m_pi * h * h * h);
+            Real a = 1 - 0.5 * q;
 
-            return CSphKernel<Real>::m_C * (pow(1 - 0.5 * q, 4) * (2 * q + 1));
+            return CSphKernel<Real>::m_factor * a * a * a * a * (2 * q + 1);
 
         }
 
         template <typename Real>
-        CGeoVector<Real> CSphQuintic<Real>::gradientW(const CGeoVector<Real> r, const Real h, const Real aTolerance)
+        Real CSphQuintic<Real>::radialGradientW(const Real q)
         {
 
-            Real q = r.norm() / h;
+            if (q > 2.0)
+                return 0.0;
 
-            if (q < aTolerance)
-                q = aTolerance;
+            Real a = 1 - 0.5 * q;
+
+            return -CSphKernel<Real>::m_factor * (2 * a * a * a * a - 2 * a * a * a * (2 * q + 1));
+
+        }
+
+        template <typename Real>
+        Real CSphQuintic<Real>::radialLaplacianW(const Real q)
+        {
 
             if (q > 2.0)
-                return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
+                return 0.0;
+
+            Real a = 1 - 0.5 * q;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 3.0 / (2.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 7.0 / (4.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 21.0 / (16.0 * CSphKernel<Real>::m_pi * h * h * h);
+            Real w = a * a * a * a * (2 * q + 1);
+            Real dw = 2 * a * a * a * a - 2 * a * a * a * (2 * q + 1);
 
-            return -CSphKernel<Real>::m_C * (2 * pow(1 - 0.5 * q, 4) - 2 * pow(1 - 0.5 * q, 3) * (2 * q + 1)) / q * r;
+            return CSphKernel<Real>::m_factor * (dw * q + w * CSphKernel<Real>::m_dim);
 
         }
 
         template <typename Real>
-        Real CSphQuintic<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
+        Real CSphQuintic<Real>::W(const CGeoVector<Real> r, const Real h)
+        {
+
+            return this->radialW(r.norm() / h) / this->powh(h);
+
+        }
+
+        template <typename Real>
+        CGeoVector<Real> CSphQuintic<Real>::gradientW(const CGeoVector<Real> r, const Real h, const Real aTolerance)
         {
 
             Real q = r.norm() / h;
 
-            if (q > 2.0)
-                return 0.0;
+            if (q < aTolerance)
+                q = aTolerance;
+
+            if (q <= 0.0 || q > 2.0)
+                return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 3.0 / (2.0 * h);
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 7.0 / (4.0 * CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 21.0 / (16.0 * CSphKernel<Real>::m_pi * h * h * h);
+            return this->radialGradientW(q) / (q * this->powh(h)) * r;
 
-            Real w = pow(1 - 0.5 * q, 4) * (2 * q + 1);
-            Real dw = 2 * pow(1 - 0.5 * q, 4) - 2 * pow(1 - 0.5 * q, 3) * (2 * q + 1);
+        }
+
+        template <typename Real>
+        Real CSphQuintic<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
+        {
 
-            return CSphKernel<Real>::m_C * h * (dw * q + w * CSphKernel<Real>::m_dim);
+            return this->radialLaplacianW(r.norm() / h) * h / this->powh(h);
 
         }
 
@@ -23,12 +23,16 @@ namespace ENigMA
         CSphSpiky<Real>::CSphSpiky(const Integer nDimension) : CSphKernel<Real>(nDimension)
         {
 
+            this->setDimension(nDimension);
+
         }
 
         template <typename Real>
         CSphSpiky<Real>::CSphSpiky() : CSphKernel<Real>()
         {
 
+            this->setDimension(1);
+
         }
 
         template <typename Real>
@@ -43,71 +47,88 @@ namespace ENigMA
 
             CSphKernel<Real>::m_dim = nDimension;
 
+            if (nDimension == 1)
+                CSphKernel<Real>::m_factor = 4.0;
+            else if (nDimension == 2)
+                CSphKernel<Real>::m_factor = 10.0 / CSphKernel<Real>::m_pi;
+            else if (nDimension == 3)
+                CSphKernel<Real>::m_factor = 15.0 / CSphKernel<Real>::m_pi;
+
         }
 
         template <typename Real>
-        Real CSphSpiky<Real>::W(const CGeoVector<Real> r, const Real h)
+        Real CSphSpiky<Real>::support()
         {
 
-            Real q = r.norm() / h;
+            return 1.0;
+
+        }
+
+        template <typename Real>
+        Real CSphSpiky<Real>::radialW(const Real q)
+        {
 
             if (q > 1.0)
                 return 0.0;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 4.0 / h;
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 10.0 / (CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 15.0 / (CSphKernel<Real>::m_pi * h * h * h);
-
-            return CSphKernel<Real>::m_C * pow(1 - q, 3);
+            return CSphKernel<Real>::m_factor * (1 - q) * (1 - q) * (1 - q);
 
         }
 
         template <typename Real>
-        CGeoVector<Real> CSphSpiky<Real>::gradientW(const CGeoVector<Real> r, const Real h, const Real aTolerance)
+        Real CSphSpiky<Real>::radialGradientW(const Real q)
         {
 
-            Real q = r.norm() / h;
+            if (q > 1.0)
+                return 0.0;
 
-            if (q < aTolerance)
-                q = aTolerance;
+            return CSphKernel<Real>::m_factor * 3 * (1 - q) * (1 - q);
+
+        }
+
+        template <typename Real>
+        Real CSphSpiky<Real>::radialLaplacianW(const Real q)
+        {
 
             if (q > 1.0)
-                return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
+                return 0.0;
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 4.0 / h;
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 10.0 / (CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 15.0 / (CSphKernel<Real>::m_pi * h * h * h);
+            Real w = (1 - q) * (1 - q) * (1 - q);
+            Real dw = 3 * (1 - q) * (1 - q);
 
-            return CSphKernel<Real>::m_C * 3 * pow(1 - q, 2) / q * r;
+            return CSphKernel<Real>::m_factor * (dw * q + w * CSphKernel<Real>::m_dim);
 
         }
 
         template <typename Real>
-        Real CSphSpiky<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
+        Real CSphSpiky<Real>::W(const CGeoVector<Real> r, const Real h)
+        {
+
+            return this->radialW(r.norm() / h) / this->powh(h);
+
+        }
+
+        template <typename Real>
+        CGeoVector<Real> CSphSpiky<Real>::gradientW(const CGeoVector<Real> r, const Real h, const Real aTolerance)
         {
 
             Real q = r.norm() / h;
 
-            if (q > 1.0)
-                return 0.0;
+            if (q < aTolerance)
+                q = aTolerance;
+
+            if (q <= 0.0 || q > 1.0)
+                return typename CGeoVector<Real>::CGeoVector(0, 0, 0);
 
-            if (CSphKernel<Real>::m_dim == 1)
-                CSphKernel<Real>::m_C = 4.0 / h;
-            else if (CSphKernel<Real>::m_dim == 2)
-                CSphKernel<Real>::m_C = 10.0 / (CSphKernel<Real>::m_pi * h * h);
-            else if (CSphKernel<Real>::m_dim == 3)
-                CSphKernel<Real>::m_C = 15.0 / (CSphKernel<Real>::m_pi * h * h * h);
+            return this->radialGradientW(q) / (q * this->powh(h)) * r;
 
-            Real w = pow(1 - q, 3);
-            Real dw = 3 * pow(1 - q, 2);
+        }
+
+        template <typename Real>
+        Real CSphSpiky<Real>::laplacianW(const CGeoVector<Real> r, const Real h)
+        {
 
-            return CSphKernel<Real>::m_C * h * (dw * q + w * CSphKernel<Real>::m_dim);
+            return this->radialLaplacianW(r.norm() / h) * h / this->powh(h);
 
         }
 
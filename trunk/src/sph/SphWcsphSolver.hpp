@@ -0,0 +1,135 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include "GeoCoordinate.hpp"
+#include "GeoVector.hpp"
+#include "SphKernel.hpp"
+#include "SphKernelTable.hpp"
+#include "SphConvex.hpp"
+#include "SphCubicSpline.hpp"
+#include "SphGaussian.hpp"
+#include "SphQuintic.hpp"
+#include "SphSpiky.hpp"
+#include "SphParticleArrays.hpp"
+
+namespace ENigMA
+{
+
+    namespace sph
+    {
+
+        // Weakly compressible SPH for free surface flow. Density by summation, Tait equation of state with
+        // negative pressures cut off at the free surface, pressure gradient, laminar and artificial viscosity,
+        // kick-drift-kick leapfrog in time. Boundary particles take part in the sums but never move. Pairs come
+        // from a Verlet list that is rebuilt once a particle has moved half the skin. The pair loops are templated
+        // on the kernel type, or go through a lookup table of the kernel when tabulated.
+        template <typename Real>
+        class CSphWcsphSolver
+        {
+        private:
+
+            typedef std::vector<Real> varField;
+
+            CSphKernel<Real>* m_kernel;
+            CSphKernelTable<Real> m_table;
+
+            bool m_bTabulated;
+
+            Integer m_dim;
+
+            Real m_support;             // Kernel support radius in units of h
+            Real m_factorW;             // Scales the kernel to unit volume integral
+            Real m_factorGradW;         // Scales the kernel gradient to a consistent first moment
+            Real m_scaleW, m_scaleGradW;    // Normalization and smoothing length scaling together
+
+            Real m_h;
+            Real m_dx;
+
+            Real m_rho0;                // Reference density
+            Real m_mu;                  // Dynamic viscosity
+            Real m_c0;                  // Speed of sound
+            Real m_gamma;               // Tait exponent
+            Real m_alpha;               // Artificial viscosity coefficient
+
+            Real m_gx, m_gy, m_gz;
+
+            Real m_time;
+
+            Real m_skin;                // Verlet skin as a fraction of the kernel support
+
+            Integer m_step;
+            Integer m_sortStep;
+            Integer m_sortInterval;     // Minimum steps between Morton reorders of the particles
+
+            bool m_bInit;
+
+            // Particle state, fields not held by the arrays follow their reorders
+            CSphParticleArrays<Real> m_particles;
+            varField m_ax, m_ay, m_az;
+            varField m_p;
+            std::vector<bool> m_boundary;
+
+            // Per thread sums of the pair contributions
+            std::vector<varField> m_buffers;
+
+            void normalizeKernel();
+
+            void sortParticles();
+            void updateNeighborList();
+
+            Integer threadId();
+
+            template <typename TKernel> void calculateDensityAndPressure(TKernel& aKernel);
+            template <typename TKernel> void calculateForces(TKernel& aKernel);
+            void calculateAccelerations();
+
+        public:
+
+            CSphWcsphSolver(CSphKernel<Real>& aKernel);
+            ~CSphWcsphSolver();
+
+            void setMaterialProperties(const Real aDensity, const Real aViscosity);
+            void setSoundSpeed(const Real aSoundSpeed, const Real aGamma = 7.0);
+            void setArtificialViscosity(const Real anAlpha);
+            void setGravity(const Real gx, const Real gy, const Real gz);
+
+            void setSmoothingLength(const Real h);
+            void setParticleSpacing(const Real dx);
+            void setSortInterval(const Integer aSortInterval);
+            void setNeighborSkin(const Real aSkin);
+            void setTabulatedKernel(const bool bTabulated, const Integer nbSamples = 4096);
+
+            Integer addParticle(ENigMA::geometry::CGeoCoordinate<Real>& aPosition, const bool bBoundary = false);
+            void setVelocity(const Integer aParticleIndex, const ENigMA::geometry::CGeoVector<Real>& aVelocity);
+
+            Real calculateTimeStep();
+            void iterate(const Real dt);
+
+            Real time();
+            Real support();
+
+            Integer nbParticles();
+            bool isBoundary(const Integer aParticleIndex);
+
+            ENigMA::geometry::CGeoCoordinate<Real> position(const Integer aParticleIndex);
+            ENigMA::geometry::CGeoVector<Real> velocity(const Integer aParticleIndex);
+            Real density(const Integer aParticleIndex);
+            Real pressure(const Integer aParticleIndex);
+
+        };
+
+    }
+
+}
+
+#include "SphWcsphSolver_Imp.hpp"
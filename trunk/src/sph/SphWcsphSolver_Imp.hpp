@@ -0,0 +1,724 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace ENigMA::geometry;
+
+namespace ENigMA
+{
+
+    namespace sph
+    {
+
+        template <typename Real>
+        CSphWcsphSolver<Real>::CSphWcsphSolver(CSphKernel<Real>& aKernel) :
+            m_kernel(&aKernel),
+            m_bTabulated(false),
+            m_h(1.0),
+            m_dx(1.0),
+            m_rho0(1000.0),
+            m_mu(0.0),
+            m_c0(10.0),
+            m_gamma(7.0),
+            m_alpha(0.01),
+            m_gx(0.0), m_gy(0.0), m_gz(0.0),
+            m_time(0.0),
+            m_skin(0.1),
+            m_step(0),
+            m_sortStep(0),
+            m_sortInterval(20),
+            m_bInit(false)
+        {
+
+            m_dim = m_kernel->dimension();
+
+            this->normalizeKernel();
+            this->setSmoothingLength(1.0);
+
+            m_table.build(*m_kernel);
+
+        }
+
+        template <typename Real>
+        CSphWcsphSolver<Real>::~CSphWcsphSolver()
+        {
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::normalizeKernel()
+        {
+
+            const Real pi = std::acos(-1.0);
+
+            m_support = m_kernel->support();
+
+            // Radial midpoint rule for the zeroth moment of W and the first moment of its gradient
+            const Integer n = 4000;
+            const Real dq = m_support / n;
+
+            Real sumW = 0.0;
+            Real sumGradW = 0.0;
+
+            for (Integer k = 0; k < n; ++k)
+            {
+
+                Real q = (k + 0.5) * dq;
+
+                Real area = (m_dim == 1) ? 2.0 : (m_dim == 2) ? 2.0 * pi * q : 4.0 * pi * q * q;
+
+                sumW += m_kernel->W(CGeoVector<Real>(q, 0, 0), 1.0) * area * dq;
+                sumGradW += q * m_kernel->gradientW(CGeoVector<Real>(q, 0, 0), 1.0).x() * area * dq;
+
+            }
+
+            m_factorW = (sumW > 0.0) ? 1.0 / sumW : 1.0;
+            m_factorGradW = (sumGradW > 0.0) ? m_dim / sumGradW : 1.0;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setMaterialProperties(const Real aDensity, const Real aViscosity)
+        {
+
+            m_rho0 = aDensity;
+            m_mu = aViscosity;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setSoundSpeed(const Real aSoundSpeed, const Real aGamma)
+        {
+
+            m_c0 = aSoundSpeed;
+            m_gamma = aGamma;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setArtificialViscosity(const Real anAlpha)
+        {
+
+            m_alpha = anAlpha;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setGravity(const Real gx, const Real gy, const Real gz)
+        {
+
+            m_gx = gx;
+            m_gy = gy;
+            m_gz = gz;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setSmoothingLength(const Real h)
+        {
+
+            m_h = h;
+
+            m_scaleW = m_factorW / std::pow(h, static_cast<Real>(m_dim));
+            m_scaleGradW = m_factorGradW / std::pow(h, static_cast<Real>(m_dim + 1));
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setParticleSpacing(const Real dx)
+        {
+
+            m_dx = dx;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setSortInterval(const Integer aSortInterval)
+        {
+
+            m_sortInterval = aSortInterval;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setNeighborSkin(const Real aSkin)
+        {
+
+            m_skin = aSkin;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setTabulatedKernel(const bool bTabulated, const Integer nbSamples)
+        {
+
+            m_bTabulated = bTabulated;
+
+            if (m_table.nbSamples() != nbSamples)
+                m_table.build(*m_kernel, nbSamples);
+
+        }
+
+        template <typename Real>
+        Integer CSphWcsphSolver<Real>::addParticle(CGeoCoordinate<Real>& aPosition, const bool bBoundary)
+        {
+
+            // Each particle carries the mass of its share of the initial lattice
+            Integer aParticleIndex = m_particles.addParticle(aPosition.x(), aPosition.y(), aPosition.z(), m_rho0 * std::pow(m_dx, static_cast<Real>(m_dim)), m_rho0);
+
+            m_ax.push_back(0.0);
+            m_ay.push_back(0.0);
+            m_az.push_back(0.0);
+
+            m_p.push_back(0.0);
+
+            m_boundary.push_back(bBoundary);
+
+            m_bInit = false;
+
+            return aParticleIndex;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::setVelocity(const Integer aParticleIndex, const CGeoVector<Real>& aVelocity)
+        {
+
+            const Integer i = m_particles.slot(aParticleIndex);
+
+            m_particles.vx()[i] = aVelocity.x();
+            m_particles.vy()[i] = aVelocity.y();
+            m_particles.vz()[i] = aVelocity.z();
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::sortParticles()
+        {
+
+            m_particles.sortMorton(m_support * m_h);
+
+            m_particles.permute(m_ax);
+            m_particles.permute(m_ay);
+            m_particles.permute(m_az);
+
+            m_particles.permute(m_p);
+
+            m_particles.permute(m_boundary);
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::updateNeighborList()
+        {
+
+            const Real aRadius = m_support * m_h;
+            const Real aSkin = m_skin * aRadius;
+
+            if (m_particles.isNeighborListValid(aRadius, aSkin))
+                return;
+
+            // Reorder while the list has to be rebuilt anyway
+            if (m_sortInterval > 0 && m_step - m_sortStep >= m_sortInterval)
+            {
+                this->sortParticles();
+                m_sortStep = m_step;
+            }
+
+            m_particles.buildNeighborList(aRadius, aSkin);
+
+        }
+
+        template <typename Real>
+        Integer CSphWcsphSolver<Real>::threadId()
+        {
+
+#ifdef _OPENMP
+            return omp_get_thread_num();
+#else
+            return 0;
+#endif
+
+        }
+
+        template <typename Real>
+        template <typename TKernel>
+        void CSphWcsphSolver<Real>::calculateDensityAndPressure(TKernel& aKernel)
+        {
+
+            const Integer nbParticles = m_particles.size();
+
+            const Real B = m_c0 * m_c0 * m_rho0 / m_gamma;
+
+            const Real* x = m_particles.x().data();
+            const Real* y = m_particles.y().data();
+            const Real* z = m_particles.z().data();
+            const Real* mass = m_particles.mass().data();
+            Real* rho = m_particles.density().data();
+
+            const Integer* sOffsets = m_particles.neighborOffsets().data();
+            const Integer* sList = m_particles.neighborList().data();
+
+            const Real r2max = m_support * m_h * m_support * m_h;
+            const Real rh = 1.0 / m_h;
+            const Real W0 = m_scaleW * aKernel.radialW(0.0);
+
+            const Integer nbBuffers = static_cast<Integer>(m_buffers.size());
+
+            #pragma omp parallel
+            {
+
+                #pragma omp for
+                for (Integer i = 0; i < nbParticles; ++i)
+                {
+                    for (Integer t = 0; t < nbBuffers; ++t)
+                        m_buffers[t][i] = 0.0;
+                }
+
+                Real* sRho = m_buffers[this->threadId()].data();
+
+                // Each pair adds to both particles
+                #pragma omp for schedule(dynamic, 256)
+                for (Integer i = 0; i < nbParticles; ++i)
+                {
+
+                    Real rhoi = 0.0;
+
+                    for (Integer k = sOffsets[i]; k < sOffsets[i + 1]; ++k)
+                    {
+
+                        Integer j = sList[k];
+
+                        Real dx = x[j] - x[i];
+                        Real dy = y[j] - y[i];
+                        Real dz = z[j] - z[i];
+
+                        Real r2 = dx * dx + dy * dy + dz * dz;
+
+                        if (r2 >= r2max)
+                            continue;
+
+                        Real w = m_scaleW * aKernel.radialW(std::sqrt(r2) * rh);
+
+                        rhoi += mass[j] * w;
+                        sRho[j] += mass[i] * w;
+
+                    }
+
+                    sRho[i] += rhoi;
+
+                }
+
+                #pragma omp for
+                for (Integer i = 0; i < nbParticles; ++i)
+                {
+
+                    Real rhoi = mass[i] * W0;
+
+                    for (Integer t = 0; t < nbBuffers; ++t)
+                        rhoi += m_buffers[t][i];
+
+                    rho[i] = rhoi;
+
+                    // Tait equation, tension is not resolved at the free surface
+                    m_p[i] = std::max(B * (std::pow(rhoi / m_rho0, m_gamma) - 1.0), static_cast<Real>(0.0));
+
+                }
+
+            }
+
+        }
+
+        template <typename Real>
+        template <typename TKernel>
+        void CSphWcsphSolver<Real>::calculateForces(TKernel& aKernel)
+        {
+
+            const Integer nbParticles = m_particles.size();
+
+            const Real eta2 = 0.01 * m_h * m_h;
+
+            const Real* x = m_particles.x().data();
+            const Real* y = m_particles.y().data();
+            const Real* z = m_particles.z().data();
+            const Real* vx = m_particles.vx().data();
+            const Real* vy = m_particles.vy().data();
+            const Real* vz = m_particles.vz().data();
+            const Real* mass = m_particles.mass().data();
+            const Real* rho = m_particles.density().data();
+            const Real* p = m_p.data();
+
+            const Integer* sOffsets = m_particles.neighborOffsets().data();
+            const Integer* sList = m_particles.neighborList().data();
+
+            const Real r2max = m_support * m_h * m_support * m_h;
+            const Real rh = 1.0 / m_h;
+
+            const Integer nbBuffers = static_cast<Integer>(m_buffers.size());
+
+            #pragma omp parallel
+            {
+
+                #pragma omp for
+                for (Integer i = 0; i < 3 * nbParticles; ++i)
+                {
+                    for (Integer t = 0; t < nbBuffers; ++t)
+                        m_buffers[t][i] = 0.0;
+                }
+
+                Real* sAx = m_buffers[this->threadId()].data();
+                Real* sAy = sAx + nbParticles;
+                Real* sAz = sAy + nbParticles;
+
+                // Each pair adds to both particles with opposite sign, weighted by the partner mass
+                #pragma omp for schedule(dynamic, 256)
+                for (Integer i = 0; i < nbParticles; ++i)
+                {
+
+                    const Real pi = p[i] / (rho[i] * rho[i]);
+
+                    Real ax = 0.0;
+                    Real ay = 0.0;
+                    Real az = 0.0;
+
+                    for (Integer k = sOffsets[i]; k < sOffsets[i + 1]; ++k)
+                    {
+
+                        Integer j = sList[k];
+
+                        if (m_boundary[i] && m_boundary[j])
+                            continue;
+
+                        Real dx = x[j] - x[i];
+                        Real dy = y[j] - y[i];
+                        Real dz = z[j] - z[i];
+
+                        Real r2 = dx * dx + dy * dy + dz * dz;
+
+                        if (r2 <= 0.0 || r2 >= r2max)
+                            continue;
+
+                        Real r = std::sqrt(r2);
+
+                        // Gradient of W with respect to particle i along the unit vector to j
+                        Real gradW = m_scaleGradW * aKernel.radialGradientW(r * rh) / r;
+
+                        Real dvx = vx[i] - vx[j];
+                        Real dvy = vy[i] - vy[j];
+                        Real dvz = vz[i] - vz[j];
+
+                        // Monaghan artificial viscosity on approaching pairs
+                        Real vr = -(dvx * dx + dvy * dy + dvz * dz);
+
+                        Real Pi = 0.0;
+
+                        if (vr < 0.0)
+                            Pi = -m_alpha * m_c0 * m_h * vr / (r2 + eta2) / (0.5 * (rho[i] + rho[j]));
+
+                        Real fp = -(pi + p[j] / (rho[j] * rho[j]) + Pi) * gradW;
+
+                        // Morris laminar viscosity
+                        Real fv = -2.0 * m_mu / (rho[i] * rho[j]) * gradW * r2 / (r2 + eta2);
+
+                        Real fx = fp * dx + fv * dvx;
+                        Real fy = fp * dy + fv * dvy;
+                        Real fz = fp * dz + fv * dvz;
+
+                        ax += mass[j] * fx;
+                        ay += mass[j] * fy;
+                        az += mass[j] * fz;
+
+                        sAx[j] -= mass[i] * fx;
+                        sAy[j] -= mass[i] * fy;
+                        sAz[j] -= mass[i] * fz;
+
+                    }
+
+                    sAx[i] += ax;
+                    sAy[i] += ay;
+                    sAz[i] += az;
+
+                }
+
+                #pragma omp for
+                for (Integer i = 0; i < nbParticles; ++i)
+                {
+
+                    if (m_boundary[i])
+                    {
+                        m_ax[i] = 0.0;
+                        m_ay[i] = 0.0;
+                        m_az[i] = 0.0;
+                        continue;
+                    }
+
+                    Real ax = m_gx;
+                    Real ay = m_gy;
+                    Real az = m_gz;
+
+                    for (Integer t = 0; t < nbBuffers; ++t)
+                    {
+                        ax += m_buffers[t][i];
+                        ay += m_buffers[t][nbParticles + i];
+                        az += m_buffers[t][2 * nbParticles + i];
+                    }
+
+                    m_ax[i] = ax;
+                    m_ay[i] = ay;
+                    m_az[i] = az;
+
+                }
+
+            }
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::calculateAccelerations()
+        {
+
+            const Integer nbParticles = m_particles.size();
+
+            if (nbParticles == 0)
+                return;
+
+            Integer nbThreads = 1;
+
+#ifdef _OPENMP
+            nbThreads = omp_get_max_threads();
+#endif
+
+            m_buffers.resize(nbThreads);
+
+            for (Integer t = 0; t < nbThreads; ++t)
+                m_buffers[t].resize(3 * nbParticles);
+
+            this->updateNeighborList();
+
+            // Resolve the kernel type once so that the pair loops call it without virtual dispatch
+            CSphCubicSpline<Real>* aCubicSpline = dynamic_cast<CSphCubicSpline<Real>*>(m_kernel);
+            CSphQuintic<Real>* aQuintic = dynamic_cast<CSphQuintic<Real>*>(m_kernel);
+            CSphSpiky<Real>* aSpiky = dynamic_cast<CSphSpiky<Real>*>(m_kernel);
+            CSphGaussian<Real>* aGaussian = dynamic_cast<CSphGaussian<Real>*>(m_kernel);
+            CSphConvex<Real>* aConvex = dynamic_cast<CSphConvex<Real>*>(m_kernel);
+
+            if (!m_bTabulated && aCubicSpline)
+            {
+                this->calculateDensityAndPressure(*aCubicSpline);
+                this->calculateForces(*aCubicSpline);
+            }
+            else if (!m_bTabulated && aQuintic)
+            {
+                this->calculateDensityAndPressure(*aQuintic);
+                this->calculateForces(*aQuintic);
+            }
+            else if (!m_bTabulated && aSpiky)
+            {
+                this->calculateDensityAndPressure(*aSpiky);
+                this->calculateForces(*aSpiky);
+            }
+            else if (!m_bTabulated && aGaussian)
+            {
+                this->calculateDensityAndPressure(*aGaussian);
+                this->calculateForces(*aGaussian);
+            }
+            else if (!m_bTabulated && aConvex)
+            {
+                this->calculateDensityAndPressure(*aConvex);
+                this->calculateForces(*aConvex);
+            }
+            else
+            {
+                // Tabulated on request, and for kernels without a radial form known here
+                this->calculateDensityAndPressure(m_table);
+                this->calculateForces(m_table);
+            }
+
+            m_bInit = true;
+
+        }
+
+        template <typename Real>
+        Real CSphWcsphSolver<Real>::calculateTimeStep()
+        {
+
+            if (!m_bInit)
+                this->calculateAccelerations();
+
+            const varField& vx = m_particles.vx();
+            const varField& vy = m_particles.vy();
+            const varField& vz = m_particles.vz();
+
+            Real v2max = 0.0;
+            Real a2max = 0.0;
+
+            for (Integer i = 0; i < m_particles.size(); ++i)
+            {
+
+                if (m_boundary[i])
+                    continue;
+
+                v2max = std::max(v2max, vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+                a2max = std::max(a2max, m_ax[i] * m_ax[i] + m_ay[i] * m_ay[i] + m_az[i] * m_az[i]);
+
+            }
+
+            // Acoustic, body force and viscous limits
+            Real dt = 0.25 * m_h / (m_c0 + std::sqrt(v2max));
+
+            if (a2max > 0.0)
+                dt = std::min(dt, 0.25 * std::sqrt(m_h / std::sqrt(a2max)));
+
+            if (m_mu > 0.0)
+                dt = std::min(dt, 0.125 * m_h * m_h * m_rho0 / m_mu);
+
+            return dt;
+
+        }
+
+        template <typename Real>
+        void CSphWcsphSolver<Real>::iterate(const Real dt)
+        {
+
+            const Integer nbParticles = m_particles.size();
+
+            if (!m_bInit)
+                this->calculateAccelerations();
+
+            Real* x = m_particles.x().data();
+            Real* y = m_particles.y().data();
+            Real* z = m_particles.z().data();
+            Real* vx = m_particles.vx().data();
+            Real* vy = m_particles.vy().data();
+            Real* vz = m_particles.vz().data();
+
+            // Kick and drift
+            #pragma omp parallel for
+            for (Integer i = 0; i < nbParticles; ++i)
+            {
+
+                if (m_boundary[i])
+                    continue;
+
+                vx[i] += 0.5 * dt * m_ax[i];
+                vy[i] += 0.5 * dt * m_ay[i];
+                vz[i] += 0.5 * dt * m_az[i];
+
+                x[i] += dt * vx[i];
+                y[i] += dt * vy[i];
+                z[i] += dt * vz[i];
+
+            }
+
+            m_step++;
+
+            this->calculateAccelerations();
+
+            // The particles may have been reordered with the neighbour list
+            vx = m_particles.vx().data();
+            vy = m_particles.vy().data();
+            vz = m_particles.vz().data();
+
+            // Kick with the forces at the new positions
+            #pragma omp parallel for
+            for (Integer i = 0; i < nbParticles; ++i)
+            {
+
+                if (m_boundary[i])
+                    continue;
+
+                vx[i] += 0.5 * dt * m_ax[i];
+                vy[i] += 0.5 * dt * m_ay[i];
+                vz[i] += 0.5 * dt * m_az[i];
+
+            }
+
+            m_time += dt;
+
+        }
+
+        template <typename Real>
+        Real CSphWcsphSolver<Real>::time()
+        {
+
+            return m_time;
+
+        }
+
+        template <typename Real>
+        Real CSphWcsphSolver<Real>::support()
+        {
+
+            return m_support;
+
+        }
+
+        template <typename Real>
+        Integer CSphWcsphSolver<Real>::nbParticles()
+        {
+
+            return m_particles.size();
+
+        }
+
+        template <typename Real>
+        bool CSphWcsphSolver<Real>::isBoundary(const Integer aParticleIndex)
+        {
+
+            return m_boundary[m_particles.slot(aParticleIndex)];
+
+        }
+
+        template <typename Real>
+        CGeoCoordinate<Real> CSphWcsphSolver<Real>::position(const Integer aParticleIndex)
+        {
+
+            const Integer i = m_particles.slot(aParticleIndex);
+
+            return CGeoCoordinate<Real>(m_particles.x()[i], m_particles.y()[i], m_particles.z()[i]);
+
+        }
+
+        template <typename Real>
+        CGeoVector<Real> CSphWcsphSolver<Real>::velocity(const Integer aParticleIndex)
+        {
+
+            const Integer i = m_particles.slot(aParticleIndex);
+
+            return CGeoVector<Real>(m_particles.vx()[i], m_particles.vy()[i], m_particles.vz()[i]);
+
+        }
+
+        template <typename Real>
+        Real CSphWcsphSolver<Real>::density(const Integer aParticleIndex)
+        {
+
+            return m_particles.density()[m_particles.slot(aParticleIndex)];
+
+        }
+
+        template <typename Real>
+        Real CSphWcsphSolver<Real>::pressure(const Integer aParticleIndex)
+        {
+
+            return m_p[m_particles.slot(aParticleIndex)];
+
+        }
+
+    }
+
+}
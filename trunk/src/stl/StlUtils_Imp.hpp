@@ -652,6 +652,12 @@ namespace ENigMA
 
             aHashGrid.build();
 
+            // Query all the edge centers at once
+            std::vector<Integer> sOffsets;
+            std::vector<Integer> sCoordinates;
+
+            aHashGrid.find(sCenterCoordinates, sOffsets, sCoordinates, aTolerance);
+
             for (Integer i = 0; i < m_stlFile.nbFacets(); ++i)
             {
 
@@ -673,13 +679,9 @@ namespace ENigMA
                 for (Integer j = 0; j < 3; ++j)
                 {
 
-                    CGeoCoordinate<Real> aCenterCoordinate = (m_stlFile.facet(aFacetId).vertex((j + 0) % 3) + m_stlFile.facet(aFacetId).vertex((j + 1) % 3)) * 0.5;
-
-                    std::vector<Integer> sCoordinates;
-
-                    aHashGrid.find(sCoordinates, aCenterCoordinate, aTolerance);
+                    Integer q = i * 3 + j;
 
-                    for (Integer k = 0; k < static_cast<Integer> (sCoordinates.size()); ++k)
+                    for (Integer k = sOffsets[q]; k < sOffsets[q + 1]; ++k)
                     {
 
                         if (sCoordinates[k] != aFacetId * 3 + j)
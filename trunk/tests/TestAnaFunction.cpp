@@ -10,6 +10,8 @@
 // <Author> Billy Araujo </Author>
 // *****************************************************************************
 
+#include <ctime>
+
 #include "gtest/gtest.h"
 
 #include "TypeDef.hpp"
@@ -75,3 +77,113 @@ TEST_F(CTestAnaFunction, evaluate)
 
 }
 
+
+TEST_F(CTestAnaFunction, evaluateBenchmark)
+{
+
+    decimal x, y;
+
+    CAnaFunction<decimal> aAnaFunction;
+
+    aAnaFunction.set("0.1 + 0.05 * sqrt(x^2 + y^2)");
+    aAnaFunction.defineVariable("x", x);
+    aAnaFunction.defineVariable("y", y);
+
+    const Integer nbCalls = 2000;
+
+    decimal sumParse = 0.0;
+    decimal sumCached = 0.0;
+
+    // Parse on every call (previous behaviour)
+    clock_t begin = clock();
+
+    for (Integer i = 0; i < nbCalls; ++i)
+    {
+        x = i * 0.001;
+        y = 1.0 - x;
+        aAnaFunction.set("0.1 + 0.05 * sqrt(x^2 + y^2)");
+        sumParse += aAnaFunction.evaluate();
+    }
+
+    clock_t end = clock();
+
+    double timeParse = static_cast<double>(end - begin) / CLOCKS_PER_SEC;
+
+    // Compile once and reuse
+    begin = clock();
+
+    for (Integer i = 0; i < nbCalls; ++i)
+    {
+        x = i * 0.001;
+        y = 1.0 - x;
+        sumCached += aAnaFunction.evaluate();
+    }
+
+    end = clock();
+
+    double timeCached = static_cast<double>(end - begin) / CLOCKS_PER_SEC;
+
+    std::cout << "Per-call cost (parse)  : " << timeParse / nbCalls * 1E6 << " us" << std::endl;
+    std::cout << "Per-call cost (cached) : " << timeCached / nbCalls * 1E6 << " us" << std::endl;
+
+    EXPECT_NEAR(sumParse, sumCached, 1E-9);
+    EXPECT_LT(timeCached, timeParse);
+
+    // Single variable overload keeps its own compiled expression
+    aAnaFunction.set("2*t-6");
+
+    for (Integer i = 0; i < 10; ++i)
+    {
+        decimal t = i;
+        EXPECT_NEAR(2 * t - 6, aAnaFunction.evaluate("t", t), 1E-12);
+    }
+
+    // Copies recompile against their own storage
+    CAnaFunction<decimal> aCopy(aAnaFunction);
+    decimal t = 4.0;
+    EXPECT_NEAR(2.0, aCopy.evaluate("t", t), 1E-12);
+
+}
+
+TEST_F(CTestAnaFunction, evaluateBatch)
+{
+
+    decimal a = 2.0;
+
+    CAnaFunction<decimal> aAnaFunction;
+
+    aAnaFunction.set("a * x + y * t");
+    aAnaFunction.defineVariable("a", a);
+
+    std::vector<std::string> sVariables;
+
+    sVariables.push_back("x");
+    sVariables.push_back("y");
+    sVariables.push_back("t");
+
+    const Integer nbPoints = 50000;
+
+    std::vector<std::vector<decimal> > sColumns(3, std::vector<decimal>(nbPoints));
+
+    for (Integer i = 0; i < nbPoints; ++i)
+    {
+        sColumns[0][i] = i * 1E-3;
+        sColumns[1][i] = 1.0 - i * 1E-3;
+        sColumns[2][i] = 0.5;
+    }
+
+    std::vector<decimal> sValues;
+
+    aAnaFunction.evaluate(sVariables, sColumns, sValues, 2);
+
+    EXPECT_EQ(nbPoints, static_cast<Integer>(sValues.size()));
+
+    for (Integer i = 0; i < nbPoints; i += 997)
+        EXPECT_NEAR(a * sColumns[0][i] + sColumns[1][i] * sColumns[2][i], sValues[i], 1E-12);
+
+    aAnaFunction.set(3.0);
+    aAnaFunction.evaluate(sVariables, sColumns, sValues);
+
+    EXPECT_NEAR(3.0, sValues[nbPoints - 1], 1E-12);
+
+}
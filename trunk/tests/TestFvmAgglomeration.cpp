@@ -0,0 +1,207 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#include "gtest/gtest.h"
+
+#include "TypeDef.hpp"
+
+#include "FvmMesh.hpp"
+#include "FvmAgglomeration.hpp"
+#include "MshBasicMesher.hpp"
+#include "SleSolver.hpp"
+
+using namespace ENigMA::fvm;
+using namespace ENigMA::sle;
+
+class CTestFvmAgglomeration : public ::testing::Test {
+protected:
+
+    virtual void SetUp() {
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    void generate(CMshBasicMesher<decimal>& aBasicMesher, const Integer n) {
+
+        CGeoCoordinate<decimal> aVertex1(0.0, 0.0, 0.0);
+        CGeoCoordinate<decimal> aVertex2(1.0, 0.0, 0.0);
+        CGeoCoordinate<decimal> aVertex3(1.0, 1.0, 0.0);
+        CGeoCoordinate<decimal> aVertex4(0.0, 1.0, 0.0);
+        CGeoCoordinate<decimal> aVertex5(0.0, 0.0, 0.1);
+        CGeoCoordinate<decimal> aVertex6(1.0, 0.0, 0.1);
+        CGeoCoordinate<decimal> aVertex7(1.0, 1.0, 0.1);
+        CGeoCoordinate<decimal> aVertex8(0.0, 1.0, 0.1);
+
+        CGeoHexahedron<decimal> aHexahedron;
+
+        aHexahedron.addVertex(aVertex1);
+        aHexahedron.addVertex(aVertex2);
+        aHexahedron.addVertex(aVertex3);
+        aHexahedron.addVertex(aVertex4);
+        aHexahedron.addVertex(aVertex5);
+        aHexahedron.addVertex(aVertex6);
+        aHexahedron.addVertex(aVertex7);
+        aHexahedron.addVertex(aVertex8);
+
+        aBasicMesher.generate(aHexahedron, n, n, 1);
+
+        aBasicMesher.mesh().generateFaces(1E-12);
+
+    }
+
+    // Diffusion matrix with a fixed value on the side walls
+    void assemble(CFvmMesh<decimal>& aFvmMesh, Eigen::SparseMatrix<decimal>& A, Eigen::Matrix<decimal, Eigen::Dynamic, 1>& b) {
+
+        aFvmMesh.calculateFaceGeometry();
+
+        const Integer nbControlVolumes = aFvmMesh.nbControlVolumes();
+
+        std::vector<Eigen::Triplet<decimal> > sCoefficients;
+
+        b = Eigen::Matrix<decimal, Eigen::Dynamic, 1>::Zero(nbControlVolumes);
+
+        for (Integer i = 0; i < aFvmMesh.nbFaces(); ++i)
+        {
+
+            Integer anIndexO = aFvmMesh.faceOwner(i);
+            Integer anIndexN = aFvmMesh.faceNeighbor(i);
+
+            if (anIndexN >= 0)
+            {
+
+                decimal a = aFvmMesh.faceArea(i) / (aFvmMesh.faceOwnerDist(i) + aFvmMesh.faceNeighborDist(i));
+
+                sCoefficients.push_back(Eigen::Triplet<decimal>(anIndexO, anIndexO, a));
+                sCoefficients.push_back(Eigen::Triplet<decimal>(anIndexN, anIndexN, a));
+                sCoefficients.push_back(Eigen::Triplet<decimal>(anIndexO, anIndexN, -a));
+                sCoefficients.push_back(Eigen::Triplet<decimal>(anIndexN, anIndexO, -a));
+
+            }
+            else if (aFvmMesh.faceArea(i) < 0.5 && aFvmMesh.faceOwnerDist(i) > 0.0)
+            {
+
+                // Thin faces are the side walls, the large front and back faces stay insulated
+                decimal a = aFvmMesh.faceArea(i) / aFvmMesh.faceOwnerDist(i);
+
+                sCoefficients.push_back(Eigen::Triplet<decimal>(anIndexO, anIndexO, a));
+
+            }
+
+        }
+
+        for (Integer i = 0; i < nbControlVolumes; ++i)
+            b[i] = aFvmMesh.originalVolume(i);
+
+        A.resize(nbControlVolumes, nbControlVolumes);
+        A.setFromTriplets(sCoefficients.begin(), sCoefficients.end());
+
+    }
+
+};
+
+TEST_F(CTestFvmAgglomeration, levels) {
+
+    CMshBasicMesher<decimal> aBasicMesher;
+
+    this->generate(aBasicMesher, 32);
+
+    CFvmMesh<decimal> aFvmMesh(aBasicMesher.mesh());
+
+    CFvmAgglomeration<decimal> anAgglomeration;
+
+    anAgglomeration.setCoarseSize(10);
+    anAgglomeration.build(aFvmMesh);
+
+    EXPECT_EQ(32 * 32, anAgglomeration.levelSize(0));
+    EXPECT_GT(anAgglomeration.nbLevels(), 3);
+    EXPECT_LE(anAgglomeration.levelSize(anAgglomeration.nbLevels() - 1), 64);
+
+    for (Integer l = 0; l < anAgglomeration.nbLevels() - 1; ++l)
+    {
+
+        const std::vector<Integer>& sAggregates = anAgglomeration.aggregates()[l];
+
+        ASSERT_EQ(anAgglomeration.levelSize(l), static_cast<Integer>(sAggregates.size()));
+
+        // Every fine cell belongs to a coarse one and no coarse cell is empty
+        std::vector<Integer> sCount(anAgglomeration.levelSize(l + 1), 0);
+
+        for (Integer i = 0; i < static_cast<Integer>(sAggregates.size()); ++i)
+        {
+
+            ASSERT_GE(sAggregates[i], 0);
+            ASSERT_LT(sAggregates[i], anAgglomeration.levelSize(l + 1));
+
+            sCount[sAggregates[i]]++;
+
+        }
+
+        for (Integer i = 0; i < static_cast<Integer>(sCount.size()); ++i)
+            EXPECT_GT(sCount[i], 0);
+
+        // Double pairing coarsens about four to one
+        EXPECT_LT(anAgglomeration.levelSize(l + 1) * 3, anAgglomeration.levelSize(l));
+
+    }
+
+}
+
+TEST_F(CTestFvmAgglomeration, laplacian) {
+
+    std::vector<Integer> sIterations;
+
+    for (Integer n = 20; n <= 80; n *= 2)
+    {
+
+        CMshBasicMesher<decimal> aBasicMesher;
+
+        this->generate(aBasicMesher, n);
+
+        CFvmMesh<decimal> aFvmMesh(aBasicMesher.mesh());
+
+        Eigen::SparseMatrix<decimal> A;
+        Eigen::Matrix<decimal, Eigen::Dynamic, 1> b;
+
+        this->assemble(aFvmMesh, A, b);
+
+        CFvmAgglomeration<decimal> anAgglomeration(aFvmMesh);
+
+        CSleSolver<decimal> aMultigridSolver;
+
+        aMultigridSolver.setPreconditioner(PT_ALGEBRAIC_MULTIGRID);
+        aMultigridSolver.setAggregates(anAgglomeration.aggregates());
+        aMultigridSolver.setTolerance(1E-10);
+
+        Eigen::Matrix<decimal, Eigen::Dynamic, 1> x = aMultigridSolver.solve(MT_SPARSE_SYMMETRIC, A, b);
+
+        EXPECT_LT((A * x - b).norm() / b.norm(), 1E-8);
+
+        CSleSolver<decimal> aJacobiSolver;
+
+        aJacobiSolver.setPreconditioner(PT_JACOBI);
+        aJacobiSolver.setTolerance(1E-10);
+
+        aJacobiSolver.solve(MT_SPARSE_SYMMETRIC, A, b);
+
+        EXPECT_LT(aMultigridSolver.iterations() * 2, aJacobiSolver.iterations());
+
+        sIterations.push_back(aMultigridSolver.iterations());
+
+    }
+
+    // Iterations should not grow with the mesh like they do with Jacobi
+    EXPECT_LE(sIterations.back(), sIterations.front() + 5);
+
+}
@@ -338,3 +338,161 @@ TEST_F(CTestFvmMesh, clip2) {
     }
 
 }
+
+TEST_F(CTestFvmMesh, faceGeometry) {
+
+    CGeoCoordinate<decimal> aVertex1(0.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aVertex2(2.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aVertex3(2.0, 1.0, 0.0);
+    CGeoCoordinate<decimal> aVertex4(0.0, 1.0, 0.0);
+    CGeoCoordinate<decimal> aVertex5(0.0, 0.0, 1.0);
+    CGeoCoordinate<decimal> aVertex6(2.0, 0.0, 1.0);
+    CGeoCoordinate<decimal> aVertex7(2.0, 1.0, 1.0);
+    CGeoCoordinate<decimal> aVertex8(0.0, 1.0, 1.0);
+
+    CGeoHexahedron<decimal> aHexahedron;
+
+    aHexahedron.addVertex(aVertex1);
+    aHexahedron.addVertex(aVertex2);
+    aHexahedron.addVertex(aVertex3);
+    aHexahedron.addVertex(aVertex4);
+    aHexahedron.addVertex(aVertex5);
+    aHexahedron.addVertex(aVertex6);
+    aHexahedron.addVertex(aVertex7);
+    aHexahedron.addVertex(aVertex8);
+
+    CMshBasicMesher<decimal> aBasicMesher;
+
+    aBasicMesher.generate(aHexahedron, 2, 1, 1);
+
+    aBasicMesher.mesh().generateFaces(1E-12);
+
+    CFvmMesh<decimal> aFvmMesh(aBasicMesher.mesh());
+
+    aFvmMesh.calculateFaceGeometry();
+
+    EXPECT_EQ(11, aFvmMesh.nbFaces());
+
+    Integer nbInteriorFaces = 0;
+
+    for (Integer i = 0; i < aFvmMesh.nbFaces(); ++i)
+    {
+
+        Integer anOwner = aFvmMesh.faceOwner(i);
+        Integer aNeighbor = aFvmMesh.faceNeighbor(i);
+
+        EXPECT_GE(anOwner, 0);
+        EXPECT_NEAR(1.0, aFvmMesh.faceNormal(i).norm(), 1E-12);
+
+        if (aNeighbor >= 0)
+        {
+
+            nbInteriorFaces++;
+
+            // The face between the two unit cubes at x = 1
+            EXPECT_NE(anOwner, aNeighbor);
+            EXPECT_NEAR(1.0, aFvmMesh.faceArea(i), 1E-12);
+            EXPECT_NEAR(0.5, aFvmMesh.faceOwnerDist(i), 1E-12);
+            EXPECT_NEAR(0.5, aFvmMesh.faceNeighborDist(i), 1E-12);
+            EXPECT_NEAR(0.5, aFvmMesh.faceWeight(i), 1E-12);
+
+            // The normal points from the owner to the neighbor
+            Integer anOwnerId = aFvmMesh.controlVolumeId(anOwner);
+            Integer aNeighborId = aFvmMesh.controlVolumeId(aNeighbor);
+
+            CGeoVector<decimal> d = aFvmMesh.controlVolume(aNeighborId).centroid() - aFvmMesh.controlVolume(anOwnerId).centroid();
+
+            EXPECT_NEAR(1.0, d.dot(aFvmMesh.faceNormal(i)), 1E-12);
+
+        }
+        else
+        {
+            EXPECT_NEAR(0.5, aFvmMesh.faceOwnerDist(i), 1E-12);
+            EXPECT_EQ(1.0, aFvmMesh.faceWeight(i));
+        }
+
+    }
+
+    EXPECT_EQ(1, nbInteriorFaces);
+
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+        EXPECT_NEAR(1.0, aFvmMesh.originalVolume(i), 1E-12);
+
+    // Each cube sees its five boundary faces and the shared one, in ascending face order
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+    {
+
+        EXPECT_EQ(6, aFvmMesh.nbControlVolumeFaces(i));
+
+        for (Integer j = 0; j < aFvmMesh.nbControlVolumeFaces(i); ++j)
+        {
+
+            Integer aFaceIndex = aFvmMesh.controlVolumeFace(i, j);
+
+            EXPECT_TRUE(aFvmMesh.faceOwner(aFaceIndex) == i || aFvmMesh.faceNeighbor(aFaceIndex) == i);
+
+            if (j > 0)
+                EXPECT_LT(aFvmMesh.controlVolumeFace(i, j - 1), aFaceIndex);
+
+        }
+
+    }
+
+}
+
+TEST_F(CTestFvmMesh, reset) {
+
+    CGeoCoordinate<decimal> aVertex1(0.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aVertex2(3.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aVertex3(3.0, 2.0, 0.0);
+    CGeoCoordinate<decimal> aVertex4(0.0, 2.0, 0.0);
+    CGeoCoordinate<decimal> aVertex5(0.0, 0.0, 1.0);
+    CGeoCoordinate<decimal> aVertex6(3.0, 0.0, 1.0);
+    CGeoCoordinate<decimal> aVertex7(3.0, 2.0, 1.0);
+    CGeoCoordinate<decimal> aVertex8(0.0, 2.0, 1.0);
+
+    CGeoHexahedron<decimal> aHexahedron;
+
+    aHexahedron.addVertex(aVertex1);
+    aHexahedron.addVertex(aVertex2);
+    aHexahedron.addVertex(aVertex3);
+    aHexahedron.addVertex(aVertex4);
+    aHexahedron.addVertex(aVertex5);
+    aHexahedron.addVertex(aVertex6);
+    aHexahedron.addVertex(aVertex7);
+    aHexahedron.addVertex(aVertex8);
+
+    CMshBasicMesher<decimal> aBasicMesher;
+
+    aBasicMesher.generate(aHexahedron, 3, 2, 1);
+
+    aBasicMesher.mesh().generateFaces(1E-12);
+
+    CFvmMesh<decimal> aFvmMesh(aBasicMesher.mesh());
+
+    // Rebuilding must not carry indices over from the previous mesh
+    aFvmMesh.set(aBasicMesher.mesh());
+
+    aFvmMesh.calculateFaceGeometry();
+
+    EXPECT_EQ(6, aFvmMesh.nbControlVolumes());
+    EXPECT_EQ(3 * 2 * 2 + 4 * 2 + 3 * 3, aFvmMesh.nbFaces());
+
+    for (Integer i = 0; i < aFvmMesh.nbFaces(); ++i)
+        EXPECT_EQ(i, aFvmMesh.faceIndex(aFvmMesh.faceId(i)));
+
+    decimal aVolume = 0.0;
+
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+    {
+
+        EXPECT_EQ(i, aFvmMesh.controlVolumeIndex(aFvmMesh.controlVolumeId(i)));
+        EXPECT_EQ(6, aFvmMesh.nbControlVolumeFaces(i));
+
+        aVolume += aFvmMesh.originalVolume(i);
+
+    }
+
+    EXPECT_NEAR(6.0, aVolume, 1E-12);
+
+}
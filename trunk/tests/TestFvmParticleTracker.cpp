@@ -0,0 +1,235 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#include "gtest/gtest.h"
+
+#include "TypeDef.hpp"
+
+#include "MshBasicMesher.hpp"
+#include "FvmMeshSearch.hpp"
+#include "FvmParticleTracker.hpp"
+
+using namespace ENigMA::fvm;
+
+class CTestFvmParticleTracker : public ::testing::Test {
+protected:
+
+    CMshBasicMesher<decimal> m_basicMesher;
+
+    virtual void SetUp() {
+
+        CGeoCoordinate<decimal> aVertex1(0.0, 0.0, 0.0);
+        CGeoCoordinate<decimal> aVertex2(1.0, 0.0, 0.0);
+        CGeoCoordinate<decimal> aVertex3(1.0, 1.0, 0.0);
+        CGeoCoordinate<decimal> aVertex4(0.0, 1.0, 0.0);
+        CGeoCoordinate<decimal> aVertex5(0.0, 0.0, 0.1);
+        CGeoCoordinate<decimal> aVertex6(1.0, 0.0, 0.1);
+        CGeoCoordinate<decimal> aVertex7(1.0, 1.0, 0.1);
+        CGeoCoordinate<decimal> aVertex8(0.0, 1.0, 0.1);
+
+        CGeoHexahedron<decimal> aHexahedron;
+
+        aHexahedron.addVertex(aVertex1);
+        aHexahedron.addVertex(aVertex2);
+        aHexahedron.addVertex(aVertex3);
+        aHexahedron.addVertex(aVertex4);
+        aHexahedron.addVertex(aVertex5);
+        aHexahedron.addVertex(aVertex6);
+        aHexahedron.addVertex(aVertex7);
+        aHexahedron.addVertex(aVertex8);
+
+        m_basicMesher.generate(aHexahedron, 10, 10, 1);
+
+        m_basicMesher.mesh().generateFaces(1E-12);
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    void setUniformVelocity(CFvmMesh<decimal>& aFvmMesh, CFvmParticleTracker<decimal>& aTracker, const decimal u, const decimal v, const decimal w) {
+
+        for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+            aTracker.setVelocity(aFvmMesh.controlVolumeId(i), u, v, w);
+
+    }
+
+};
+
+TEST_F(CTestFvmParticleTracker, outlet) {
+
+    CFvmMesh<decimal> aFvmMesh(m_basicMesher.mesh());
+
+    CFvmParticleTracker<decimal> aTracker(aFvmMesh);
+
+    this->setUniformVelocity(aFvmMesh, aTracker, 1.0, 0.0, 0.0);
+
+    std::vector<Integer> sFaceIds;
+
+    for (Integer i = 0; i < aFvmMesh.nbFaces(); ++i)
+    {
+
+        CFvmFace<decimal>& aFace = aFvmMesh.face(aFvmMesh.faceId(i));
+
+        aFace.calculateCentroid();
+
+        if (fabs(aFace.centroid().x() - 1.0) < 1E-9)
+            sFaceIds.push_back(aFvmMesh.faceId(i));
+
+    }
+
+    aTracker.setBoundaryType(sFaceIds, BT_OUTLET);
+
+    CGeoCoordinate<decimal> aPosition(0.05, 0.55, 0.05);
+
+    Integer aParticle = aTracker.addParticle(aPosition);
+
+    ASSERT_EQ(0, aParticle);
+
+    CGeoCoordinate<decimal> anOutside(1.5, 0.55, 0.05);
+
+    EXPECT_EQ(-1, aTracker.addParticle(anOutside));
+
+    aTracker.advance(0.5);
+
+    EXPECT_TRUE(aTracker.isActive(aParticle));
+    EXPECT_NEAR(0.55, aTracker.position(aParticle).x(), 1E-9);
+    EXPECT_NEAR(0.55, aTracker.position(aParticle).y(), 1E-9);
+    EXPECT_NEAR(0.5, aTracker.residenceTime(aParticle), 1E-9);
+
+    // The walked cell is the one a global search finds
+    CFvmMeshSearch<decimal> aMeshSearch(aFvmMesh);
+
+    aMeshSearch.build();
+
+    CGeoCoordinate<decimal> aCoordinate = aTracker.position(aParticle);
+
+    EXPECT_TRUE(aMeshSearch.isInsideControlVolume(aCoordinate, aTracker.controlVolumeId(aParticle), 1E-9));
+
+    aTracker.advance(1.0);
+
+    EXPECT_FALSE(aTracker.isActive(aParticle));
+    EXPECT_EQ(0, aTracker.nbActiveParticles());
+    EXPECT_NEAR(0.95, aTracker.residenceTime(aParticle), 1E-9);
+
+}
+
+TEST_F(CTestFvmParticleTracker, wall) {
+
+    CFvmMesh<decimal> aFvmMesh(m_basicMesher.mesh());
+
+    CFvmParticleTracker<decimal> aTracker(aFvmMesh);
+
+    this->setUniformVelocity(aFvmMesh, aTracker, 0.5, 1.0, 0.0);
+
+    CGeoCoordinate<decimal> aPosition(0.25, 0.75, 0.05);
+
+    Integer aTracer = aTracker.addParticle(aPosition);
+
+    aTracker.advance(0.5);
+
+    // Tracers stop at the wall and slide along it
+    EXPECT_TRUE(aTracker.isActive(aTracer));
+    EXPECT_NEAR(0.5, aTracker.position(aTracer).x(), 1E-9);
+    EXPECT_NEAR(1.0, aTracker.position(aTracer).y(), 1E-9);
+
+}
+
+TEST_F(CTestFvmParticleTracker, settling) {
+
+    CFvmMesh<decimal> aFvmMesh(m_basicMesher.mesh());
+
+    CFvmParticleTracker<decimal> aTracker(aFvmMesh);
+
+    decimal g = -10.0;
+    decimal tau = 0.01;
+
+    aTracker.setGravity(0.0, g, 0.0);
+
+    CGeoCoordinate<decimal> aPosition(0.55, 0.95, 0.05);
+
+    Integer aParticle = aTracker.addParticle(aPosition, tau);
+
+    decimal dt = 1E-3;
+
+    for (Integer i = 0; i < 50; ++i)
+        aTracker.advance(dt);
+
+    // Stokes drag relaxes the particle to its settling velocity
+    decimal t = 50 * dt;
+
+    EXPECT_NEAR(g * tau * (1.0 - exp(-t / tau)), aTracker.velocity(aParticle).y(), 1E-9);
+    EXPECT_NEAR(0.95 + g * tau * (t - tau * (1.0 - exp(-t / tau))), aTracker.position(aParticle).y(), 1E-3);
+
+    // It bounces off the bottom wall without leaving the domain
+    for (Integer i = 0; i < 2000; ++i)
+        aTracker.advance(dt);
+
+    EXPECT_TRUE(aTracker.isActive(aParticle));
+    EXPECT_GE(aTracker.position(aParticle).y(), 0.0);
+
+}
+
+TEST_F(CTestFvmParticleTracker, parallel) {
+
+    CFvmMesh<decimal> aFvmMesh(m_basicMesher.mesh());
+
+    CFvmParticleTracker<decimal> aTracker(aFvmMesh);
+
+    // Solid body rotation about the centre
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+    {
+
+        Integer aControlVolumeId = aFvmMesh.controlVolumeId(i);
+
+        CGeoCoordinate<decimal> aCentroid = aFvmMesh.controlVolume(aControlVolumeId).centroid();
+
+        aTracker.setVelocity(aControlVolumeId, -(aCentroid.y() - 0.5), aCentroid.x() - 0.5, 0.0);
+
+    }
+
+    for (Integer i = 0; i < 50; ++i)
+    {
+
+        for (Integer j = 0; j < 50; ++j)
+        {
+
+            CGeoCoordinate<decimal> aPosition(0.01 + i * 0.0196, 0.01 + j * 0.0196, 0.05);
+
+            aTracker.addParticle(aPosition);
+
+        }
+
+    }
+
+    EXPECT_EQ(2500, aTracker.nbParticles());
+
+    for (Integer i = 0; i < 20; ++i)
+        aTracker.advance(0.05);
+
+    EXPECT_EQ(2500, aTracker.nbActiveParticles());
+
+    CFvmMeshSearch<decimal> aMeshSearch(aFvmMesh);
+
+    aMeshSearch.build();
+
+    for (Integer i = 0; i < aTracker.nbParticles(); ++i)
+    {
+
+        CGeoCoordinate<decimal> aCoordinate = aTracker.position(i);
+
+        EXPECT_TRUE(aMeshSearch.isInsideControlVolume(aCoordinate, aTracker.controlVolumeId(i), 1E-9));
+
+    }
+
+}
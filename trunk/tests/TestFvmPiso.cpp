@@ -128,3 +128,109 @@ TEST_F(CTestFvmPiso, hydroPressure) {
 
 }
 
+
+TEST_F(CTestFvmPiso, adaptiveTimeStep) {
+
+    CGeoCoordinate<decimal> aVertex1(+0.00, +0.00, -1.0);
+    CGeoCoordinate<decimal> aVertex2(+1.00, +0.00, -1.0);
+    CGeoCoordinate<decimal> aVertex3(+1.00, +1.00, -1.0);
+    CGeoCoordinate<decimal> aVertex4(+0.00, +1.00, -1.0);
+    CGeoCoordinate<decimal> aVertex5(+0.00, +0.00, +1.0);
+    CGeoCoordinate<decimal> aVertex6(+1.00, +0.00, +1.0);
+    CGeoCoordinate<decimal> aVertex7(+1.00, +1.00, +1.0);
+    CGeoCoordinate<decimal> aVertex8(+0.00, +1.00, +1.0);
+
+    CGeoHexahedron<decimal> aHexahedron;
+
+    aHexahedron.addVertex(aVertex1);
+    aHexahedron.addVertex(aVertex2);
+    aHexahedron.addVertex(aVertex3);
+    aHexahedron.addVertex(aVertex4);
+    aHexahedron.addVertex(aVertex5);
+    aHexahedron.addVertex(aVertex6);
+    aHexahedron.addVertex(aVertex7);
+    aHexahedron.addVertex(aVertex8);
+
+    Integer nx = 10;
+    Integer ny = 80;
+
+    CMshBasicMesher<decimal> aBasicMesher;
+
+    aBasicMesher.generate(aHexahedron, nx, ny, 1);
+
+    aBasicMesher.mesh().generateFaces(1E-12);
+
+    aBasicMesher.mesh().calculateFaceCentroid();
+    aBasicMesher.mesh().calculateElementCentroid();
+
+    CFvmMesh<decimal> aFvmMesh(aBasicMesher.mesh());
+
+    CFvmPisoSolver<decimal> aPisoSolver(aFvmMesh);
+
+    decimal g = -9.8;
+    aPisoSolver.setGravity(0.0, g, 0.0);
+
+    decimal mu = 0.1; // dynamic viscosity
+    decimal rho = 1000.0; // density
+
+    aPisoSolver.setMaterialProperties(rho, mu);
+
+    std::vector<Integer> sFaceIds;
+
+    for (Integer i = 0; i < aFvmMesh.nbFaces(); ++i)
+    {
+
+        Integer aFaceId = aFvmMesh.faceId(i);
+
+        CFvmFace<decimal> aFace = aFvmMesh.face(aFaceId);
+
+        aFace.calculateCentroid();
+
+        if (aFace.centroid().x() == 0.0 ||
+            aFace.centroid().x() == 1.0 ||
+            aFace.centroid().y() == 0.0 ||
+            aFace.centroid().y() == 1.0)
+        {
+            sFaceIds.push_back(aFaceId);
+        }
+
+    }
+
+    aPisoSolver.setBoundaryVelocity(sFaceIds, BT_WALL_NO_SLIP, 0.0, 0.0, 0.0);
+    aPisoSolver.setBoundaryPressure(sFaceIds, BT_WALL_NO_SLIP, 0.0);
+
+    decimal dtInit = 1E-4;
+    decimal dtMax = 1E-3;
+
+    aPisoSolver.setTimeControl(dtInit, 0.5, 1.0, 0.0, dtMax, 1.2);
+
+    while (aPisoSolver.time() < 1E-2)
+        aPisoSolver.iterateAdaptive();
+
+    const std::vector<decimal>& sTimeIntervals = aPisoSolver.timeIntervals();
+
+    ASSERT_GT(sTimeIntervals.size(), 1u);
+
+    EXPECT_NEAR(dtInit, sTimeIntervals.front(), 1E-12);
+    EXPECT_NEAR(dtMax, sTimeIntervals.back(), 1E-12);
+
+    for (unsigned int i = 1; i < sTimeIntervals.size(); ++i)
+        EXPECT_LE(sTimeIntervals[i], 1.2 * sTimeIntervals[i - 1] + 1E-12);
+
+    EXPECT_LT(aPisoSolver.courant(sTimeIntervals.back()), 0.5);
+
+    decimal p = 0.0;
+
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+    {
+
+        unsigned int aControlVolumeId = aFvmMesh.controlVolumeId(i);
+
+        p = std::max(p, aPisoSolver.p(aControlVolumeId));
+
+    }
+
+    EXPECT_NEAR(rho*fabs(g), p, 200);
+
+}
+
@@ -0,0 +1,172 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#include "gtest/gtest.h"
+
+#include "TypeDef.hpp"
+
+#include "MshBasicMesher.hpp"
+#include "FvmSimpleSolver.hpp"
+
+using namespace ENigMA::fvm;
+
+class CTestFvmSimple : public ::testing::Test {
+protected:
+
+    CMshMesh<decimal> m_mesh;
+
+    virtual void SetUp() {
+
+        CGeoCoordinate<decimal> aVertex1(+0.00, +0.40, -0.05);
+        CGeoCoordinate<decimal> aVertex2(+0.50, +0.40, -0.05);
+        CGeoCoordinate<decimal> aVertex3(+0.50, +0.60, -0.05);
+        CGeoCoordinate<decimal> aVertex4(+0.00, +0.60, -0.05);
+        CGeoCoordinate<decimal> aVertex5(+0.00, +0.40, +0.05);
+        CGeoCoordinate<decimal> aVertex6(+0.50, +0.40, +0.05);
+        CGeoCoordinate<decimal> aVertex7(+0.50, +0.60, +0.05);
+        CGeoCoordinate<decimal> aVertex8(+0.00, +0.60, +0.05);
+
+        CGeoHexahedron<decimal> aHexahedron;
+
+        aHexahedron.addVertex(aVertex1);
+        aHexahedron.addVertex(aVertex2);
+        aHexahedron.addVertex(aVertex3);
+        aHexahedron.addVertex(aVertex4);
+        aHexahedron.addVertex(aVertex5);
+        aHexahedron.addVertex(aVertex6);
+        aHexahedron.addVertex(aVertex7);
+        aHexahedron.addVertex(aVertex8);
+
+        Integer nx = 20;
+        Integer ny = 10;
+
+        CMshBasicMesher<decimal> aBasicMesher;
+
+        aBasicMesher.generate(aHexahedron, nx, ny, 1);
+
+        m_mesh = aBasicMesher.mesh();
+
+        m_mesh.generateFaces(1E-12);
+
+        m_mesh.calculateFaceCentroid();
+        m_mesh.calculateElementCentroid();
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    void setBoundaries(CFvmMesh<decimal>& aFvmMesh, CFvmSimpleSolver<decimal>& aSimpleSolver, std::vector<Integer>& sInletFaceIds, std::vector<Integer>& sOutletFaceIds) {
+
+        std::vector<Integer> sWallFaceIds;
+
+        for (Integer i = 0; i < aFvmMesh.nbFaces(); ++i)
+        {
+
+            Integer aFaceId = aFvmMesh.faceId(i);
+
+            CFvmFace<decimal> aFace = aFvmMesh.face(aFaceId);
+
+            aFace.calculateCentroid();
+
+            if (aFace.centroid().y() == 0.4 ||
+                aFace.centroid().y() == 0.6)
+                sWallFaceIds.push_back(aFaceId);
+            else if (aFace.centroid().x() == 0.0)
+                sInletFaceIds.push_back(aFaceId);
+            else if (aFace.centroid().x() == 0.5)
+                sOutletFaceIds.push_back(aFaceId);
+
+        }
+
+        aSimpleSolver.setBoundaryVelocity(sWallFaceIds, BT_WALL_NO_SLIP, 0.0, 0.0, 0.0);
+        aSimpleSolver.setBoundaryPressure(sWallFaceIds, BT_WALL_NO_SLIP, 0.0);
+
+        aSimpleSolver.setBoundaryVelocity(sInletFaceIds, BT_INLET_FLOW, 1.0, 0.0, 0.0);
+        aSimpleSolver.setBoundaryPressure(sInletFaceIds, BT_INLET_FLOW, 0.0);
+
+        aSimpleSolver.setBoundaryVelocity(sOutletFaceIds, BT_OUTLET, 0.0, 0.0, 0.0);
+        aSimpleSolver.setBoundaryPressure(sOutletFaceIds, BT_OUTLET, 0.0);
+
+    }
+
+};
+
+TEST_F(CTestFvmSimple, channel) {
+
+    CFvmMesh<decimal> aFvmMesh(m_mesh);
+
+    CFvmSimpleSolver<decimal> aSimpleSolver(aFvmMesh);
+
+    aSimpleSolver.setMaterialProperties(1.0, 1.0);
+
+    std::vector<Integer> sInletFaceIds, sOutletFaceIds;
+
+    this->setBoundaries(aFvmMesh, aSimpleSolver, sInletFaceIds, sOutletFaceIds);
+
+    aSimpleSolver.setRelaxationFactors(0.7, 0.3);
+
+    Integer nIter = aSimpleSolver.solve(500, 1E-6);
+
+    EXPECT_LT(nIter, 500);
+
+    decimal inFlux = 0.0;
+
+    for (Integer i = 0; i < static_cast<Integer> (sInletFaceIds.size()); ++i)
+        inFlux += aSimpleSolver.flux(sInletFaceIds[i]);
+
+    decimal outFlux = 0.0;
+
+    for (Integer i = 0; i < static_cast<Integer> (sOutletFaceIds.size()); ++i)
+        outFlux += aSimpleSolver.flux(sOutletFaceIds[i]);
+
+    EXPECT_NEAR(0.02, inFlux, 1E-12);
+    EXPECT_NEAR(0.0, inFlux + outFlux, 1E-6);
+
+    decimal u = 0.0;
+
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+        u = std::max(u, aSimpleSolver.u(aFvmMesh.controlVolumeId(i)));
+
+    // Fully developed laminar profile: umax = 1.5 * umean
+    EXPECT_NEAR(1.5, u, 0.15);
+
+}
+
+TEST_F(CTestFvmSimple, channelConsistent) {
+
+    CFvmMesh<decimal> aFvmMesh(m_mesh);
+
+    CFvmSimpleSolver<decimal> aSimpleSolver(aFvmMesh);
+
+    aSimpleSolver.setMaterialProperties(1.0, 1.0);
+
+    std::vector<Integer> sInletFaceIds, sOutletFaceIds;
+
+    this->setBoundaries(aFvmMesh, aSimpleSolver, sInletFaceIds, sOutletFaceIds);
+
+    aSimpleSolver.setRelaxationFactors(0.9, 0.9);
+    aSimpleSolver.setConsistent(true);
+
+    Integer nIter = aSimpleSolver.solve(500, 1E-6);
+
+    EXPECT_LT(nIter, 100);
+
+    decimal u = 0.0;
+
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+        u = std::max(u, aSimpleSolver.u(aFvmMesh.controlVolumeId(i)));
+
+    EXPECT_NEAR(1.5, u, 0.15);
+
+}
@@ -0,0 +1,209 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#include "gtest/gtest.h"
+
+#include "TypeDef.hpp"
+
+#include "MshBasicMesher.hpp"
+#include "FvmVofSolver.hpp"
+
+using namespace ENigMA::fvm;
+
+class CTestFvmVof : public ::testing::Test {
+protected:
+
+    CMshMesh<decimal> m_mesh;
+
+    virtual void SetUp() {
+
+        CGeoCoordinate<decimal> aVertex1(+0.00, +0.00, -0.2);
+        CGeoCoordinate<decimal> aVertex2(+1.00, +0.00, -0.2);
+        CGeoCoordinate<decimal> aVertex3(+1.00, +1.00, -0.2);
+        CGeoCoordinate<decimal> aVertex4(+0.00, +1.00, -0.2);
+        CGeoCoordinate<decimal> aVertex5(+0.00, +0.00, +0.2);
+        CGeoCoordinate<decimal> aVertex6(+1.00, +0.00, +0.2);
+        CGeoCoordinate<decimal> aVertex7(+1.00, +1.00, +0.2);
+        CGeoCoordinate<decimal> aVertex8(+0.00, +1.00, +0.2);
+
+        CGeoHexahedron<decimal> aHexahedron;
+
+        aHexahedron.addVertex(aVertex1);
+        aHexahedron.addVertex(aVertex2);
+        aHexahedron.addVertex(aVertex3);
+        aHexahedron.addVertex(aVertex4);
+        aHexahedron.addVertex(aVertex5);
+        aHexahedron.addVertex(aVertex6);
+        aHexahedron.addVertex(aVertex7);
+        aHexahedron.addVertex(aVertex8);
+
+        Integer nx = 20;
+        Integer ny = 20;
+
+        CMshBasicMesher<decimal> aBasicMesher;
+
+        aBasicMesher.generate(aHexahedron, nx, ny, 1);
+
+        m_mesh = aBasicMesher.mesh();
+
+        m_mesh.generateFaces(1E-12);
+
+        m_mesh.calculateFaceCentroid();
+        m_mesh.calculateElementCentroid();
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    // Water column in the left part of a closed tank open at the top
+    void damBreak(CFvmMesh<decimal>& aFvmMesh, CFvmVofSolver<decimal>& aVofSolver) {
+
+        for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+        {
+
+            Integer aControlVolumeId = aFvmMesh.controlVolumeId(i);
+
+            CFvmControlVolume<decimal>& aControlVolume = aFvmMesh.controlVolume(aControlVolumeId);
+
+            aControlVolume.calculateCentroid();
+
+            if (aControlVolume.centroid().x() < 0.3 && aControlVolume.centroid().y() < 0.6)
+                aVofSolver.setInitialGamma(aControlVolumeId, 1.0);
+
+        }
+
+        aVofSolver.setGravity(0.0, -9.8, 0.0);
+        aVofSolver.setMaterialProperties(1.0, 1.0, 1000.0, 1.0);
+
+        std::vector<Integer> sWallIds, sOutletIds;
+
+        for (Integer i = 0; i < aFvmMesh.nbFaces(); ++i)
+        {
+
+            Integer aFaceId = aFvmMesh.faceId(i);
+
+            CFvmFace<decimal> aFace = aFvmMesh.face(aFaceId);
+
+            aFace.calculateCentroid();
+
+            if (aFace.centroid().y() > (1.0 - 1E-6))
+                sOutletIds.push_back(aFaceId);
+            else if (aFace.centroid().x() < 1E-6 ||
+                aFace.centroid().x() > (1.0 - 1E-6) ||
+                aFace.centroid().y() < 1E-6)
+                sWallIds.push_back(aFaceId);
+
+        }
+
+        aVofSolver.setBoundaryVelocity(sWallIds, BT_WALL_NO_SLIP, 0.0, 0.0, 0.0);
+        aVofSolver.setBoundaryPressure(sWallIds, BT_WALL_NO_SLIP, 0.0);
+        aVofSolver.setBoundaryGamma(sWallIds, BT_WALL_NO_SLIP, 0.0);
+
+        aVofSolver.setBoundaryVelocity(sOutletIds, BT_OUTLET, 0.0, 0.0, 0.0);
+        aVofSolver.setBoundaryPressure(sOutletIds, BT_OUTLET, 0.0);
+        aVofSolver.setBoundaryGamma(sOutletIds, BT_OUTLET, 0.0);
+
+    }
+
+};
+
+TEST_F(CTestFvmVof, interfaceBand) {
+
+    CFvmMesh<decimal> aFvmMesh(m_mesh);
+
+    CFvmVofSolver<decimal> aVofSolver1(aFvmMesh);
+    CFvmVofSolver<decimal> aVofSolver2(aFvmMesh);
+
+    this->damBreak(aFvmMesh, aVofSolver1);
+    this->damBreak(aFvmMesh, aVofSolver2);
+
+    aVofSolver2.setInterfaceBand(2);
+
+    decimal dt = 1E-4;
+    Integer nIter = 20;
+
+    for (Integer i = 0; i < nIter; ++i)
+    {
+
+        aVofSolver1.iterate(dt);
+        aVofSolver2.iterate(dt);
+
+    }
+
+    EXPECT_EQ(aFvmMesh.nbControlVolumes(), aVofSolver1.nbInterfaceBandControlVolumes());
+
+    EXPECT_GT(aVofSolver2.nbInterfaceBandControlVolumes(), 0);
+    EXPECT_LT(aVofSolver2.nbInterfaceBandControlVolumes(), aFvmMesh.nbControlVolumes() / 2);
+
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+    {
+
+        Integer aControlVolumeId = aFvmMesh.controlVolumeId(i);
+
+        EXPECT_NEAR(aVofSolver1.s(aControlVolumeId), aVofSolver2.s(aControlVolumeId), 1E-3);
+
+    }
+
+}
+
+TEST_F(CTestFvmVof, restart) {
+
+    CFvmMesh<decimal> aFvmMesh(m_mesh);
+
+    CFvmVofSolver<decimal> aVofSolver1(aFvmMesh);
+
+    this->damBreak(aFvmMesh, aVofSolver1);
+
+    aVofSolver1.setInterfaceBand(2);
+
+    decimal dt = 1E-4;
+
+    for (Integer i = 0; i < 10; ++i)
+        aVofSolver1.iterate(dt);
+
+    // The file is written while the solver carries on
+    EXPECT_TRUE(aVofSolver1.saveCheckpoint("vof_restart.chk", true));
+
+    for (Integer i = 0; i < 5; ++i)
+        aVofSolver1.iterate(dt);
+
+    ASSERT_TRUE(aVofSolver1.waitCheckpoint());
+
+    CFvmMesh<decimal> aRestartMesh(m_mesh);
+
+    CFvmCheckpoint<decimal> aCheckpoint;
+
+    ASSERT_TRUE(aCheckpoint.load("vof_restart.chk"));
+    ASSERT_TRUE(aRestartMesh.readFaceGeometry(aCheckpoint));
+
+    CFvmVofSolver<decimal> aVofSolver2(aRestartMesh);
+
+    ASSERT_TRUE(aVofSolver2.loadCheckpoint(aCheckpoint));
+
+    for (Integer i = 0; i < 5; ++i)
+        aVofSolver2.iterate(dt);
+
+    for (Integer i = 0; i < aFvmMesh.nbControlVolumes(); ++i)
+    {
+
+        Integer aControlVolumeId = aFvmMesh.controlVolumeId(i);
+
+        EXPECT_EQ(aVofSolver1.s(aControlVolumeId), aVofSolver2.s(aControlVolumeId));
+        EXPECT_EQ(aVofSolver1.u(aControlVolumeId), aVofSolver2.u(aControlVolumeId));
+        EXPECT_EQ(aVofSolver1.v(aControlVolumeId), aVofSolver2.v(aControlVolumeId));
+        EXPECT_EQ(aVofSolver1.p(aControlVolumeId), aVofSolver2.p(aControlVolumeId));
+
+    }
+
+}
@@ -10,6 +10,9 @@
 // <Author> Billy Araujo </Author>
 // *****************************************************************************
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "gtest/gtest.h"
 
 #include "TypeDef.hpp"
@@ -112,3 +115,112 @@ TEST_F(TestGeoHashGrid, find2) {
     EXPECT_EQ(3, sCoords.size());
 
 }
+
+TEST_F(TestGeoHashGrid, findBatch) {
+
+    CGeoHashGrid<decimal> aHashGrid;
+
+    std::vector<CGeoCoordinate<decimal> > sCoordinates;
+
+    srand(1234);
+
+    for (Integer i = 0; i < 2000; ++i)
+    {
+
+        CGeoCoordinate<decimal> aCoord(static_cast<decimal>(rand()) / RAND_MAX, static_cast<decimal>(rand()) / RAND_MAX, static_cast<decimal>(rand()) / RAND_MAX);
+
+        aHashGrid.addGeometricObject(3 * i + 1, aCoord);
+        sCoordinates.push_back(aCoord);
+
+    }
+
+    aHashGrid.build();
+
+    std::vector<Integer> sOffsets;
+    std::vector<Integer> sCoords;
+
+    aHashGrid.find(sCoordinates, sOffsets, sCoords, 0.05);
+
+    EXPECT_EQ(sCoordinates.size() + 1, sOffsets.size());
+
+    // Same results and order as one query at a time
+    for (Integer i = 0; i < static_cast<Integer>(sCoordinates.size()); ++i)
+    {
+
+        std::vector<Integer> sSingle;
+
+        aHashGrid.find(sSingle, sCoordinates[i], 0.05);
+
+        EXPECT_EQ(sSingle, std::vector<Integer>(sCoords.begin() + sOffsets[i], sCoords.begin() + sOffsets[i + 1]));
+
+    }
+
+}
+
+TEST_F(TestGeoHashGrid, findNearest) {
+
+    CGeoHashGrid<decimal> aHashGrid;
+
+    std::vector<CGeoCoordinate<decimal> > sCoordinates;
+
+    srand(4321);
+
+    for (Integer i = 0; i < 2000; ++i)
+    {
+
+        CGeoCoordinate<decimal> aCoord(static_cast<decimal>(rand()) / RAND_MAX, 2.0 * static_cast<decimal>(rand()) / RAND_MAX, 0.5 * static_cast<decimal>(rand()) / RAND_MAX);
+
+        aHashGrid.addGeometricObject(i, aCoord);
+        sCoordinates.push_back(aCoord);
+
+    }
+
+    aHashGrid.build();
+
+    // Queries inside and outside the bounding box
+    std::vector<CGeoCoordinate<decimal> > sQueries;
+
+    for (Integer i = 0; i < 100; ++i)
+        sQueries.push_back(CGeoCoordinate<decimal>(3.0 * rand() / RAND_MAX - 1.0, 3.0 * rand() / RAND_MAX - 0.5, 1.5 * rand() / RAND_MAX - 0.5));
+
+    Integer nbNearest = 8;
+
+    std::vector<Integer> sOffsets;
+    std::vector<Integer> sCoords;
+
+    aHashGrid.findNearest(sQueries, sOffsets, sCoords, nbNearest);
+
+    for (Integer q = 0; q < static_cast<Integer>(sQueries.size()); ++q)
+    {
+
+        std::vector<std::pair<decimal, Integer> > sBruteForce;
+
+        for (Integer i = 0; i < static_cast<Integer>(sCoordinates.size()); ++i)
+            sBruteForce.push_back(std::make_pair((sCoordinates[i] - sQueries[q]).squaredNorm(), i));
+
+        std::sort(sBruteForce.begin(), sBruteForce.end());
+
+        std::vector<Integer> sSingle;
+
+        aHashGrid.findNearest(sSingle, sQueries[q], nbNearest);
+
+        ASSERT_EQ(nbNearest, static_cast<Integer>(sSingle.size()));
+        ASSERT_EQ(nbNearest, sOffsets[q + 1] - sOffsets[q]);
+
+        // Closest first
+        for (Integer n = 0; n < nbNearest; ++n)
+        {
+            EXPECT_EQ(sBruteForce[n].second, sSingle[n]);
+            EXPECT_EQ(sBruteForce[n].second, sCoords[sOffsets[q] + n]);
+        }
+
+    }
+
+    // Fewer points than requested
+    std::vector<Integer> sAll;
+
+    aHashGrid.findNearest(sAll, sQueries[0], 5000);
+
+    EXPECT_EQ(2000, static_cast<Integer>(sAll.size()));
+
+}
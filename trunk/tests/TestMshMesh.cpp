@@ -259,3 +259,106 @@ TEST_F(CTestMshMesh, addMesh) {
     EXPECT_EQ(5, aMesh.nodeIndex(6));
 
 }
+TEST_F(CTestMshMesh, remove) {
+
+    CMshMesh<decimal> aMesh;
+
+    for (Integer i = 0; i < 5; ++i)
+    {
+
+        CMshNode<decimal> aNode;
+        aNode << i * 0.25, 0.0, 0.0;
+        aMesh.addNode(i * 2, aNode);
+
+    }
+
+    EXPECT_EQ(5, aMesh.nbNodes());
+    EXPECT_EQ(9, aMesh.nextNodeId());
+
+    aMesh.removeNode(4);
+    aMesh.removeNode(8);
+
+    EXPECT_EQ(3, aMesh.nbNodes());
+    EXPECT_EQ(7, aMesh.nextNodeId());
+
+    // Remaining nodes are still found by id before the indices are rebuilt
+    EXPECT_EQ(0.75, aMesh.node(6).x());
+
+    aMesh.rebuildIndices();
+
+    EXPECT_EQ(2, aMesh.nodeIndex(6));
+    EXPECT_EQ(6, aMesh.nodeId(2));
+    EXPECT_EQ(0.25, aMesh.node(2).x());
+    EXPECT_EQ(0.75, aMesh.node(6).x());
+
+    aMesh.renumber();
+
+    EXPECT_EQ(3, aMesh.nextNodeId());
+    EXPECT_EQ(0.75, aMesh.node(2).x());
+
+}
+
+TEST_F(CTestMshMesh, generateFaces) {
+
+    // Thin layer of two triangles
+    CMshMesh<decimal> aMesh;
+
+    const decimal h = 1E-3;
+
+    CMshNode<decimal> aNode1(0.0, 0.0, 0.0);
+    CMshNode<decimal> aNode2(1.0, 0.0, 0.0);
+    CMshNode<decimal> aNode3(1.0, h, 0.0);
+    CMshNode<decimal> aNode4(0.0, h, 0.0);
+
+    aMesh.addNode(0, aNode1);
+    aMesh.addNode(1, aNode2);
+    aMesh.addNode(2, aNode3);
+    aMesh.addNode(3, aNode4);
+
+    CMshElement<decimal> anElement1(ET_TRIANGLE);
+    anElement1.addNodeId(0);
+    anElement1.addNodeId(1);
+    anElement1.addNodeId(2);
+    aMesh.addElement(0, anElement1);
+
+    CMshElement<decimal> anElement2(ET_TRIANGLE);
+    anElement2.addNodeId(0);
+    anElement2.addNodeId(2);
+    anElement2.addNodeId(3);
+    aMesh.addElement(1, anElement2);
+
+    aMesh.generateFaces(1E-6);
+
+    EXPECT_EQ(6, aMesh.nbFaces());
+    EXPECT_EQ(4, aMesh.nbBoundaryFaces());
+
+    // Diagonal edge (0, 2) is shared topologically
+    EXPECT_TRUE(aMesh.face(2).hasPair());
+    EXPECT_EQ(3, aMesh.face(2).pairFaceId());
+    EXPECT_EQ(2, aMesh.face(3).pairFaceId());
+
+    // Beams with coincident but unmerged end nodes are paired geometrically
+    CMshMesh<decimal> anEdgeMesh;
+
+    anEdgeMesh.addNode(0, aNode1);
+    anEdgeMesh.addNode(1, aNode2);
+    anEdgeMesh.addNode(2, aNode2);
+    anEdgeMesh.addNode(3, aNode3);
+
+    CMshElement<decimal> anElement3(ET_BEAM);
+    anElement3.addNodeId(0);
+    anElement3.addNodeId(1);
+    anEdgeMesh.addElement(0, anElement3);
+
+    CMshElement<decimal> anElement4(ET_BEAM);
+    anElement4.addNodeId(2);
+    anElement4.addNodeId(3);
+    anEdgeMesh.addElement(1, anElement4);
+
+    anEdgeMesh.generateFaces(1E-6);
+
+    EXPECT_EQ(2, anEdgeMesh.nbBoundaryFaces());
+    EXPECT_EQ(2, anEdgeMesh.face(1).pairFaceId());
+
+}
+
@@ -10,6 +10,10 @@
 // <Author> Billy Araujo </Author>
 // *****************************************************************************
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "gtest/gtest.h"
 
 #include "TypeDef.hpp"
@@ -88,6 +92,138 @@ TEST_F(CTestPdeEquation, femSteadyLaplaceLine)
 
 }
 
+TEST_F(CTestPdeEquation, femParallelAssembly)
+{
+
+    CGeoCoordinate<decimal> aVertex1(0.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aVertex2(1.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aVertex3(1.0, 1.0, 0.0);
+    CGeoCoordinate<decimal> aVertex4(0.0, 1.0, 0.0);
+
+    CGeoQuadrilateral<decimal> aQuadrilateral;
+
+    aQuadrilateral.addVertex(aVertex1);
+    aQuadrilateral.addVertex(aVertex2);
+    aQuadrilateral.addVertex(aVertex3);
+    aQuadrilateral.addVertex(aVertex4);
+
+    CMshBasicMesher<decimal> aBasicMesher;
+
+    const Integer nu = 50;
+    const Integer nv = 40;
+
+    aBasicMesher.generate(aQuadrilateral, nu, nv);
+
+    EXPECT_EQ(nu * nv, aBasicMesher.mesh().nbElements());
+
+    CPdeField<decimal> T;
+
+    T.setMesh(aBasicMesher.mesh());
+    T.setDiscretMethod(DM_FEM);
+    T.setDiscretOrder(DO_LINEAR);
+    T.setDiscretLocation(DL_NODE);
+    T.setSimulationType(ST_GENERIC);
+    T.setNbDofs(1);
+
+    CSleSystem<decimal> aSystem = laplacian<decimal>(T);
+
+    EXPECT_EQ(T.mesh().nbNodes(), aSystem.matrixA.rows());
+
+    // Every row of the stiffness matrix sums to zero
+    Eigen::Matrix<decimal, Eigen::Dynamic, 1> sRowSums = aSystem.matrixA * Eigen::Matrix<decimal, Eigen::Dynamic, 1>::Ones(T.mesh().nbNodes());
+
+    EXPECT_NEAR(0.0, sRowSums.norm(), 1E-10);
+
+#ifdef _OPENMP
+
+    // Same matrix when assembled by a single thread
+    Integer nbThreads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+
+    CSleSystem<decimal> aSerialSystem = laplacian<decimal>(T);
+
+    omp_set_num_threads(nbThreads);
+
+    EXPECT_EQ(aSerialSystem.matrixA.nonZeros(), aSystem.matrixA.nonZeros());
+    EXPECT_NEAR(0.0, (aSerialSystem.matrixA - aSystem.matrixA).norm(), 1E-10);
+    EXPECT_NEAR(0.0, (aSerialSystem.vectorB - aSystem.vectorB).norm(), 1E-10);
+
+#endif
+
+}
+
+TEST_F(CTestPdeEquation, femPatternReuse)
+{
+
+    CGeoCoordinate<decimal> aVertex1(0.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aVertex2(1.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aVertex3(1.0, 1.0, 0.0);
+    CGeoCoordinate<decimal> aVertex4(0.0, 1.0, 0.0);
+
+    CGeoQuadrilateral<decimal> aQuadrilateral;
+
+    aQuadrilateral.addVertex(aVertex1);
+    aQuadrilateral.addVertex(aVertex2);
+    aQuadrilateral.addVertex(aVertex3);
+    aQuadrilateral.addVertex(aVertex4);
+
+    CMshBasicMesher<decimal> aBasicMesher;
+
+    aBasicMesher.generate(aQuadrilateral, 20, 10, true);
+
+    CPdeField<decimal> T;
+
+    T.setMesh(aBasicMesher.mesh());
+    T.setDiscretMethod(DM_FEM);
+    T.setDiscretOrder(DO_LINEAR);
+    T.setDiscretLocation(DL_NODE);
+    T.setSimulationType(ST_GENERIC);
+    T.setNbDofs(1);
+
+    T.u.resize(T.mesh().nbNodes());
+    T.u.setZero();
+
+    EXPECT_FALSE(T.pattern(OT_LAPLACIAN).isValid());
+
+    CSleSystem<decimal> aSystem1 = laplacian<decimal>(T);
+
+    EXPECT_TRUE(T.pattern(OT_LAPLACIAN).isValid());
+    EXPECT_EQ(T.mesh().nbElements(), T.pattern(OT_LAPLACIAN).nbElements());
+    EXPECT_EQ(aSystem1.matrixA.nonZeros(), T.pattern(OT_LAPLACIAN).nbNonZeros());
+
+    // Second assembly scatters into the cached pattern
+    CSleSystem<decimal> aSystem2 = laplacian<decimal>(T);
+
+    EXPECT_TRUE(samePattern(aSystem1.matrixA, aSystem2.matrixA));
+    EXPECT_NEAR(0.0, (aSystem1.matrixA - aSystem2.matrixA).norm(), 1E-12);
+    EXPECT_NEAR(0.0, (aSystem1.vectorB - aSystem2.vectorB).norm(), 1E-12);
+
+    // Operators on the same mesh are combined value by value
+    CSleSystem<decimal> aMass = ddt<decimal>(T);
+
+    EXPECT_TRUE(samePattern(aMass.matrixA, aSystem1.matrixA));
+
+    Eigen::SparseMatrix<decimal> aReference = aMass.matrixA - aSystem1.matrixA;
+
+    CSleSystem<decimal> aSystem3 = aMass - aSystem1;
+
+    EXPECT_TRUE(samePattern(aSystem3.matrixA, aSystem1.matrixA));
+    EXPECT_NEAR(0.0, (aSystem3.matrixA - aReference).norm(), 1E-12);
+
+    // A new mesh invalidates the patterns
+    aBasicMesher.generate(aQuadrilateral, 10, 10, true);
+
+    T.setMesh(aBasicMesher.mesh());
+
+    EXPECT_FALSE(T.pattern(OT_LAPLACIAN).isValid());
+
+    CSleSystem<decimal> aSystem4 = laplacian<decimal>(T);
+
+    EXPECT_EQ(T.mesh().nbNodes(), aSystem4.matrixA.rows());
+
+}
+
 TEST_F(CTestPdeEquation, fdmSteadyLaplaceLine)
 {
 
@@ -61,3 +61,43 @@ TEST_F(CTestPdeGeometricField, set) {
 
 }
 
+
+TEST_F(CTestPdeGeometricField, setValues) {
+
+    CGeoCoordinate<decimal> aPoint1(0.0, 0.0, 0.0);
+    CGeoCoordinate<decimal> aPoint2(1.0, 0.0, 0.0);
+
+    CGeoLine<decimal> aLine(aPoint1, aPoint2);
+
+    CMshBasicMesher<decimal> aBasicMesher;
+
+    const Integer ne = 4;
+
+    aBasicMesher.generate(aLine, ne);
+
+    CPdeField<decimal> T;
+
+    T.setMesh(aBasicMesher.mesh());
+    T.setDiscretMethod(DM_FEM);
+    T.setDiscretOrder(DO_LINEAR);
+    T.setDiscretLocation(DL_NODE);
+    T.setSimulationType(ST_GENERIC);
+    T.setNbDofs(1);
+
+    ENigMA::analytical::CAnaFunction<decimal> aFunction("2*x+1");
+
+    T.setValues(aFunction);
+
+    EXPECT_EQ(T.mesh().nbNodes(), T.u.size());
+
+    for (Integer i = 0; i < T.mesh().nbNodes(); ++i)
+        EXPECT_NEAR(2 * T.mesh().node(T.mesh().nodeId(i)).x() + 1, T.u(i), 1E-12);
+
+    T.setDiscretLocation(DL_ELEMENT_CENTER);
+
+    T.setValues(aFunction);
+
+    EXPECT_EQ(ne, T.u.size());
+    EXPECT_NEAR(2 * 0.125 + 1, T.u(0), 1E-12);
+
+}
@@ -0,0 +1,358 @@
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#include "gtest/gtest.h"
+
+#include "TypeDef.hpp"
+
+#include "SleSystem.hpp"
+#include "SleAlgebraicMultigrid.hpp"
+
+using namespace ENigMA::sle;
+
+class CTestSleSolver : public ::testing::Test {
+protected:
+
+    virtual void SetUp() {
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    void laplacian(CSleSystem<decimal>& aSystem, const Integer n, const decimal aShift)
+    {
+
+        aSystem.matrixA.resize(n, n);
+        aSystem.matrixA.reserve(3 * n);
+
+        for (Integer i = 0; i < n; ++i)
+        {
+
+            aSystem.matrixA.coeffRef(i, i) = 2.0 + aShift;
+
+            if (i > 0)
+                aSystem.matrixA.coeffRef(i, i - 1) = -1.0;
+
+            if (i < n - 1)
+                aSystem.matrixA.coeffRef(i, i + 1) = -1.0;
+
+        }
+
+        aSystem.vectorB.resize(n);
+        aSystem.vectorB.setOnes();
+
+    }
+
+    void laplacian2D(CSleSystem<decimal>& aSystem, const Integer n)
+    {
+
+        std::vector<Eigen::Triplet<decimal> > sTriplets;
+
+        for (Integer j = 0; j < n; ++j)
+        {
+            for (Integer i = 0; i < n; ++i)
+            {
+
+                Integer k = j * n + i;
+
+                sTriplets.push_back(Eigen::Triplet<decimal>(k, k, 4.0));
+
+                if (i > 0)
+                    sTriplets.push_back(Eigen::Triplet<decimal>(k, k - 1, -1.0));
+
+                if (i < n - 1)
+                    sTriplets.push_back(Eigen::Triplet<decimal>(k, k + 1, -1.0));
+
+                if (j > 0)
+                    sTriplets.push_back(Eigen::Triplet<decimal>(k, k - n, -1.0));
+
+                if (j < n - 1)
+                    sTriplets.push_back(Eigen::Triplet<decimal>(k, k + n, -1.0));
+
+            }
+        }
+
+        aSystem.matrixA.resize(n * n, n * n);
+        aSystem.matrixA.setFromTriplets(sTriplets.begin(), sTriplets.end());
+
+        aSystem.vectorB.resize(n * n);
+        aSystem.vectorB.setOnes();
+
+    }
+
+};
+
+TEST_F(CTestSleSolver, preconditioners)
+{
+
+    const Integer n = 50;
+
+    CSleSystem<decimal> aReference;
+
+    aReference.matrixType = MT_DENSE;
+    laplacian(aReference, n, 0.0);
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, 1> x0 = aReference.solve();
+
+    EPreconditionerType sTypes[] = { PT_JACOBI, PT_INCOMPLETE_CHOLESKY, PT_INCOMPLETE_LUT };
+
+    for (Integer i = 0; i < 3; ++i)
+    {
+
+        CSleSolver<decimal> aSolver;
+
+        aSolver.setPreconditioner(sTypes[i]);
+        aSolver.setTolerance(1E-12);
+        aSolver.setMaxIterations(1000);
+
+        CSleSystem<decimal> aSymmetricSystem;
+
+        aSymmetricSystem.matrixType = MT_SPARSE_SYMMETRIC;
+        laplacian(aSymmetricSystem, n, 0.0);
+        aSymmetricSystem.setSolver(aSolver);
+
+        Eigen::Matrix<decimal, Eigen::Dynamic, 1> x1 = aSymmetricSystem.solve();
+
+        EXPECT_NEAR(0.0, (x1 - x0).norm(), 1E-6);
+
+        CSleSystem<decimal> aSystem;
+
+        aSystem.matrixType = MT_SPARSE;
+        laplacian(aSystem, n, 0.0);
+        aSystem.setSolver(aSolver);
+
+        Eigen::Matrix<decimal, Eigen::Dynamic, 1> x2 = aSystem.solve();
+
+        EXPECT_NEAR(0.0, (x2 - x0).norm(), 1E-6);
+
+    }
+
+}
+
+TEST_F(CTestSleSolver, reuse)
+{
+
+    const Integer n = 50;
+
+    CSleSolver<decimal> aSolver;
+
+    aSolver.setPreconditioner(PT_INCOMPLETE_CHOLESKY);
+
+    for (Integer step = 0; step < 5; ++step)
+    {
+
+        // Same pattern and values on every step
+        CSleSystem<decimal> aSystem;
+
+        aSystem.matrixType = MT_SPARSE_SYMMETRIC;
+        laplacian(aSystem, n, 0.1);
+        aSystem.setSolver(aSolver);
+
+        aSystem.solve();
+
+    }
+
+    EXPECT_EQ(1, aSolver.nbAnalyses());
+    EXPECT_EQ(1, aSolver.nbFactorizations());
+
+    // Same pattern with new values only refactorizes
+    CSleSystem<decimal> aSystem;
+
+    aSystem.matrixType = MT_SPARSE_SYMMETRIC;
+    laplacian(aSystem, n, 0.2);
+
+    CSleSystem<decimal> aScaledSystem = 2.0 * aSystem;
+
+    aScaledSystem.setSolver(aSolver);
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, 1> x = aScaledSystem.solve();
+
+    EXPECT_EQ(1, aSolver.nbAnalyses());
+    EXPECT_EQ(2, aSolver.nbFactorizations());
+
+    EXPECT_NEAR(0.0, (aScaledSystem.matrixA * x - aScaledSystem.vectorB).norm(), 1E-6);
+
+    // New size triggers a new analysis
+    laplacian(aSystem, n + 1, 0.2);
+    aSystem.setSolver(aSolver);
+    aSystem.solve();
+
+    EXPECT_EQ(2, aSolver.nbAnalyses());
+
+}
+
+TEST_F(CTestSleSolver, algebraicMultigrid)
+{
+
+    const Integer n = 60;
+
+    CSleSystem<decimal> aSystem;
+
+    aSystem.matrixType = MT_SPARSE_SYMMETRIC;
+    laplacian2D(aSystem, n);
+
+    CSleAlgebraicMultigrid<decimal> aMultigrid;
+
+    aMultigrid.compute(aSystem.matrixA);
+
+    EXPECT_GT(aMultigrid.nbLevels(), 1);
+    EXPECT_LT(aMultigrid.levelSize(1), n * n / 3);
+
+    CSleSolver<decimal> aJacobiSolver;
+
+    aJacobiSolver.setTolerance(1E-10);
+
+    aSystem.setSolver(aJacobiSolver);
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, 1> x0 = aSystem.solve();
+
+    CSleSolver<decimal> aMultigridSolver;
+
+    aMultigridSolver.setPreconditioner(PT_ALGEBRAIC_MULTIGRID);
+    aMultigridSolver.setTolerance(1E-10);
+
+    aSystem.setSolver(aMultigridSolver);
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, 1> x1 = aSystem.solve();
+
+    EXPECT_NEAR(0.0, (aSystem.matrixA * x1 - aSystem.vectorB).norm() / aSystem.vectorB.norm(), 1E-8);
+    EXPECT_NEAR(0.0, (x1 - x0).norm() / x0.norm(), 1E-6);
+
+    EXPECT_LT(aMultigridSolver.iterations(), aJacobiSolver.iterations() / 4);
+
+    // New values with the same pattern keep the aggregates
+    CSleSystem<decimal> aScaledSystem = 2.0 * aSystem;
+
+    aScaledSystem.setSolver(aMultigridSolver);
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, 1> x2 = aScaledSystem.solve();
+
+    EXPECT_EQ(1, aMultigridSolver.nbAnalyses());
+    EXPECT_NEAR(0.0, (x2 - x0).norm() / x0.norm(), 1E-6);
+
+    // Non-symmetric path
+    aSystem.matrixType = MT_SPARSE;
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, 1> x3 = aSystem.solve();
+
+    EXPECT_NEAR(0.0, (x3 - x0).norm() / x0.norm(), 1E-6);
+
+}
+
+TEST_F(CTestSleSolver, multipleRightHandSides)
+{
+
+    const Integer n = 400;
+
+    CSleSystem<decimal> aSystem;
+
+    laplacian2D(aSystem, 20);
+
+    // Upwind convection makes the matrix non-symmetric
+    for (Integer k = 1; k < n; ++k)
+    {
+        aSystem.matrixA.coeffRef(k, k) += 0.5;
+        aSystem.matrixA.coeffRef(k, k - 1) += -0.5;
+    }
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, Eigen::Dynamic> b(n, 3);
+
+    b.col(0).setOnes();
+    b.col(1) = Eigen::Matrix<decimal, Eigen::Dynamic, 1>::LinSpaced(n, -1.0, 1.0);
+    b.col(2).setZero();
+
+    EPreconditionerType sTypes[] = { PT_JACOBI, PT_INCOMPLETE_LUT, PT_ALGEBRAIC_MULTIGRID };
+
+    for (Integer i = 0; i < 3; ++i)
+    {
+
+        CSleSolver<decimal> aSolver;
+
+        aSolver.setPreconditioner(sTypes[i]);
+        aSolver.setTolerance(1E-12);
+
+        Eigen::Matrix<decimal, Eigen::Dynamic, Eigen::Dynamic> x = aSolver.solve(MT_SPARSE, aSystem.matrixA, b);
+
+        EXPECT_EQ(n, x.rows());
+        EXPECT_EQ(3, x.cols());
+
+        EXPECT_NEAR(0.0, (aSystem.matrixA * x.col(0) - b.col(0)).norm(), 1E-8);
+        EXPECT_NEAR(0.0, (aSystem.matrixA * x.col(1) - b.col(1)).norm(), 1E-8);
+        EXPECT_NEAR(0.0, x.col(2).norm(), 1E-12);
+
+        EXPECT_LT(aSolver.error(), 1E-10);
+
+        // Same result as solving the columns one at a time
+        Eigen::Matrix<decimal, Eigen::Dynamic, 1> x1 = aSolver.solve(MT_SPARSE, aSystem.matrixA, Eigen::Matrix<decimal, Eigen::Dynamic, 1>(b.col(1)));
+
+        EXPECT_NEAR(0.0, (x1 - x.col(1)).norm(), 1E-8);
+
+        EXPECT_EQ(1, aSolver.nbAnalyses());
+
+    }
+
+    CSleSolver<decimal> aDenseSolver;
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, Eigen::Dynamic> x = aDenseSolver.solve(MT_DENSE, aSystem.matrixA, b);
+
+    EXPECT_NEAR(0.0, (aSystem.matrixA * x - b).norm(), 1E-8);
+
+}
+TEST_F(CTestSleSolver, expressionTemplates)
+{
+
+    const Integer n = 50;
+
+    CSleSystem<decimal> aMass;
+    CSleSystem<decimal> aStiffness;
+
+    laplacian(aMass, n, 4.0);
+    laplacian(aStiffness, n, 0.0);
+
+    aMass.matrixA.makeCompressed();
+    aStiffness.matrixA.makeCompressed();
+
+    aMass.matrixType = MT_SPARSE_SYMMETRIC;
+    aStiffness.matrixType = MT_SPARSE;
+
+    Eigen::Matrix<decimal, Eigen::Dynamic, 1> aScale = Eigen::Matrix<decimal, Eigen::Dynamic, 1>::LinSpaced(n, 1.0, 2.0);
+
+    CSleSystem<decimal> aSystem = aScale * (static_cast<decimal>(0.1) * aMass - aStiffness + static_cast<decimal>(2.0)) = 3.0;
+
+    Eigen::SparseMatrix<decimal> anIdentity(n, n);
+    anIdentity.setIdentity();
+
+    Eigen::SparseMatrix<decimal> anExpected = aScale.asDiagonal() * (0.1 * aMass.matrixA - aStiffness.matrixA + 2.0 * anIdentity);
+
+    EXPECT_EQ(MT_SPARSE, aSystem.matrixType);
+    EXPECT_EQ(aMass.matrixA.nonZeros(), aSystem.matrixA.nonZeros());
+    EXPECT_NEAR(0.0, (Eigen::MatrixXd(aSystem.matrixA) - Eigen::MatrixXd(anExpected)).norm(), 1E-12);
+
+    for (Integer i = 0; i < n; ++i)
+        EXPECT_NEAR(aScale[i] * (0.1 - 1.0 + 2.0) + 3.0, aSystem.vectorB[i], 1E-12);
+
+    // Different patterns fall back to the sparse matrix sum
+    CSleSystem<decimal> aDiagonal;
+
+    aDiagonal.matrixA = anIdentity;
+    aDiagonal.vectorB.setZero(n);
+
+    aSystem = aStiffness - aDiagonal;
+
+    EXPECT_NEAR(0.0, (Eigen::MatrixXd(aSystem.matrixA) - Eigen::MatrixXd(aStiffness.matrixA - anIdentity)).norm(), 1E-12);
+
+    // The assigned expression may reference the system itself
+    aSystem = aSystem + aSystem;
+
+    EXPECT_NEAR(0.0, (Eigen::MatrixXd(aSystem.matrixA) - 2.0 * Eigen::MatrixXd(aStiffness.matrixA - anIdentity)).norm(), 1E-12);
+
+}
+
@@ -0,0 +1,196 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#include <ctime>
+#include <iostream>
+
+#include "gtest/gtest.h"
+
+#include "TypeDef.hpp"
+
+#include "SphConvex.hpp"
+#include "SphCubicSpline.hpp"
+#include "SphGaussian.hpp"
+#include "SphKernelTable.hpp"
+#include "SphQuintic.hpp"
+#include "SphSpiky.hpp"
+
+using namespace ENigMA::geometry;
+using namespace ENigMA::sph;
+
+class CTestSphKernelTable : public ::testing::Test {
+protected:
+
+    std::vector<CSphKernel<decimal>*> m_kernels;
+    std::vector<std::string> m_names;
+
+    CSphCubicSpline<decimal> m_cubicSpline;
+    CSphQuintic<decimal> m_quintic;
+    CSphSpiky<decimal> m_spiky;
+    CSphGaussian<decimal> m_gaussian;
+    CSphConvex<decimal> m_convex;
+
+    virtual void SetUp() {
+
+        m_cubicSpline.setDimension(3);
+        m_quintic.setDimension(3);
+        m_spiky.setDimension(3);
+        m_gaussian.setDimension(3);
+        m_convex.setDimension(3);
+
+        m_kernels.push_back(&m_cubicSpline);
+        m_kernels.push_back(&m_quintic);
+        m_kernels.push_back(&m_spiky);
+        m_kernels.push_back(&m_gaussian);
+        m_kernels.push_back(&m_convex);
+
+        m_names.push_back("cubic spline");
+        m_names.push_back("quintic");
+        m_names.push_back("spiky");
+        m_names.push_back("gaussian");
+        m_names.push_back("convex");
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    // Kernel and gradient summed over pairs spread across the support, as a pair loop would
+    template <typename TKernel>
+    decimal sumPairs(TKernel& aKernel, const decimal aSupport, const Integer nbPairs) {
+
+        decimal sum = 0.0;
+
+        for (Integer i = 0; i < nbPairs; ++i)
+        {
+            decimal q = aSupport * (i % 1000 + 0.5) * 1E-3;
+            sum += aKernel.radialW(q) + aKernel.radialGradientW(q);
+        }
+
+        return sum;
+
+    }
+
+    decimal sumPairsVirtual(CSphKernel<decimal>& aKernel, const decimal aSupport, const Integer nbPairs) {
+
+        decimal sum = 0.0;
+
+        for (Integer i = 0; i < nbPairs; ++i)
+        {
+            CGeoVector<decimal> r(aSupport * (i % 1000 + 0.5) * 1E-3, 0, 0);
+            sum += aKernel.W(r, 1.0) + aKernel.gradientW(r, 1.0).x();
+        }
+
+        return sum;
+
+    }
+
+};
+
+TEST_F(CTestSphKernelTable, radial) {
+
+    for (Integer k = 0; k < static_cast<Integer>(m_kernels.size()); ++k)
+    {
+
+        CSphKernel<decimal>& aKernel = *m_kernels[k];
+
+        CSphKernelTable<decimal> aTable(aKernel);
+
+        decimal h = 0.7;
+
+        for (Integer i = 1; i <= 120; ++i)
+        {
+
+            decimal q = aKernel.support() * (i - 0.5) / 100.0;
+
+            CGeoVector<decimal> r(0.6 * q * h, 0.0, 0.8 * q * h);
+
+            // The virtual interface scales the radial profile with h
+            decimal W = aKernel.W(r, h);
+            decimal gradW = aKernel.gradientW(r, h).dot(r) / r.norm();
+            decimal lapW = aKernel.laplacianW(r, h);
+
+            decimal h3 = h * h * h;
+
+            if (k == 0)
+            {
+                EXPECT_NEAR(W, m_cubicSpline.radialW(q) / h3, 1E-12);
+                EXPECT_NEAR(gradW, m_cubicSpline.radialGradientW(q) / (h * h), 1E-12);
+                EXPECT_NEAR(lapW, m_cubicSpline.radialLaplacianW(q) / (h * h), 1E-12);
+            }
+
+            // The table follows the profile closely
+            decimal scale = aKernel.W(CGeoVector<decimal>(0.0, 0.0, 0.0), 1.0);
+
+            EXPECT_NEAR(W * h3, aTable.radialW(q), 1E-5 * scale);
+            EXPECT_NEAR(gradW * h * h, aTable.radialGradientW(q), 1E-4 * scale);
+            EXPECT_NEAR(lapW * h * h, aTable.radialLaplacianW(q), 1E-4 * scale);
+
+        }
+
+    }
+
+}
+
+TEST_F(CTestSphKernelTable, pairsPerSecond) {
+
+    const Integer nbPairs = 2000000;
+
+    for (Integer k = 0; k < static_cast<Integer>(m_kernels.size()); ++k)
+    {
+
+        CSphKernel<decimal>& aKernel = *m_kernels[k];
+
+        CSphKernelTable<decimal> aTable(aKernel);
+
+        decimal aSupport = aKernel.support();
+
+        decimal sumVirtual, sumInline, sumTable;
+
+        clock_t begin = clock();
+
+        sumVirtual = this->sumPairsVirtual(aKernel, aSupport, nbPairs);
+
+        double timeVirtual = static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+        begin = clock();
+
+        if (k == 0)
+            sumInline = this->sumPairs(m_cubicSpline, aSupport, nbPairs);
+        else if (k == 1)
+            sumInline = this->sumPairs(m_quintic, aSupport, nbPairs);
+        else if (k == 2)
+            sumInline = this->sumPairs(m_spiky, aSupport, nbPairs);
+        else if (k == 3)
+            sumInline = this->sumPairs(m_gaussian, aSupport, nbPairs);
+        else
+            sumInline = this->sumPairs(m_convex, aSupport, nbPairs);
+
+        double timeInline = static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+        begin = clock();
+
+        sumTable = this->sumPairs(aTable, aSupport, nbPairs);
+
+        double timeTable = static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+        std::cout << "Pairs per second (" << m_names[k] << ") : virtual " << nbPairs / std::max(timeVirtual, 1E-6)
+                  << ", inline " << nbPairs / std::max(timeInline, 1E-6)
+                  << ", table " << nbPairs / std::max(timeTable, 1E-6) << std::endl;
+
+        EXPECT_NEAR(1.0, sumInline / sumVirtual, 1E-9);
+        EXPECT_NEAR(1.0, sumTable / sumVirtual, 1E-4);
+
+    }
+
+}
@@ -0,0 +1,210 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+
+#include "TypeDef.hpp"
+
+#include "SphParticleArrays.hpp"
+
+using namespace ENigMA::sph;
+
+class CTestSphParticleArrays : public ::testing::Test {
+protected:
+
+    CSphParticleArrays<decimal> m_particles;
+
+    virtual void SetUp() {
+
+        // Random cloud in the unit cube, the position is also stored as temperature to follow the reorder
+        srand(1234);
+
+        for (Integer i = 0; i < 2000; ++i)
+        {
+
+            decimal x = static_cast<decimal>(rand()) / RAND_MAX;
+            decimal y = static_cast<decimal>(rand()) / RAND_MAX;
+            decimal z = static_cast<decimal>(rand()) / RAND_MAX;
+
+            m_particles.addParticle(x, y, z, 1.0, 1000.0);
+            m_particles.temperature()[i] = x + 2.0 * y + 3.0 * z;
+
+        }
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    // Sum of the slot distances between each particle and its neighbours
+    decimal slotDistance(const decimal aRadius) {
+
+        std::vector<Integer> sNeighbors;
+
+        decimal sum = 0.0;
+
+        m_particles.buildCells(aRadius);
+
+        for (Integer i = 0; i < m_particles.size(); ++i)
+        {
+
+            m_particles.neighbors(i, aRadius, sNeighbors);
+
+            for (Integer n = 0; n < static_cast<Integer>(sNeighbors.size()); ++n)
+                sum += std::abs(sNeighbors[n] - i);
+
+        }
+
+        return sum;
+
+    }
+
+};
+
+TEST_F(CTestSphParticleArrays, neighbors) {
+
+    decimal radius = 0.08;
+
+    m_particles.buildCells(radius);
+
+    std::vector<Integer> sNeighbors;
+
+    for (Integer i = 0; i < m_particles.size(); i += 37)
+    {
+
+        m_particles.neighbors(i, radius, sNeighbors);
+
+        std::vector<Integer> sBruteForce;
+
+        for (Integer j = 0; j < m_particles.size(); ++j)
+        {
+
+            decimal dx = m_particles.x()[j] - m_particles.x()[i];
+            decimal dy = m_particles.y()[j] - m_particles.y()[i];
+            decimal dz = m_particles.z()[j] - m_particles.z()[i];
+
+            if (dx * dx + dy * dy + dz * dz < radius * radius)
+                sBruteForce.push_back(j);
+
+        }
+
+        std::sort(sNeighbors.begin(), sNeighbors.end());
+
+        EXPECT_EQ(sBruteForce, sNeighbors);
+
+    }
+
+}
+
+TEST_F(CTestSphParticleArrays, sortMorton) {
+
+    decimal radius = 0.08;
+
+    decimal before = this->slotDistance(radius);
+
+    std::vector<Integer> sIndex(m_particles.size());
+
+    for (Integer k = 0; k < m_particles.size(); ++k)
+        sIndex[k] = m_particles.index(k);
+
+    m_particles.sortMorton(radius);
+    m_particles.permute(sIndex);
+
+    decimal after = this->slotDistance(radius);
+
+    // Neighbours sit much closer in memory along the Morton curve
+    EXPECT_LT(after, 0.25 * before);
+
+    // Every quantity followed its particle
+    for (Integer k = 0; k < m_particles.size(); ++k)
+    {
+
+        EXPECT_EQ(k, m_particles.slot(m_particles.index(k)));
+
+        // External fields follow the same reorder
+        EXPECT_EQ(m_particles.index(k), sIndex[k]);
+
+        EXPECT_NEAR(m_particles.x()[k] + 2.0 * m_particles.y()[k] + 3.0 * m_particles.z()[k], m_particles.temperature()[k], 1E-12);
+
+    }
+
+}
+
+TEST_F(CTestSphParticleArrays, neighborList) {
+
+    decimal radius = 0.08;
+    decimal skin = 0.01;
+
+    EXPECT_FALSE(m_particles.isNeighborListValid(radius, skin));
+
+    m_particles.buildNeighborList(radius, skin);
+
+    EXPECT_TRUE(m_particles.isNeighborListValid(radius, skin));
+
+    std::vector<Integer>& sOffsets = m_particles.neighborOffsets();
+    std::vector<Integer>& sList = m_particles.neighborList();
+
+    // Every pair within radius plus skin appears once, under its first particle
+    Integer nbPairs = 0;
+
+    for (Integer i = 0; i < m_particles.size(); ++i)
+    {
+
+        std::vector<Integer> sBruteForce;
+
+        for (Integer j = i + 1; j < m_particles.size(); ++j)
+        {
+
+            decimal dx = m_particles.x()[j] - m_particles.x()[i];
+            decimal dy = m_particles.y()[j] - m_particles.y()[i];
+            decimal dz = m_particles.z()[j] - m_particles.z()[i];
+
+            if (dx * dx + dy * dy + dz * dz < (radius + skin) * (radius + skin))
+                sBruteForce.push_back(j);
+
+        }
+
+        std::vector<Integer> sPairs(sList.begin() + sOffsets[i], sList.begin() + sOffsets[i + 1]);
+
+        std::sort(sPairs.begin(), sPairs.end());
+
+        EXPECT_EQ(sBruteForce, sPairs);
+
+        nbPairs += static_cast<Integer>(sBruteForce.size());
+
+    }
+
+    EXPECT_EQ(nbPairs, sOffsets.back());
+
+    // Small moves keep the list, half the skin invalidates it
+    m_particles.x()[100] += 0.4 * skin;
+
+    EXPECT_TRUE(m_particles.isNeighborListValid(radius, skin));
+
+    m_particles.x()[100] += 0.2 * skin;
+
+    EXPECT_FALSE(m_particles.isNeighborListValid(radius, skin));
+
+    m_particles.buildNeighborList(radius, skin);
+
+    EXPECT_TRUE(m_particles.isNeighborListValid(radius, skin));
+
+    // Reordering invalidates the list
+    m_particles.sortMorton(radius);
+
+    EXPECT_FALSE(m_particles.isNeighborListValid(radius, skin));
+
+}
@@ -0,0 +1,251 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+// *****************************************************************************
+// <ProjectName> ENigMA </ProjectName>
+// <Description> Extended Numerical Multiphysics Analysis </Description>
+// <HeadURL> $HeadURL$ </HeadURL>
+// <LastChangedDate> $LastChangedDate$ </LastChangedDate>
+// <LastChangedRevision> $LastChangedRevision$ </LastChangedRevision>
+// <Author> Billy Araujo </Author>
+// *****************************************************************************
+
+#include "gtest/gtest.h"
+
+#include "TypeDef.hpp"
+
+#include "SphCubicSpline.hpp"
+#include "SphGaussian.hpp"
+#include "SphQuintic.hpp"
+#include "SphWcsphSolver.hpp"
+
+using namespace ENigMA::geometry;
+using namespace ENigMA::sph;
+
+class CTestSphWcsph : public ::testing::Test {
+protected:
+
+    virtual void SetUp() {
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    // Fluid block of nx by ny particles in a tank of the given width with three layers of wall particles
+    void addTank(CSphWcsphSolver<decimal>& aSolver, const decimal dx, const Integer nx, const Integer ny, const Integer nw) {
+
+        for (Integer i = 0; i < nx; ++i)
+        {
+            for (Integer j = 0; j < ny; ++j)
+            {
+                CGeoCoordinate<decimal> aPosition((i + 0.5) * dx, (j + 0.5) * dx, 0.0);
+                aSolver.addParticle(aPosition);
+            }
+        }
+
+        for (Integer k = 0; k < 3; ++k)
+        {
+
+            for (Integer i = -3; i < nw + 3; ++i)
+            {
+                CGeoCoordinate<decimal> aPosition((i + 0.5) * dx, -(k + 0.5) * dx, 0.0);
+                aSolver.addParticle(aPosition, true);
+            }
+
+            for (Integer j = 0; j < 2 * ny; ++j)
+            {
+                CGeoCoordinate<decimal> aLeft(-(k + 0.5) * dx, (j + 0.5) * dx, 0.0);
+                CGeoCoordinate<decimal> aRight((nw + k + 0.5) * dx, (j + 0.5) * dx, 0.0);
+
+                aSolver.addParticle(aLeft, true);
+                aSolver.addParticle(aRight, true);
+            }
+
+        }
+
+    }
+
+};
+
+TEST_F(CTestSphWcsph, restDensity) {
+
+    CSphCubicSpline<decimal> aCubicSpline(2);
+    CSphQuintic<decimal> aQuintic(2);
+    CSphGaussian<decimal> aGaussian(2);
+
+    std::vector<CSphKernel<decimal>*> sKernels;
+
+    sKernels.push_back(&aCubicSpline);
+    sKernels.push_back(&aQuintic);
+    sKernels.push_back(&aGaussian);
+
+    decimal dx = 0.01;
+
+    for (Integer k = 0; k < 2 * static_cast<Integer>(sKernels.size()); ++k)
+    {
+
+        CSphWcsphSolver<decimal> aSolver(*sKernels[k / 2]);
+
+        // Inline and tabulated kernels
+        aSolver.setTabulatedKernel(k % 2 == 1);
+        aSolver.setMaterialProperties(1000.0, 0.0);
+        aSolver.setSmoothingLength(2.6 * dx / aSolver.support());
+        aSolver.setParticleSpacing(dx);
+
+        for (Integer i = 0; i < 21; ++i)
+        {
+            for (Integer j = 0; j < 21; ++j)
+            {
+                CGeoCoordinate<decimal> aPosition(i * dx, j * dx, 0.0);
+                aSolver.addParticle(aPosition);
+            }
+        }
+
+        aSolver.calculateTimeStep();
+
+        // Normalized smoothing kernels recover the reference density inside a uniform lattice
+        EXPECT_NEAR(1000.0, aSolver.density(10 * 21 + 10), 15.0);
+
+        // A particle on the edge only sees part of its support
+        EXPECT_LT(aSolver.density(10), 900.0);
+
+    }
+
+}
+
+TEST_F(CTestSphWcsph, momentum) {
+
+    CSphCubicSpline<decimal> aKernel(2);
+
+    CSphWcsphSolver<decimal> aSolver(aKernel);
+
+    decimal dx = 0.02;
+
+    aSolver.setMaterialProperties(1000.0, 1E-3);
+    aSolver.setSoundSpeed(20.0);
+    aSolver.setArtificialViscosity(0.1);
+    aSolver.setSmoothingLength(1.3 * dx);
+    aSolver.setParticleSpacing(dx);
+    aSolver.setSortInterval(5);
+
+    // Compressed block with a shear flow, free of walls and gravity
+    for (Integer i = 0; i < 20; ++i)
+    {
+        for (Integer j = 0; j < 20; ++j)
+        {
+            CGeoCoordinate<decimal> aPosition(i * 0.9 * dx, j * 0.9 * dx, 0.0);
+            Integer aParticleIndex = aSolver.addParticle(aPosition);
+
+            aSolver.setVelocity(aParticleIndex, CGeoVector<decimal>(std::sin(0.3 * j), 0.0, 0.0));
+        }
+    }
+
+    CGeoVector<decimal> aMomentum0(0.0, 0.0, 0.0);
+
+    for (Integer i = 0; i < aSolver.nbParticles(); ++i)
+        aMomentum0 += aSolver.velocity(i);
+
+    for (Integer n = 0; n < 100; ++n)
+        aSolver.iterate(aSolver.calculateTimeStep());
+
+    CGeoVector<decimal> aMomentum(0.0, 0.0, 0.0);
+
+    for (Integer i = 0; i < aSolver.nbParticles(); ++i)
+        aMomentum += aSolver.velocity(i);
+
+    // Pair forces are equal and opposite
+    EXPECT_NEAR(aMomentum0.x(), aMomentum.x(), 1E-8);
+    EXPECT_NEAR(aMomentum0.y(), aMomentum.y(), 1E-8);
+
+}
+
+TEST_F(CTestSphWcsph, hydrostatic) {
+
+    CSphCubicSpline<decimal> aKernel(2);
+
+    CSphWcsphSolver<decimal> aSolver(aKernel);
+
+    decimal dx = 0.02;
+    decimal rho = 1000.0;
+    decimal g = -9.81;
+    decimal H = 0.4;
+
+    aSolver.setMaterialProperties(rho, 1E-3);
+    aSolver.setSoundSpeed(10.0 * std::sqrt(2.0 * fabs(g) * H));
+    aSolver.setArtificialViscosity(0.1);
+    aSolver.setGravity(0.0, g, 0.0);
+    aSolver.setSmoothingLength(1.3 * dx);
+    aSolver.setParticleSpacing(dx);
+
+    this->addTank(aSolver, dx, 20, 20, 20);
+
+    while (aSolver.time() < 1.0)
+        aSolver.iterate(aSolver.calculateTimeStep());
+
+    decimal pmax = 0.0;
+    decimal vmax = 0.0;
+
+    for (Integer i = 0; i < aSolver.nbParticles(); ++i)
+    {
+
+        if (aSolver.isBoundary(i))
+            continue;
+
+        EXPECT_GT(aSolver.position(i).y(), 0.0);
+        EXPECT_GT(aSolver.position(i).x(), 0.0);
+        EXPECT_LT(aSolver.position(i).x(), H);
+
+        pmax = std::max(pmax, aSolver.pressure(i));
+        vmax = std::max(vmax, aSolver.velocity(i).norm());
+
+    }
+
+    EXPECT_NEAR(rho * fabs(g) * H, pmax, 0.25 * rho * fabs(g) * H);
+    EXPECT_LT(vmax, 0.1 * std::sqrt(2.0 * fabs(g) * H));
+
+}
+
+TEST_F(CTestSphWcsph, damBreak) {
+
+    CSphCubicSpline<decimal> aKernel(2);
+
+    CSphWcsphSolver<decimal> aSolver(aKernel);
+
+    decimal dx = 0.02;
+    decimal g = -9.81;
+    decimal H = 0.4;
+
+    aSolver.setMaterialProperties(1000.0, 1E-3);
+    aSolver.setSoundSpeed(10.0 * std::sqrt(2.0 * fabs(g) * H));
+    aSolver.setArtificialViscosity(0.1);
+    aSolver.setGravity(0.0, g, 0.0);
+    aSolver.setSmoothingLength(1.3 * dx);
+    aSolver.setParticleSpacing(dx);
+
+    this->addTank(aSolver, dx, 10, 20, 60);
+
+    while (aSolver.time() < 0.3)
+        aSolver.iterate(aSolver.calculateTimeStep());
+
+    decimal front = 0.0;
+
+    for (Integer i = 0; i < aSolver.nbParticles(); ++i)
+    {
+
+        if (aSolver.isBoundary(i))
+            continue;
+
+        EXPECT_GT(aSolver.position(i).y(), 0.0);
+        EXPECT_GT(aSolver.position(i).x(), 0.0);
+
+        front = std::max(front, aSolver.position(i).x());
+
+    }
+
+    // The surge front runs at about 2 sqrt(g H) once the column has collapsed
+    EXPECT_GT(front, 0.5);
+    EXPECT_LT(front, 0.2 + 0.3 * 2.0 * std::sqrt(fabs(g) * H));
+
+}
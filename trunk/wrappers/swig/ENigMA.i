@@ -138,6 +138,7 @@ namespace std
 #include "MshTriangleMesher.hpp"
 #include "MshQuadrilateralMesher.hpp"
 #include "SleSystem.hpp"
+#include "SleSolver.hpp"
 #include "MatMaterial.hpp"
 #include "PdeField.hpp"
 #include "PdeEquation.hpp"
@@ -152,17 +153,24 @@ namespace std
 #include "FvmFace.hpp"
 #include "FvmCell.hpp"
 #include "FvmControlVolume.hpp"
+#include "FvmCheckpoint.hpp"
 #include "FvmMesh.hpp"
+#include "FvmAgglomeration.hpp"
 #include "FvmPisoSolver.hpp"
+#include "FvmSimpleSolver.hpp"
 #include "FvmTemperatureSolver.hpp"
 #include "FvmVofSolver.hpp"
+#include "FvmParticleTracker.hpp"
 #include "SphKernel.hpp"
 #include "SphConvex.hpp"
 #include "SphCubicSpline.hpp"
 #include "SphGaussian.hpp"
 #include "SphQuintic.hpp"
 #include "SphSpiky.hpp"
+#include "SphKernelTable.hpp"
+#include "SphParticleArrays.hpp"
 #include "SphParticles.hpp"
+#include "SphWcsphSolver.hpp"
 #include "PosGmsh.hpp"
 #include "PosVtk.hpp"
 %}
@@ -628,6 +636,11 @@ namespace std
 
 }
 
+// Linear solver
+%include "SleSolver.hpp"
+
+%template(CSleSolverDouble) ENigMA::sle::CSleSolver<double>;
+
 // Analytical function
 %include "AnaFunction.hpp"
 
@@ -730,16 +743,31 @@ namespace std
 
 %template(CFvmControlVolumDouble) ENigMA::fvm::CFvmControlVolume<double>;
 
+// FVM Checkpoint
+%include "FvmCheckpoint.hpp"
+
+%template(CFvmCheckpointDouble) ENigMA::fvm::CFvmCheckpoint<double>;
+
 // FVM Mesh
 %include "FvmMesh.hpp"
 
 %template(CFvmMeshDouble) ENigMA::fvm::CFvmMesh<double>;
 
+// FVM Agglomeration
+%include "FvmAgglomeration.hpp"
+
+%template(CFvmAgglomerationDouble) ENigMA::fvm::CFvmAgglomeration<double>;
+
 // FVM Piso Solver
 %include "FvmPisoSolver.hpp"
 
 %template(CFvmPisoSolverDouble) ENigMA::fvm::CFvmPisoSolver<double>;
 
+// FVM Simple Solver
+%include "FvmSimpleSolver.hpp"
+
+%template(CFvmSimpleSolverDouble) ENigMA::fvm::CFvmSimpleSolver<double>;
+
 // FVM Temperature Solver
 %include "FvmTemperatureSolver.hpp"
 
@@ -750,6 +778,11 @@ namespace std
 
 %template(CFvmVofSolverDouble) ENigMA::fvm::CFvmVofSolver<double>;
 
+// FVM Particle Tracker
+%include "FvmParticleTracker.hpp"
+
+%template(CFvmParticleTrackerDouble) ENigMA::fvm::CFvmParticleTracker<double>;
+
 // SPH Kernel
 %include "SphKernel.hpp"
 
@@ -780,12 +813,27 @@ namespace std
 
 %template(CSphSpikyDouble) ENigMA::sph::CSphSpiky<double>;
 
+// SPH Kernel Table
+%include "SphKernelTable.hpp"
+
+%template(CSphKernelTableDouble) ENigMA::sph::CSphKernelTable<double>;
+
+// SPH Particle Arrays
+%include "SphParticleArrays.hpp"
+
+%template(CSphParticleArraysDouble) ENigMA::sph::CSphParticleArrays<double>;
+
 // SPH 
 
 %include "SphParticles.hpp"
 
 %template(CSphParticlesDouble) ENigMA::sph::CSphParticles<double>;
 
+// SPH Wcsph Solver
+%include "SphWcsphSolver.hpp"
+
+%template(CSphWcsphSolverDouble) ENigMA::sph::CSphWcsphSolver<double>;
+
 // Gmsh
 %include "PosGmsh.hpp"
 